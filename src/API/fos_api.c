@@ -85,6 +85,72 @@ fos_ret_t API_FOS_Sleep(uint32_t time)
 }
 
 
+/*
+ * Send current process to sleep until the next release of a periodic loop
+ * Thread-safe, call from the thread that is sent to sleep
+ * Do not call from outside the threads (calling outside the thread cause blocking last active thread)
+ * last_wake - release time of the previous period in milliseconds, initialize it once with SL_GetTick() before the loop
+ * period - loop period in milliseconds
+ * The thread sleeps until *last_wake + period and *last_wake is moved to that time,
+ * so the execution time of the loop body and the scheduling latency do not accumulate
+ * Returns execution status
+ * FOS__FAIL - if the release time has already passed (overrun) or the arguments are wrong:
+ * the thread does not sleep, the missed periods are skipped and *last_wake is moved to the latest passed release,
+ * the overrun is counted in the thread
+ */
+fos_ret_t API_FOS_SleepUntil(uint32_t *last_wake, uint32_t period)
+{
+	return SYS_FOS_SleepUntil(last_wake, period);
+}
+
+
+/*
+ * Send current process to sleep for microseconds
+ * Thread-safe, call from the thread that is sent to sleep
+ * Do not call from outside the threads (calling outside the thread cause blocking last active thread)
+ * time_us - sleep timeout in microseconds
+ * The main timer fires at the wake-up time, but not earlier than FOS_MIN_TIM_PERIOD_US after the context switch
+ * The wake-up time is precise to the granularity of the time base (see API_FOS_GetTimeUs)
+ * Returns execution status
+ * Always returns FOS__OK under normal operation
+ */
+fos_ret_t API_FOS_SleepUs(uint32_t time_us)
+{
+	return SYS_FOS_SleepUs(time_us);
+}
+
+
+/*
+ * Send current process to sleep until the next release of a periodic loop with microsecond period
+ * Thread-safe, call from the thread that is sent to sleep
+ * Do not call from outside the threads (calling outside the thread cause blocking last active thread)
+ * last_wake_us - release time of the previous period in microseconds, initialize it once with API_FOS_GetTimeUs() before the loop
+ * period_us - loop period in microseconds
+ * The thread sleeps until *last_wake_us + period_us and *last_wake_us is moved to that time
+ * Returns execution status
+ * FOS__FAIL - if the release time has already passed (overrun) or the arguments are wrong:
+ * the thread does not sleep, the missed periods are skipped and *last_wake_us is moved to the latest passed release,
+ * the overrun is counted in the thread
+ */
+fos_ret_t API_FOS_SleepUntilUs(fos_time_t *last_wake_us, uint32_t period_us)
+{
+	return SYS_FOS_SleepUntilUs(last_wake_us, period_us);
+}
+
+
+/*
+ * Get the monotonic kernel time
+ * Thread-safe, call from the threads
+ * Returns time since the kernel start in microseconds, the 64-bit value never wraps
+ * The granularity is 1 ms with the default time base (SL_GetTick() * 1000) unless FOS_TIME_BASE_DWT_HZ is set
+ * in fos_conf.h or the platform overrides FOS_Platform_TimeBase_GetCounter() and FOS_Platform_TimeBase_GetFreq()
+ */
+fos_time_t API_FOS_GetTimeUs()
+{
+	return SYS_FOS_GetTimeUs();
+}
+
+
 /*
  * Acquire binary semaphore
  * Thread-safe, call from the thread that is acquiring semaphore
@@ -134,6 +200,10 @@ fos_ret_t API_FOS_SemBinaryGiveFromISR(user_desc_t semb)
  * Thread-safe, call from the thread or from the main loop
  * Do not call from interrupts (it can lead to unpredictable behavior)
  * user_init - settings for created thread
+ * A run-to-completion thread ('rtc_sw') has no heap, it is rejected if 'heap_size' is not 0.
+ * It runs on the stack shared by the run-to-completion threads of its priority: the stack is allocated by the first
+ * such thread with its 'stack_size' (or FOS_RTC_STACK_SIZE if it is larger, see fos_conf.h),
+ * a later thread with a larger 'stack_size' is rejected
  * Returns the user descriptor of created thread or 'FOS_WRONG_USER_DESC' in case of an error
  */
 user_desc_t API_FOS_CreateThread(fos_thread_user_init_t *user_init)
@@ -222,6 +292,8 @@ fos_ret_t API_FOS_DeleteSemBinary(user_desc_t semb)
  * Thread-safe, call from the thread or from the main loop
  * Do not call from interrupts (it can lead to unpredictable behavior)
  * desc - user descriptor of the started thread
+ * A run-to-completion thread (see 'rtc_sw' in fos_thread_user_init_t) runs one job from its entry point on each start,
+ * the job starts once no other job is running on the shared stack of the threads with the same priority
  * Returns execution status
  * FOS__FAIL - if desc is wrong or the thread is not ready to run
  */
@@ -368,6 +440,7 @@ fwriter_t* API_File_CreateFWriter(uint16_t write_buf_len)
  * Do not call from interrupts (it can lead to unpredictable behavior)
  * semb - a binaty semaphore
  * timeout_ms - timeout in ms, to disable set into 0 or FOS_INF_TIME
+ * The timeout is counted on the microsecond time base (see API_FOS_GetTimeUs), up to FOS_TIME_MAX_AHEAD_US / 1000 ms
  * Returns execution status
  * FOS__FAIL - if semb is wrong
  */
@@ -455,6 +528,7 @@ fos_ret_t API_FOS_DeleteSemCnt(user_desc_t semc)
  * Do not call from interrupts (it can lead to unpredictable behavior)
  * semc - a semaphore
  * timeout_ms - timeout in ms, to disable set into 0 or FOS_INF_TIME
+ * The timeout is counted on the microsecond time base (see API_FOS_GetTimeUs), up to FOS_TIME_MAX_AHEAD_US / 1000 ms
  * Returns execution status
  * FOS__FAIL - if semc is wrong
  */
@@ -471,6 +545,7 @@ fos_ret_t API_FOS_SemCntSetTimeout(user_desc_t semc, uint32_t timeout_ms)
  * size  - max data count in uint32_t pithes
  * mode  - queue mode
  * timeout_ms - timeout in ms, to disable set into 0 or FOS_INF_TIME
+ * The timeout is counted on the microsecond time base (see API_FOS_GetTimeUs), up to FOS_TIME_MAX_AHEAD_US / 1000 ms
  * Returns the user descriptor of created object or 'FOS_WRONG_USER_DESC' in case of an error
  */
 user_desc_t API_FOS_CreateQueue32(uint16_t size, fos_queue_mode_t mode, uint32_t timeout_ms)
@@ -541,6 +616,374 @@ fos_ret_t API_FOS_Queue32WriteDataFromISR(user_desc_t que, uint32_t data)
 }
 
 
+/*
+ * Set time slice of the thread with the specified descriptor
+ * Thread-safe, call from the thread or from the main loop
+ * Do not call from interrupts (it can lead to unpredictable behavior)
+ * desc - thread descriptor
+ * quantum_us - time slice in microseconds, 0 - main timer period (FOS_SWITCH_CONTEXT_TIME_US)
+ * The value is limited to the range FOS_MIN_TIM_PERIOD_US...FOS_MAX_TIM_PERIOD_US and applied at the next switch to the thread
+ * Returns execution status
+ * FOS__FAIL - if desc is wrong
+ */
+fos_ret_t API_FOS_SetQuantumDesc(user_desc_t desc, uint32_t quantum_us)
+{
+	return SYS_FOS_SetQuantumDesc(desc, quantum_us);
+}
+
+
+/*
+ * Complete the current job of the periodic (EDF) thread and wait for the release of the next job
+ * Thread-safe, call from the periodic thread at the end of each job
+ * Do not call from outside the threads (it has no effect)
+ * A periodic thread is created with non-zero 'rt.period_ms' in fos_thread_user_init_t
+ * Periodic threads are dispatched earliest deadline first at the FOS_EDF_PRIORITY level
+ * Returns execution status
+ * FOS__FAIL - if the thread is not periodic or the completed job missed its deadline
+ */
+fos_ret_t API_FOS_WaitNextPeriod()
+{
+	return SYS_FOS_WaitNextPeriod();
+}
+
+
+/*
+ * Create a mutex with priority inheritance
+ * Thread-safe, call from the thread or from the main loop
+ * Do not call from interrupts (it can lead to unpredictable behavior)
+ * Returns the user descriptor of created object or 'FOS_WRONG_USER_DESC' in case of an error
+ */
+user_desc_t API_FOS_CreateMutex()
+{
+	return SYS_FOS_CreateMutex(FOS_NO_CEILING);
+}
+
+
+/*
+ * Delete a mutex
+ * Thread-safe, call from the thread or from the main loop
+ * Do not call from interrupts (it can lead to unpredictable behavior)
+ * mtx - a mutex to be deleted
+ * Returns execution status
+ * FOS__FAIL - if mtx is wrong or the mutex is locked
+ */
+fos_ret_t API_FOS_DeleteMutex(user_desc_t mtx)
+{
+	return SYS_FOS_DeleteMutex(mtx);
+}
+
+
+/*
+ * Lock a mutex
+ * Thread-safe, call from the thread only
+ * Do not call from interrupts or from the main loop (it can lead to unpredictable behavior)
+ * If the mutex is locked by another thread the calling thread is blocked until the mutex is passed to it
+ * While the thread waits, the owner of the mutex runs at the priority of the thread if it is higher,
+ * the priority is passed further if the owner waits for another mutex
+ * mtx - mutex user descriptor
+ * Returns execution status
+ * FOS__FAIL - if mtx is wrong or the mutex is already locked by the calling thread
+ */
+fos_ret_t API_FOS_MutexLock(user_desc_t mtx)
+{
+	return SYS_FOS_MutexLock(mtx);
+}
+
+
+/*
+ * Unlock a mutex
+ * Thread-safe, call from the thread only
+ * Do not call from interrupts or from the main loop (it can lead to unpredictable behavior)
+ * The mutex is passed to the highest priority waiting thread, the calling thread gets back its own priority
+ * mtx - mutex user descriptor
+ * Returns execution status
+ * FOS__FAIL - if mtx is wrong or the mutex is not locked by the calling thread
+ */
+fos_ret_t API_FOS_MutexUnlock(user_desc_t mtx)
+{
+	return SYS_FOS_MutexUnlock(mtx);
+}
+
+
+/*
+ * Create a mutex with immediate priority ceiling
+ * Thread-safe, call from the thread or from the main loop
+ * Do not call from interrupts (it can lead to unpredictable behavior)
+ * The thread locking the mutex is raised to the ceiling priority at once until unlock,
+ * so a thread which may lock the mutex cannot preempt the owner and never blocks on it
+ * Use the same API_FOS_MutexLock / API_FOS_MutexUnlock / API_FOS_DeleteMutex
+ * ceiling - the highest priority of the threads locking the mutex
+ * Returns the user descriptor of created object or 'FOS_WRONG_USER_DESC' in case of an error
+ */
+user_desc_t API_FOS_CreateMutexCeiling(uint8_t ceiling)
+{
+	return SYS_FOS_CreateMutex(ceiling);
+}
+
+
+/*
+ * Set CPU budget of the thread with the specified descriptor
+ * Thread-safe, call from the thread or from the main loop
+ * Do not call from interrupts (it can lead to unpredictable behavior)
+ * desc - thread descriptor
+ * budget_us - execution time allowed to the thread in each period in microseconds, 0 - unlimited
+ * period_ms - budget replenishment period in milliseconds
+ * The thread that has used up its budget is blocked until the start of the next period,
+ * so it can take at most budget_us of each period_ms from the lower priority threads
+ * The budget can also be set at creation with 'budget' in fos_thread_user_init_t
+ * Returns execution status
+ * FOS__FAIL - if desc is wrong
+ */
+fos_ret_t API_FOS_SetBudgetDesc(user_desc_t desc, uint32_t budget_us, uint32_t period_ms)
+{
+	return SYS_FOS_SetBudgetDesc(desc, budget_us, period_ms);
+}
+
+
+/*
+ * Lock the scheduler: the running thread is not preempted until the matching API_FOS_SchedUnlock()
+ * Thread-safe, call from the thread, nested calls are allowed
+ * Do not call from interrupts (it can lead to unpredictable behavior)
+ * Interrupts stay enabled, the main timer and the wake-up of higher priority threads
+ * only mark the switch as pending, it is done on the last unlock
+ * A cheap alternative to a semaphore for short updates of the data shared by threads (not by interrupts)
+ * Sleeping or blocking ends the protection: the lock is saved with the thread,
+ * other threads run while it waits and are preempted as usual
+ */
+void API_FOS_SchedLock()
+{
+	SYS_FOS_SchedLock();
+}
+
+
+/*
+ * Unlock the scheduler locked by API_FOS_SchedLock()
+ * Thread-safe, call from the thread that has locked the scheduler
+ * Do not call from interrupts (it can lead to unpredictable behavior)
+ * The deferred switch is done when the lock counter reaches zero
+ */
+void API_FOS_SchedUnlock()
+{
+	SYS_FOS_SchedUnlock();
+}
+
+
+/*
+ * Hand the rest of the time slice of the current thread to another thread
+ * Thread-safe, call from the thread that yields
+ * Do not call from interrupts (it can lead to unpredictable behavior)
+ * thr - descriptor of the READY thread to switch to
+ * The thread runs at once for the rest of the time slice unless another ready thread outranks it,
+ * then the scheduler chooses the thread as usual
+ * Returns execution status
+ * FOS__FAIL - if thr is wrong, is the current thread or is not READY (no switch is done)
+ */
+fos_ret_t API_FOS_YieldTo(user_desc_t thr)
+{
+	return SYS_FOS_YieldToDesc(thr);
+}
+
+
+/*
+ * Release binary semaphore and switch to the thread waiting for it
+ * Thread-safe, call from the thread
+ * Do not call from interrupts (use API_FOS_SemBinaryGiveFromISR)
+ * semb - binary semaphore user descriptor
+ * The unblocked thread gets the rest of the time slice as with API_FOS_YieldTo(),
+ * it is a plain release if no thread is waiting for the semaphore
+ * Returns execution status
+ * FOS__FAIL - if semb is wrong
+ */
+fos_ret_t API_FOS_SemBinaryGiveSwitch(user_desc_t semb)
+{
+	return SYS_FOS_SemBinaryGiveSwitch(semb);
+}
+
+
+/*
+ * Send message to the thread and wait for its reply (synchronous IPC)
+ * Thread-safe, call from the sending thread
+ * Do not call from outside the threads and from interrupts (it can lead to unpredictable behavior)
+ * thr - descriptor of the receiving thread
+ * msg - message, it is copied directly to the buffer of the receiver
+ * reply - buffer for the reply, NULL - the reply is not needed
+ * If the receiver is waiting in API_FOS_Receive() the thread switches straight to it,
+ * otherwise the sender waits in the queue of the receiver
+ * Returns execution status
+ * FOS__FAIL - if thr is wrong or is not running, or the receiver has terminated before the reply
+ */
+fos_ret_t API_FOS_Send(user_desc_t thr, fos_ipc_msg_t *msg, fos_ipc_msg_t *reply)
+{
+	fos_ret_t ret = SYS_FOS_IpcSend(thr, msg, reply);
+	if(ret == FOS__OK)                                   // the reply has been received
+		ret = (SYS_FOS_IpcGetPartner() != FOS_WRONG_USER_DESC) ? FOS__OK : FOS__FAIL;
+	return ret;
+}
+
+
+/*
+ * Receive message sent by API_FOS_Send() (synchronous IPC)
+ * Thread-safe, call from the receiving thread
+ * Do not call from outside the threads and from interrupts (it can lead to unpredictable behavior)
+ * msg - buffer for the message
+ * The thread waits if no thread is sending, the sender waits for API_FOS_Reply()
+ * Returns descriptor of the sender to reply to
+ * FOS_WRONG_USER_DESC - if msg is wrong
+ */
+user_desc_t API_FOS_Receive(fos_ipc_msg_t *msg)
+{
+	if(SYS_FOS_IpcReceive(msg) != FOS__OK)
+		return FOS_WRONG_USER_DESC;
+	return SYS_FOS_IpcGetPartner();                     // the message has been received
+}
+
+
+/*
+ * Reply to the message received by API_FOS_Receive() (synchronous IPC)
+ * Thread-safe, call from the thread that has received the message
+ * Do not call from outside the threads and from interrupts (it can lead to unpredictable behavior)
+ * thr - descriptor of the sender
+ * reply - reply copied to the buffer of the sender, NULL - no reply data
+ * The thread switches straight back to the sender
+ * Returns execution status
+ * FOS__FAIL - if thr is wrong or is not waiting for the reply of the current thread
+ */
+fos_ret_t API_FOS_Reply(user_desc_t thr, fos_ipc_msg_t *reply)
+{
+	return SYS_FOS_IpcReply(thr, reply);
+}
+
+
+/*
+ * Set CPU reservation of the thread group
+ * Thread-safe, call from the thread or from the main loop
+ * Do not call from interrupts (it can lead to unpredictable behavior)
+ * group - group number, 1..FOS_GROUP_CNT
+ * reserve_us - time guaranteed to the group in each period in microseconds, 0 - no guarantee
+ * budget_us - maximum time of the group in each period in microseconds, 0 - unlimited
+ * period_ms - period in milliseconds
+ * The threads of the group that has got less than reserve_us in the current period run ahead of the other threads
+ * regardless of their priorities, the threads inside the group are scheduled by their priorities.
+ * The group that has used up budget_us waits for the next period with all its threads.
+ * Threads join the group with 'group' in fos_thread_user_init_t or with API_FOS_SetThreadGroupDesc()
+ * Returns execution status
+ * FOS__FAIL - if group is wrong or reserve_us exceeds the period
+ */
+fos_ret_t API_FOS_SetGroup(uint8_t group, uint32_t reserve_us, uint32_t budget_us, uint32_t period_ms)
+{
+	return SYS_FOS_SetGroup(group, reserve_us, budget_us, period_ms);
+}
+
+
+/*
+ * Move the thread to the group with CPU reservation
+ * Thread-safe, call from the thread or from the main loop
+ * Do not call from interrupts (it can lead to unpredictable behavior)
+ * desc - thread descriptor
+ * group - group number, 1..FOS_GROUP_CNT, FOS_NO_GROUP - take the thread out of groups
+ * Returns execution status
+ * FOS__FAIL - if desc or group is wrong
+ */
+fos_ret_t API_FOS_SetThreadGroupDesc(user_desc_t desc, uint8_t group)
+{
+	return SYS_FOS_SetThreadGroupDesc(desc, group);
+}
+
+
+/*
+ * Start time-triggered cyclic executive with the static table
+ * Thread-safe, call from the thread or from the main loop
+ * Do not call from interrupts (it can lead to unpredictable behavior)
+ * table - table declared with FOS_TT_TABLE(): major frame of 'minor_cnt' minor frames of 'minor_us' microseconds,
+ * each slot runs the thread named 'name' for 'len_us' microseconds from 'offset_us' of the minor frame 'minor'
+ * The threads are found by name when the table starts, so the names of the table threads must be unique.
+ * The slots are counted from the fixed start of the major frame on the kernel time base (FOS_Time_GetUs()).
+ * The threads of the table run in their slots only, ahead of any other thread, the main timer fires at the slot boundaries.
+ * The time out of the slots and the slack of the slots are left to the other threads.
+ * The job still running at the end of its slot is stopped until the next slot of the thread and reported
+ * as FOS_ERROR_TT_OVERRUN error.
+ * Returns execution status
+ * FOS__FAIL - if the slots overlap or leave their minor frames, or the thread of a slot is not found
+ */
+fos_ret_t API_FOS_TtStart(const fos_tt_table_t *table)
+{
+	return SYS_FOS_TtStart(table);
+}
+
+
+/*
+ * Stop time-triggered cyclic executive, the threads of the table are scheduled by their priorities
+ * Thread-safe, call from the thread or from the main loop
+ * Do not call from interrupts (it can lead to unpredictable behavior)
+ * Returns execution status
+ */
+fos_ret_t API_FOS_TtStop()
+{
+	return SYS_FOS_TtStop();
+}
+
+
+/*
+ * Complete the job of the current thread and wait for its next slot of the time-triggered table
+ * Thread-safe, call from the thread of the table at the end of each job
+ * Do not call from outside the threads (it has no effect)
+ * Returns execution status
+ * FOS__FAIL - if the thread has no slots in the running table
+ */
+fos_ret_t API_FOS_TtWaitNextSlot()
+{
+	return SYS_FOS_TtWaitNextSlot();
+}
+
+
+/*
+ * Set own priority of the thread
+ * Thread-safe, call from the thread or from the main loop
+ * Do not call from interrupts (it can lead to unpredictable behavior)
+ * desc - thread descriptor
+ * priority - new priority, 0 is the highest, FOS_PRIORITY_CNT - 1 is the lowest
+ * The thread is moved to the ready list of its new priority at once and preempts the current thread if it outranks it.
+ * The priority inherited from the mutexes held by the thread is kept until they are unlocked.
+ * Periodic (EDF) threads keep running at the FOS_EDF_PRIORITY level
+ * Returns execution status
+ * FOS__FAIL - if desc or priority is wrong or the thread is run-to-completion
+ */
+fos_ret_t API_FOS_SetPriority(user_desc_t desc, uint8_t priority)
+{
+	return SYS_FOS_SetPriorityDesc(desc, priority);
+}
+
+
+/*
+ * Suspend the thread until API_FOS_Resume() is called
+ * Thread-safe, call from the thread or from the main loop
+ * Do not call from interrupts (it can lead to unpredictable behavior)
+ * desc - thread descriptor, the thread can suspend itself
+ * The suspended thread keeps its locks and its wake-up time: after resume the sleeping thread goes on sleeping
+ * and the thread waiting for an object goes on waiting
+ * Returns execution status
+ * FOS__FAIL - if desc is wrong or the thread is not started
+ */
+fos_ret_t API_FOS_Suspend(user_desc_t desc)
+{
+	return SYS_FOS_SuspendDesc(desc);
+}
+
+
+/*
+ * Resume the suspended thread
+ * Thread-safe, call from the thread or from the main loop
+ * Do not call from interrupts (it can lead to unpredictable behavior)
+ * desc - thread descriptor
+ * Returns execution status
+ * FOS__FAIL - if desc is wrong or the thread is not suspended
+ */
+fos_ret_t API_FOS_Resume(user_desc_t desc)
+{
+	return SYS_FOS_ResumeDesc(desc);
+}
+
+
 
 
 
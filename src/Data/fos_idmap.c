@@ -0,0 +1,155 @@
+/**************************************************************************//**
+ * @file      fos_idmap.c
+ * @brief     Free slot table of kernel object table. Source file.
+ * @version   V1.0.00
+ * @date      16.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+
+#include "Data/fos_idmap.h"
+#include <string.h>
+
+
+#define FOS_IDMAP_BIT(i)   (0x80000000UL >> ((i) & 31))    // bit of slot or word i in its word
+
+
+// find maximum index of occupied slot below id
+static fos_id_t Private_FOS_IdMap_FindMaxBelow(fos_idmap_t *p, fos_id_t id);
+
+
+// initialization; bits - storage of FOS_IDMAP_SIZE(cnt) words, all slots are free
+void FOS_IdMap_Init(fos_idmap_t *p, uint32_t *bits, fos_id_t cnt)
+{
+	if((p == NULL) || (bits == NULL))
+		return;
+
+	uint16_t words = FOS_IDMAP_WORDS(cnt);
+
+	p->map     = bits;
+	p->sum     = bits + words;
+	p->gen     = (uint16_t*)(bits + words + FOS_IDMAP_GROUPS(cnt));
+	p->cnt     = cnt;
+	p->used    = 0;
+	p->max_ind = 0;
+
+	memset(bits, 0, FOS_IDMAP_SIZE(cnt) * sizeof(uint32_t));
+
+	for(fos_id_t i = 0; i < cnt; i++)
+		p->map[i / 32] |= FOS_IDMAP_BIT(i);
+
+	for(uint16_t w = 0; w < words; w++)
+		p->sum[w / 32] |= FOS_IDMAP_BIT(w);
+
+	for(fos_id_t i = 0; i < cnt; i++)
+		p->gen[i] = 1;
+}
+
+
+// take a free slot (FOS_EMPTY_ID - no free slots)
+fos_id_t FOS_IdMap_Alloc(fos_idmap_t *p)
+{
+	if((p == NULL) || (p->used >= p->cnt))
+		return FOS_EMPTY_ID;
+
+	// the first word with a free slot, then the first free slot in it
+	uint16_t g = 0;
+	while(p->sum[g] == 0)
+		g++;
+
+	uint16_t w  = g * 32 + FOS_CLZ(p->sum[g]);
+	fos_id_t id = w * 32 + FOS_CLZ(p->map[w]);
+
+	p->map[w] &= ~FOS_IDMAP_BIT(id);
+	if(p->map[w] == 0)
+		p->sum[g] &= ~FOS_IDMAP_BIT(w);
+
+	p->used++;
+	if(id > p->max_ind)
+		p->max_ind = id;
+
+	return id;
+}
+
+
+// free the slot
+fos_ret_t FOS_IdMap_Free(fos_idmap_t *p, fos_id_t id)
+{
+	if((p == NULL) || (id >= p->cnt))
+		return FOS__FAIL;
+
+	uint16_t w = id / 32;
+
+	if(p->map[w] & FOS_IDMAP_BIT(id))    // the slot is free already
+		return FOS__FAIL;
+
+	p->map[w] |= FOS_IDMAP_BIT(id);
+	p->sum[w / 32] |= FOS_IDMAP_BIT(w);
+
+	// the next object in the slot gets a new generation, so the descriptors of the freed one do not match it
+	if(++p->gen[id] == 0)
+		p->gen[id] = 1;
+
+	p->used--;
+	if(id == p->max_ind)
+		p->max_ind = Private_FOS_IdMap_FindMaxBelow(p, id);
+
+	return FOS__OK;
+}
+
+
+// get maximum index of occupied slot (0 - no occupied slots)
+fos_id_t FOS_IdMap_GetMaxInd(fos_idmap_t *p)
+{
+	if(p == NULL)
+		return 0;
+	return p->max_ind;
+}
+
+
+// get generation of the slot (0 - wrong slot)
+uint16_t FOS_IdMap_GetGen(fos_idmap_t *p, fos_id_t id)
+{
+	if((p == NULL) || (id >= p->cnt))
+		return 0;
+	return p->gen[id];
+}
+
+
+
+
+
+
+// find maximum index of occupied slot below id
+// the words are looked through only when the slot with the maximum index is freed
+static fos_id_t Private_FOS_IdMap_FindMaxBelow(fos_idmap_t *p, fos_id_t id)
+{
+	uint32_t used;
+
+	for(int32_t w = id / 32; w >= 0; w--)
+	{
+		used = ~p->map[w];
+		if(w == id / 32)                                          // only the slots below id
+			used &= (id & 31) ? ~(0xFFFFFFFFUL >> (id & 31)) : 0;
+
+		if(used)                                                  // the lowest set bit is the highest occupied slot
+			return (fos_id_t)(w * 32 + FOS_CLZ(used & (~used + 1)));
+	}
+
+	return 0;
+}
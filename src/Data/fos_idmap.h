@@ -0,0 +1,67 @@
+/**************************************************************************//**
+ * @file      fos_idmap.h
+ * @brief     Free slot table of kernel object table. Header file.
+ * @version   V1.0.00
+ * @date      16.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef DATA_FOS_IDMAP_H_
+#define DATA_FOS_IDMAP_H_
+
+
+#include "fos_types.h"
+
+
+#define FOS_IDMAP_WORDS(cnt)   (((cnt) + 31) / 32)                          // words of free slot bits
+#define FOS_IDMAP_GROUPS(cnt)  ((FOS_IDMAP_WORDS(cnt) + 31) / 32)           // words of summary bits
+#define FOS_IDMAP_GENS(cnt)    (((cnt) + 1) / 2)                            // words of 16-bit slot generations
+#define FOS_IDMAP_SIZE(cnt)    (FOS_IDMAP_WORDS(cnt) + FOS_IDMAP_GROUPS(cnt) + FOS_IDMAP_GENS(cnt))  // storage size in words
+
+
+// free slot table: bit 31 of word 0 is slot 0, a set bit is a free slot;
+// a summary bit is set while its word of slot bits has a free slot, so a slot is found by two CLZ;
+// the generation of a slot changes each time the slot is freed, it is never 0
+typedef struct
+{
+	uint32_t *map;            // free slot bits (FOS_IDMAP_WORDS words)
+	uint32_t *sum;            // summary bits (FOS_IDMAP_GROUPS words)
+	uint16_t *gen;            // slot generations (FOS_IDMAP_GENS words)
+	fos_id_t  cnt;            // slot count
+	fos_id_t  used;           // occupied slot count
+	fos_id_t  max_ind;        // maximum index of occupied slot (0 - no occupied slots)
+
+} fos_idmap_t;
+
+
+// initialization; bits - storage of FOS_IDMAP_SIZE(cnt) words, all slots are free
+void FOS_IdMap_Init(fos_idmap_t *p, uint32_t *bits, fos_id_t cnt);
+
+// take a free slot (FOS_EMPTY_ID - no free slots)
+fos_id_t FOS_IdMap_Alloc(fos_idmap_t *p);
+
+// free the slot
+fos_ret_t FOS_IdMap_Free(fos_idmap_t *p, fos_id_t id);
+
+// get maximum index of occupied slot (0 - no occupied slots)
+fos_id_t FOS_IdMap_GetMaxInd(fos_idmap_t *p);
+
+// get generation of the slot (0 - wrong slot)
+uint16_t FOS_IdMap_GetGen(fos_idmap_t *p, fos_id_t id);
+
+
+#endif /* DATA_FOS_IDMAP_H_ */
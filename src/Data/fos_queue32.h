@@ -54,7 +54,7 @@ fos_ret_t FOS_Queue32_WriteData(fos_queue32_t* p, uint32_t data);
 
 // ask data
 // if thr_id == FOS_SPECIAL_ID semafore is taken but thread is not blocked
-fos_ret_t FOS_Queue32_AskData(fos_queue32_t* p, uint8_t thr_id);
+fos_ret_t FOS_Queue32_AskData(fos_queue32_t* p, fos_id_t thr_id);
 
 // read data
 // one must ask data before read every times
@@ -22,46 +22,61 @@
 
 
 #include "Kernel/fos.h"
+#include "Sync/fos_lock.h"
+#include "Platform/sl_platform.h"
+#include "Platform/fos_time.h"
 #include <string.h>
 
 // get thread identifier by its descriptor
-static uint8_t FOS_GetThreadId(fos_t *p, fos_thread_t *thr);
+static fos_id_t FOS_GetThreadId(fos_t *p, fos_thread_t *thr);
 
 // get thread descriptor by its identifier
-static fos_thread_t* FOS_GetThreadDesc(fos_t *p, uint8_t id);
+static fos_thread_t* FOS_GetThreadDesc(fos_t *p, fos_id_t id);
+
+// get thread identifier by its name
+static fos_id_t Private_FOS_GetNameThreadId(fos_t *p, const char *name);
 
 // send thread with identifier to sleep
-static fos_ret_t FOS_SleepId(fos_t *p, uint8_t id, uint32_t time);
+static fos_ret_t FOS_SleepId(fos_t *p, fos_id_t id, uint32_t time);
 
 // get binary semaphore identifier by user defined descriptor
-static uint8_t FOS_GetUdSemaphoreBinaryId(fos_t *p, user_desc_t user_desc);
+static fos_id_t FOS_GetUdSemaphoreBinaryId(fos_t *p, user_desc_t user_desc);
 
 // get binary semaphore identifier its descriptor
-static uint8_t FOS_GetSemaphoreBinaryId(fos_t *p, fos_semaphore_binary_t *semb);
+static fos_id_t FOS_GetSemaphoreBinaryId(fos_t *p, fos_semaphore_binary_t *semb);
 
 // get binary semaphore descriptor by its identifier
-static fos_semaphore_binary_t* FOS_GetSemaphoreBinaryDesc(fos_t *p, uint8_t id);
+static fos_semaphore_binary_t* FOS_GetSemaphoreBinaryDesc(fos_t *p, fos_id_t id);
 
 // get writer object identifier by its descriptor
-static uint8_t FOS_GetFWriterId(fos_t *p, fwriter_t *fw);
+static fos_id_t FOS_GetFWriterId(fos_t *p, fwriter_t *fw);
 
 // get semaphore identifier by user defined descriptor
-static uint8_t FOS_GetUdSemaphoreCntId(fos_t *p, user_desc_t user_desc);
+static fos_id_t FOS_GetUdSemaphoreCntId(fos_t *p, user_desc_t user_desc);
 
 // get semaphore identifier by its descriptor
-static uint8_t FOS_GetSemaphoreCntId(fos_t *p, fos_semaphore_cnt_t *semc);
+static fos_id_t FOS_GetSemaphoreCntId(fos_t *p, fos_semaphore_cnt_t *semc);
 
 // get binary semaphore descriptor by its identifier
-static fos_semaphore_cnt_t* FOS_GetSemaphoreCntDesc(fos_t *p, uint8_t id);
+static fos_semaphore_cnt_t* FOS_GetSemaphoreCntDesc(fos_t *p, fos_id_t id);
 
 // get queue32 identifier by its descriptor
-static uint8_t FOS_GetQueue32Id(fos_t *p, fos_queue32_t *que);
+static fos_id_t FOS_GetQueue32Id(fos_t *p, fos_queue32_t *que);
 
 // get queue32 identifier by user defined descriptor
-static uint8_t FOS_GetUdQueue32Id(fos_t *p, user_desc_t user_desc);
+static fos_id_t FOS_GetUdQueue32Id(fos_t *p, user_desc_t user_desc);
 
 // get queue32 descriptor by its identifier
-static fos_queue32_t* FOS_GetQueue32Desc(fos_t *p, uint8_t id);
+static fos_queue32_t* FOS_GetQueue32Desc(fos_t *p, fos_id_t id);
+
+// get mutex identifier by user defined descriptor
+static fos_id_t FOS_GetUdMutexId(fos_t *p, user_desc_t user_desc);
+
+// get mutex identifier by its descriptor
+static fos_id_t FOS_GetMutexId(fos_t *p, fos_mutex_t *mtx);
+
+// get mutex descriptor by its identifier
+static fos_mutex_t* FOS_GetMutexDesc(fos_t *p, fos_id_t id);
 
 // OS kernel initialization
 static void Private_FOS_Core_Init(fos_t *p);
@@ -69,14 +84,20 @@ static void Private_FOS_Core_Init(fos_t *p);
 // thread scheduler
 static int16_t Private_FOS_Sheduler(fos_t *p);
 
+// switch from the current thread to the next one
+static void Private_FOS_SwitchThread(fos_t *p, fos_thread_t *thr, int16_t next_thr);
+
+// check if the switch needs no more than pick-and-swap
+static fos_sw_t Private_FOS_IsDirectSwitchable(fos_t *p, fos_thread_t *thr);
+
 // save user thread stack
 static void Private_FOS_SaveUserSP(fos_t *p);
 
 // load user thread stack
 static void Private_FOS_LoadUserSP(fos_t *p);
 
-// generate unique user descriptor
-static user_desc_t Private_FOS_GenUserDesc(fos_t *p);
+// make user descriptor of the object in the table slot
+static user_desc_t Private_FOS_MakeUserDesc(fos_idmap_t *map, fos_id_t slot);
 
 // update maximum index of thread descriptor table
 static void Private_FOS_UpdThreadMaxInd(fos_t *p);
@@ -93,11 +114,116 @@ static void Private_FOS_UpdQueue32MaxInd(fos_t *p);
 // update maximum index of writer object descriptor table
 static void Private_FOS_UpdFWriterMaxInd(fos_t *p);
 
+// update maximum index of mutex descriptor table
+static void Private_FOS_UpdMutexMaxInd(fos_t *p);
+
+// recompute thread priority from its own priority, the ceilings of its mutexes and the priorities of the threads waiting for them
+static fos_sw_t Private_FOS_UpdThreadPriority(fos_t *p, fos_id_t id, fos_thread_t *thr);
+
+// pass priority along the chain of mutex owners
+static void Private_FOS_InheritPriority(fos_t *p, fos_id_t mutex_id);
+
+// the new mutex owner stops waiting and inherits priority of the rest of the waiting threads
+static void Private_FOS_UpdMutexOwner(fos_t *p, fos_id_t mutex_id);
+
+// priority the thread waits for a mutex with
+static uint8_t Private_FOS_GetWaitPriority(fos_thread_t *thr);
+
+// add the mutex to the list of the mutexes held by the thread
+static void Private_FOS_MutexHold(fos_t *p, fos_thread_t *thr, fos_id_t mutex_id);
+
+// remove the mutex from the list of the mutexes held by the thread
+static void Private_FOS_MutexRelease(fos_t *p, fos_thread_t *thr, fos_id_t mutex_id);
+
+// get shared stack of the run-to-completion thread
+static volatile fos_rtc_stack_t* Private_FOS_GetThreadRtcStack(fos_t *p, fos_thread_t *thr);
+
+// start the next job on the free shared stack
+static fos_id_t Private_FOS_RtcStackProc(fos_t *p, volatile fos_rtc_stack_t *st);
+
+// put the thread with an activated job into the queue of its shared stack
+static void Private_FOS_RtcStackWait(fos_t *p, volatile fos_rtc_stack_t *st, fos_id_t id, fos_thread_t *thr);
+
+// remove the thread from the queue of its shared stack
+static void Private_FOS_RtcStackUnwait(fos_t *p, volatile fos_rtc_stack_t *st, fos_id_t id, fos_thread_t *thr);
+
+// the run-to-completion thread that has completed its job passes the shared stack on
+static void Private_FOS_RtcStackRelease(fos_t *p, fos_id_t id, fos_thread_t *thr);
+
 // terminating thread procedure
 static void Private_FOS_TerminatingThreadProc(fos_t *p);
 
+// unlink thread from the blocker object it waits on, whatever the object is:
+// binary or counting semaphore, queue32 or mutex
+static void Private_FOS_UnlinkWaitingThread(fos_t *p, fos_id_t thr_id, fos_thread_t *thr);
+
 // unlink thread from all locking objects
-static void Private_FOS_UnlinkThread(fos_t *p, uint8_t thr_id);
+static void Private_FOS_UnlinkThread(fos_t *p, fos_id_t thr_id);
+
+// update thread position in the timer queue
+static void Private_FOS_UpdThreadTimer(fos_t *p, fos_id_t id);
+
+// get the time to the nearest wake-up of threads and semaphore timeouts (if sem_sw), us
+static fos_ret_t Private_FOS_GetTimeToExpiry(fos_t *p, fos_sw_t sem_sw, uint32_t *dt_us);
+
+// get the time to the nearest semaphore timeout, us (FOS__FAIL - no timeout is pending)
+static fos_ret_t Private_FOS_GetTimeToSemTimeout(fos_t *p, uint32_t now_us, uint32_t *dt_us);
+
+#if defined(FOS_USE_DIRECT_SWITCH)
+// plan the next housekeeping by the main loop: at the end of the period or at the nearest semaphore timeout
+static void Private_FOS_PlanHousekeeping(fos_t *p);
+
+// bring the next housekeeping forward to the semaphore timeout of the thread that has just blocked
+static void Private_FOS_PlanSemTimeout(fos_t *p, fos_ret_t ts_ret, uint32_t ts);
+#endif
+
+// choose the main timer period for the next thread
+static void Private_FOS_SliceProc(fos_t *p);
+
+// handle semaphore timeouts and wake up the threads whose wake-up time has come
+static void Private_FOS_WakeUpProc(fos_t *p);
+
+// check if the ready thread must preempt the current thread
+static fos_sw_t Private_FOS_IsPreemptNeeded(fos_t *p, fos_thread_t *thr);
+
+// check if the thread waking up will preempt the current thread (filter of the timer queue)
+static fos_sw_t Private_FOS_IsWakeUpPreempting(void *ctx, fos_id_t id);
+
+// get the thread the current thread has handed its time slice to, if no ready thread outranks it
+static int16_t Private_FOS_GetYieldTarget(fos_t *p, uint32_t thr_dt_us, int16_t next_thr);
+
+// get the group of the thread (NULL - the thread does not belong to a group)
+static fos_group_t* Private_FOS_GetThreadGroup(fos_t *p, fos_thread_t *thr);
+
+// charge the run time of the thread to its group, throttle the group that has used up its budget
+static void Private_FOS_GroupCharge(fos_t *p, fos_thread_t *thr, uint32_t thr_dt_us);
+
+// the thread belongs to a group that has got less than its reserved time (filter of the scheduler)
+static fos_sw_t Private_FOS_IsGroupReserved(void *ctx, fos_id_t id);
+
+// correct the choice of the scheduler by the group reservations
+static int16_t Private_FOS_GroupProc(fos_t *p, int16_t next_thr);
+
+// release the threads of the time-triggered table at the starts of their slots and stop them at the ends
+static void Private_FOS_TtProc(fos_t *p);
+
+// get the ready thread of the running slot of the time-triggered table (-1 - none)
+static int16_t Private_FOS_TtGetThread(fos_t *p);
+
+// copy the message of the sender to the waiting receiver and unblock it
+static void Private_FOS_IpcDeliver(fos_t *p, fos_id_t dst_id, fos_thread_t *dst, fos_id_t src_id, fos_thread_t *src);
+
+// remove the sender from the list of the receiver: the send queue (first, last) or the reply list (first, NULL)
+static void Private_FOS_IpcRemoveSender(fos_t *p, volatile fos_id_t *first, volatile fos_id_t *last, fos_id_t src_id);
+
+// the sender whose message has been received waits for the reply in the reply list of the receiver
+static void Private_FOS_IpcWaitReply(fos_thread_t *dst, fos_id_t src_id, fos_thread_t *src);
+
+// release the senders of the list of the thread with FOS__FAIL
+static void Private_FOS_IpcFailSenders(fos_t *p, fos_id_t thr_id, fos_id_t first);
+
+// release the threads exchanging messages with the thread
+static void Private_FOS_IpcUnlink(fos_t *p, fos_id_t thr_id);
 
 // get current thread user descriptor
 static user_desc_t Private_FOS_GetCurrentThreadUd(fos_t *p);
@@ -135,36 +261,38 @@ fos_ret_t FOS_Start(fos_t *p)
 
 
 // get thread identifier by user defined descriptor
-uint8_t FOS_GetUdThreadId(fos_t *p, user_desc_t user_desc)
+fos_id_t FOS_GetUdThreadId(fos_t *p, user_desc_t user_desc)
 {
 	if((p == NULL) || (user_desc == FOS_WRONG_USER_DESC))
 		return FOS_WRONG_THREAD_ID;
 
-	for(uint8_t i = 0; i <= p->var.thread_max_ind; i++)
-		if(p->var.thread_desc_list[i])
-			if(p->var.thread_desc_list[i]->user_desc == user_desc)
-				return i;
+	// the slot is taken from the descriptor, the descriptor of the object in the slot must match it
+	fos_id_t id = FOS_USER_DESC_SLOT(user_desc);
+	fos_thread_t *obj = FOS_GetThreadDesc(p, id);
+	if((obj == NULL) || (obj->user_desc != user_desc))
+		return FOS_WRONG_THREAD_ID;
 
-	return FOS_WRONG_THREAD_ID;
+	return id;
 }
 
 
 // get thread identifier by its descriptor
-static uint8_t FOS_GetThreadId(fos_t *p, fos_thread_t *thr)
+static fos_id_t FOS_GetThreadId(fos_t *p, fos_thread_t *thr)
 {
-	if(p == NULL)
+	if((p == NULL) || (thr == NULL))
 		return FOS_WRONG_THREAD_ID;
 
-	for(uint8_t i = 0; i < FOS_MAX_THR_CNT; i++)
-		if(p->var.thread_desc_list[i] == thr)
-			return i;
+	// a registered thread is found in the slot of its user descriptor
+	fos_id_t id = FOS_USER_DESC_SLOT(thr->user_desc);
+	if(FOS_GetThreadDesc(p, id) != thr)
+		return FOS_WRONG_THREAD_ID;
 
-	return FOS_WRONG_THREAD_ID;
+	return id;
 }
 
 
 // get thread descriptor by identifier
-static fos_thread_t* FOS_GetThreadDesc(fos_t *p, uint8_t id)
+static fos_thread_t* FOS_GetThreadDesc(fos_t *p, fos_id_t id)
 {
 	if(p == NULL)
 		return NULL;
@@ -176,8 +304,25 @@ static fos_thread_t* FOS_GetThreadDesc(fos_t *p, uint8_t id)
 }
 
 
+// get thread identifier by its name (the first thread with the name)
+static fos_id_t Private_FOS_GetNameThreadId(fos_t *p, const char *name)
+{
+	if((p == NULL) || (name == NULL))
+		return FOS_WRONG_THREAD_ID;
+
+	for(fos_id_t i = 0; i <= p->var.thread_max_ind; i++)
+	{
+		fos_thread_t *thr = FOS_GetThreadDesc(p, i);
+		if((thr != NULL) && (strncmp(thr->name, name, FOS_THR_NAME_LEN) == 0))
+			return i;
+	}
+
+	return FOS_WRONG_THREAD_ID;
+}
+
+
 // get semaphore binary user descriptor by thread ID
-user_desc_t FOS_GetThreadSembId(fos_t *p, uint8_t id)
+user_desc_t FOS_GetThreadSembId(fos_t *p, fos_id_t id)
 {
 	if(p == NULL)
 		return FOS_WRONG_USER_DESC;
@@ -197,26 +342,26 @@ fos_ret_t FOS_ThreadReg(fos_t *p, fos_thread_t *thr)
 	if((p == NULL) || (thr == NULL))
 		return FOS__FAIL;
 
-	uint8_t ind = 0;
+	fos_id_t ind = 0;
 	fos_var_t *v = &p->var;
 
 	// check for duplicated threads
 	if(FOS_GetThreadId(p, thr) != FOS_WRONG_THREAD_ID)
 		return FOS__FAIL;
 
-	// search for available section
-	ind = FOS_GetThreadId(p, NULL);
-	if(ind == FOS_WRONG_THREAD_ID)
-		return FOS__FAIL;
-
-	// assign a unique user defined identifier to the thread
-	if(FOS_Thread_SetUserDesc(thr, Private_FOS_GenUserDesc(p), Private_FOS_GetThreadParentUd(p)) != FOS__OK)
+	// take free slot
+	ind = FOS_IdMap_Alloc(&v->thread_idmap);
+	if(ind == FOS_EMPTY_ID)
 		return FOS__FAIL;
 
-	// set thread registration flag
-	if(FOS_Thread_SetRegFlag(thr) != FOS__OK)
+	// assign a unique user defined identifier to the thread and set thread registration flag,
+	// the hot variables and the mode of the thread live in the kernel table
+	if((FOS_Thread_SetUserDesc(thr, Private_FOS_MakeUserDesc(&v->thread_idmap, ind), Private_FOS_GetThreadParentUd(p)) != FOS__OK) ||
+	   (FOS_Thread_SetRegFlag(thr, &v->thread_hot_list[ind]) != FOS__OK))
+	{
+		FOS_IdMap_Free(&v->thread_idmap, ind);
 		return FOS__FAIL;
-
+	}
 	v->thread_desc_list[ind] = thr;        // insert the pointer to an available section
 
 	Private_FOS_UpdThreadMaxInd(p);        // update maximum index
@@ -226,7 +371,7 @@ fos_ret_t FOS_ThreadReg(fos_t *p, fos_thread_t *thr)
 
 
 // start thread with identifier
-fos_ret_t FOS_RunId(fos_t *p, uint8_t id)
+fos_ret_t FOS_RunId(fos_t *p, fos_id_t id)
 {
 	if(p == NULL)
 		return FOS__FAIL;
@@ -236,13 +381,35 @@ fos_ret_t FOS_RunId(fos_t *p, uint8_t id)
 	if(thr == NULL)
 		return FOS__FAIL;
 
+	// a run-to-completion thread runs a job on each start
+	if(FOS_Thread_IsRtc(thr))
+	{
+		if(FOS_Thread_Activate(thr) != FOS__OK)
+			return FOS__FAIL;
+
+		// the job starts at once if the shared stack is free
+		volatile fos_rtc_stack_t *st = Private_FOS_GetThreadRtcStack(p, thr);
+		Private_FOS_RtcStackWait(p, st, id, thr);
+		id = Private_FOS_RtcStackProc(p, st);
+		thr = FOS_GetThreadDesc(p, id);
+		if(thr && Private_FOS_IsPreemptNeeded(p, thr))
+			FOS_System_Preempt();
+
+		return FOS__OK;
+	}
+
 	// set thread run flag
-	return FOS_Thread_SetRunFlag(thr);
+	if(FOS_Thread_SetRunFlag(thr) != FOS__OK)
+		return FOS__FAIL;
+
+	FOS_Schedule_UpdThread(&p->sheduler, id, thr);    // put the thread into the ready queue
+
+	return FOS__OK;
 }
 
 
 // terminate thread with identifier
-fos_ret_t FOS_TerminateId(fos_t *p, uint8_t id, int32_t terminate_code)
+fos_ret_t FOS_TerminateId(fos_t *p, fos_id_t id, int32_t terminate_code)
 {
 	if(p == NULL)
 		return FOS__FAIL;
@@ -256,6 +423,12 @@ fos_ret_t FOS_TerminateId(fos_t *p, uint8_t id, int32_t terminate_code)
 	if(FOS_Thread_SetTerminateFlag(thr, terminate_code) != FOS__OK)
 		return FOS__FAIL;
 
+	p->var.housekeeping_sw = FOS__ENABLE;             // the thread is deleted by the main loop
+
+	Private_FOS_UnlinkWaitingThread(p, id, thr);      // the thread does not take a token released before housekeeping
+	FOS_Schedule_UpdThread(&p->sheduler, id, thr);    // remove the thread from the ready queue
+	Private_FOS_UpdThreadTimer(p, id);                // remove the thread from the timer queue
+
 	if(id == p->var.current_thr)                // if current thread is being terminated
 		FOS_System_GoToKernelMode(FOS__DISABLE);    // switch to kernel mode
 
@@ -277,8 +450,30 @@ void FOS_Yield()
 }
 
 
+// hand the rest of the time slice of the current thread to the ready thread with identifier
+fos_ret_t FOS_YieldToId(fos_t *p, fos_id_t id)
+{
+	if(p == NULL)
+		return FOS__FAIL;
+
+	// get thread descriptor by identifier
+	fos_thread_t *thr = FOS_GetThreadDesc(p, id);
+	if(thr == NULL)
+		return FOS__FAIL;
+
+	// only the other ready thread can take the time slice
+	if((id == p->var.current_thr) || (thr->hot->state != FOS__THREAD_READY))
+		return FOS__FAIL;
+
+	p->var.yield_to = id;                          // the scheduler switches to it without choosing
+	FOS_System_GoToKernelMode(FOS__DISABLE);       // switch to kernel mode
+
+	return FOS__OK;
+}
+
+
 // send thread with identifier to sleep
-static fos_ret_t FOS_SleepId(fos_t *p, uint8_t id, uint32_t time)
+static fos_ret_t FOS_SleepId(fos_t *p, fos_id_t id, uint32_t time)
 {
 	if(p == NULL)
 		return FOS__FAIL;
@@ -289,6 +484,8 @@ static fos_ret_t FOS_SleepId(fos_t *p, uint8_t id, uint32_t time)
 		return FOS__FAIL;
 
 	FOS_ThreadSleep(thr, time);     // send the thread to sleep
+	FOS_Schedule_UpdThread(&p->sheduler, id, thr);    // remove the thread from the ready queue
+	Private_FOS_UpdThreadTimer(p, id);                // set the wake-up timer
 
 	if(id == p->var.current_thr)                // if current thread is being sent to sleep
 		FOS_System_GoToKernelMode(FOS__DISABLE);    // switch to kernel mode
@@ -304,893 +501,2367 @@ fos_ret_t FOS_Sleep(fos_t *p, uint32_t time)
 }
 
 
-// set blocking to thread with identifier
-fos_ret_t FOS_LockId(fos_t *p, uint8_t id, uint32_t lock)
+// send current thread to sleep until *last_wake + period and move *last_wake to that time
+// FOS__FAIL - the time has already passed (overrun), the thread does not sleep
+fos_ret_t FOS_SleepUntil(fos_t *p, uint32_t *last_wake, uint32_t period)
 {
 	if(p == NULL)
 		return FOS__FAIL;
 
-	// get thread descriptor by identifier
+	fos_id_t id = p->var.current_thr;
+
+	// get thread descriptor by id
 	fos_thread_t *thr = FOS_GetThreadDesc(p, id);
 	if(thr == NULL)
 		return FOS__FAIL;
 
-	FOS_ThreadLock(thr, lock);       // block the thread
+	fos_ret_t ret = FOS_ThreadSleepUntil(thr, last_wake, period);
+	if(thr->hot->state != FOS__THREAD_BLOCKED)       // overrun or the time is now: the thread goes on running
+		return ret;
 
-	if(id == p->var.current_thr)                 // if current thread is being blocked
-		FOS_System_GoToKernelMode(FOS__DISABLE);     // switch to kernel mode
+	FOS_Schedule_UpdThread(&p->sheduler, id, thr);    // remove the thread from the ready queue
+	Private_FOS_UpdThreadTimer(p, id);                // set the wake-up timer
 
-	return FOS__OK;
+	FOS_System_GoToKernelMode(FOS__DISABLE);          // switch to kernel mode
+
+	return ret;
 }
 
 
-// unblock thread with identifier
-fos_ret_t FOS_UnlockId(fos_t *p, uint8_t id, uint32_t lock)
+// send current thread to sleep for time_us microseconds
+fos_ret_t FOS_SleepUs(fos_t *p, uint32_t time_us)
 {
 	if(p == NULL)
 		return FOS__FAIL;
 
+	fos_id_t id = p->var.current_thr;
+
 	// get thread descriptor by id
 	fos_thread_t *thr = FOS_GetThreadDesc(p, id);
 	if(thr == NULL)
 		return FOS__FAIL;
 
-	FOS_ThreadUnlock(thr, lock);
+	FOS_ThreadSleepUs(thr, time_us);                  // send the thread to sleep
+	FOS_Schedule_UpdThread(&p->sheduler, id, thr);    // remove the thread from the ready queue
+	Private_FOS_UpdThreadTimer(p, id);                // set the wake-up timer
+
+	FOS_System_GoToKernelMode(FOS__DISABLE);          // switch to kernel mode
 
 	return FOS__OK;
 }
 
 
-// get semaphore identifier by user defined descriptor
-static uint8_t FOS_GetUdSemaphoreBinaryId(fos_t *p, user_desc_t user_desc)
+// send current thread to sleep until *last_wake_us + period_us in microseconds and move *last_wake_us to that time
+// FOS__FAIL - the time has already passed (overrun), the thread does not sleep
+fos_ret_t FOS_SleepUntilUs(fos_t *p, fos_time_t *last_wake_us, uint32_t period_us)
 {
-	if((p == NULL) || (user_desc == FOS_WRONG_USER_DESC))
-		return FOS_WRONG_SEM_BIN_ID;
+	if(p == NULL)
+		return FOS__FAIL;
 
-	for(uint8_t i = 0; i <= p->var.semb_max_ind; i++)
-		if(p->var.semb_desc_list[i])
-			if(p->var.semb_desc_list[i]->user_desc == user_desc)
-				return i;
+	fos_id_t id = p->var.current_thr;
 
-	return FOS_WRONG_SEM_BIN_ID;
-}
+	// get thread descriptor by id
+	fos_thread_t *thr = FOS_GetThreadDesc(p, id);
+	if(thr == NULL)
+		return FOS__FAIL;
 
+	fos_ret_t ret = FOS_ThreadSleepUntilUs(thr, last_wake_us, period_us);
+	if(thr->hot->state != FOS__THREAD_BLOCKED)       // overrun or the time is now: the thread goes on running
+		return ret;
 
-// get semaphore identifier by its descriptor
-static uint8_t FOS_GetSemaphoreBinaryId(fos_t *p, fos_semaphore_binary_t *semb)
-{
-	if(p == NULL)
-		return FOS_WRONG_SEM_BIN_ID;
+	FOS_Schedule_UpdThread(&p->sheduler, id, thr);    // remove the thread from the ready queue
+	Private_FOS_UpdThreadTimer(p, id);                // set the wake-up timer
 
-	for(uint8_t i = 0; i < FOS_SEM_BIN_CNT; i++)
-		if(p->var.semb_desc_list[i] == semb)
-			return i;
+	FOS_System_GoToKernelMode(FOS__DISABLE);          // switch to kernel mode
 
-	return FOS_WRONG_SEM_BIN_ID;
+	return ret;
 }
 
 
-// get binary semaphore descriptor by its identifier
-static fos_semaphore_binary_t* FOS_GetSemaphoreBinaryDesc(fos_t *p, uint8_t id)
+// get monotonic kernel time, us
+fos_time_t FOS_GetTimeUs()
 {
-	if(p == NULL)
-		return NULL;
-
-	if(id > p->var.semb_max_ind)
-		return NULL;
-
-	return p->var.semb_desc_list[id];
+	return FOS_Time_GetUs();
 }
 
 
-// register binary semaphore
-fos_ret_t FOS_SemBinaryReg(fos_t *p, fos_semaphore_binary_t *semb)
+// set blocking to thread with identifier
+fos_ret_t FOS_LockId(fos_t *p, fos_id_t id, uint32_t lock)
 {
-	if((p == NULL) || (semb == NULL))
-		return FOS__FAIL;
-
-	uint8_t ind = 0;
-	fos_var_t *v = &p->var;
-
-	// search for duplicated semaphores
-	if(FOS_GetSemaphoreBinaryId(p, semb) != FOS_WRONG_SEM_BIN_ID)
-		return FOS__FAIL;
-
-	// search for available section
-	ind = FOS_GetSemaphoreBinaryId(p, NULL);
-	if(ind == FOS_WRONG_SEM_BIN_ID)
+	if(p == NULL)
 		return FOS__FAIL;
 
-	// assign unique user-defined descriptor to the semaphore
-	if(FOS_SemaphoreBinary_SetUserDesc(semb, Private_FOS_GenUserDesc(p)) != FOS__OK)
+	// get thread descriptor by identifier
+	fos_thread_t *thr = FOS_GetThreadDesc(p, id);
+	if(thr == NULL)
 		return FOS__FAIL;
 
-	v->semb_desc_list[ind] = semb;        // insert the pointer into the available section
+	FOS_ThreadLock(thr, lock);       // block the thread
+	FOS_Schedule_UpdThread(&p->sheduler, id, thr);    // remove the thread from the ready queue
+	Private_FOS_UpdThreadTimer(p, id);                // blocked thread has no wake-up timer
 
-	Private_FOS_UpdSemBinaryMaxInd(p);    // update the maximum index
+	if(id == p->var.current_thr)                 // if current thread is being blocked
+		FOS_System_GoToKernelMode(FOS__DISABLE);     // switch to kernel mode
 
 	return FOS__OK;
 }
 
 
-// delete binary semaphore
-fos_ret_t FOS_SemBinaryDelete(fos_t *p, user_desc_t semb)
+// unblock thread with identifier
+fos_ret_t FOS_UnlockId(fos_t *p, fos_id_t id, uint32_t lock)
 {
-	if((p == NULL) || (semb == FOS_WRONG_USER_DESC))
-		return FOS__FAIL;
-
-	uint8_t id = FOS_GetUdSemaphoreBinaryId(p, semb);
-	if(id == FOS_WRONG_SEM_BIN_ID)
-		return FOS__FAIL;
-
-	fos_semaphore_binary_t *ptr = FOS_GetSemaphoreBinaryDesc(p, id);
-	if(ptr == NULL)
+	if(p == NULL)
 		return FOS__FAIL;
 
-	if(Private_FOS_AddOjectToDelList(p, (uint32_t)ptr, FOS_KERNEL_HEAP_ID) != FOS__OK)
+	// get thread descriptor by id
+	fos_thread_t *thr = FOS_GetThreadDesc(p, id);
+	if(thr == NULL)
 		return FOS__FAIL;
 
-	FOS_SemaphoreBinary_UnlockAll(ptr);
-	p->var.semb_desc_list[id] = NULL;
+	FOS_ThreadUnlock(thr, lock);
+	FOS_Schedule_UpdThread(&p->sheduler, id, thr);    // unblocked thread is ready right away
+	Private_FOS_UpdThreadTimer(p, id);                // and needs no wake-up timer
 
-	Private_FOS_UpdSemBinaryMaxInd(p);    // update the maximum index
+	/*
+	 * Reschedule at once if the unblocked thread has a higher priority than the current one
+	 * or if the kernel is sleeping in tickless idle mode
+	 */
+	if(Private_FOS_IsPreemptNeeded(p, thr) || p->var.tickless_sw)
+		FOS_System_Preempt();
 
 	return FOS__OK;
 }
 
 
-// acquire binary semaphore
-fos_ret_t FOS_SemBinaryTake(fos_t *p, user_desc_t semb)
+// complete the current job of the periodic thread and wait for the next release
+// FOS__FAIL - the thread is not periodic or the job missed its deadline
+fos_ret_t FOS_WaitNextPeriod(fos_t *p)
 {
-	if((p == NULL) || (semb == FOS_WRONG_USER_DESC))
+	if(p == NULL)
 		return FOS__FAIL;
 
-	uint8_t id = FOS_GetUdSemaphoreBinaryId(p, semb);
-	if(id == FOS_WRONG_SEM_BIN_ID)
+	fos_id_t id = p->var.current_thr;
+
+	// get thread descriptor by id
+	fos_thread_t *thr = FOS_GetThreadDesc(p, id);
+	if(thr == NULL)
 		return FOS__FAIL;
 
-	fos_semaphore_binary_t *ptr = FOS_GetSemaphoreBinaryDesc(p, id);
-	if(ptr == NULL)
+	if(!FOS_Thread_IsPeriodic(thr))
 		return FOS__FAIL;
 
-	return FOS_SemaphoreBinary_Take(ptr, p->var.current_thr);
+	fos_ret_t ret = FOS_Thread_CompleteJob(thr);     // the thread sleeps until the next release if it has not come yet
+
+	FOS_Schedule_UpdThread(&p->sheduler, id, thr);    // new deadline or sleeping
+	Private_FOS_UpdThreadTimer(p, id);                // set the release timer
+
+	FOS_System_GoToKernelMode(FOS__DISABLE);          // switch to kernel mode
+
+	return ret;
 }
 
 
-// get taking status of binary semaphore
-// FOS__OK - normal taking, FOS__FAIL - taking with timeout
-fos_ret_t FOS_SemBinaryTakeStat(fos_t *p, user_desc_t semb)
+// set own priority of the thread with identifier
+// FOS__FAIL - the thread is not found, priority is wrong or the thread is run-to-completion
+fos_ret_t FOS_SetPriorityId(fos_t *p, fos_id_t id, uint8_t priority)
 {
-	if((p == NULL) || (semb == FOS_WRONG_USER_DESC))
+	if((p == NULL) || (priority >= FOS_PRIORITY_CNT))
 		return FOS__FAIL;
 
-	uint8_t id = FOS_GetUdSemaphoreBinaryId(p, semb);
-	if(id == FOS_WRONG_SEM_BIN_ID)
+	// get thread descriptor by id
+	fos_thread_t *thr = FOS_GetThreadDesc(p, id);
+	if(thr == NULL)
 		return FOS__FAIL;
 
-	fos_semaphore_binary_t *ptr = FOS_GetSemaphoreBinaryDesc(p, id);
-	if(ptr == NULL)
+	// run-to-completion threads share the stack of their priority
+	if(FOS_Thread_IsRtc(thr))
 		return FOS__FAIL;
 
-	return FOS_SemaphoreBinary_TakeStat(ptr);
+	thr->var.base_priotity = priority;
+
+	// the priority inherited from the mutexes is kept until they are unlocked
+	if(Private_FOS_UpdThreadPriority(p, id, thr) == FOS__DISABLE)
+		return FOS__OK;
+
+	// the owner of the mutex the thread waits for gets its new priority
+	if(thr->var.mutex_wait != FOS_WRONG_MUTEX_ID)
+		Private_FOS_InheritPriority(p, thr->var.mutex_wait);
+
+	// reschedule if the thread outranks the current one now or the current thread has lowered its priority
+	if((id == p->var.current_thr) || Private_FOS_IsPreemptNeeded(p, thr))
+		FOS_System_Preempt();
+
+	return FOS__OK;
 }
 
 
-// release binary semaphore
-fos_ret_t FOS_SemBinaryGive(fos_t *p, user_desc_t semb)
+// suspend the thread with identifier until it is resumed
+fos_ret_t FOS_SuspendId(fos_t *p, fos_id_t id)
 {
-	if((p == NULL) || (semb == FOS_WRONG_USER_DESC))
+	if(p == NULL)
 		return FOS__FAIL;
 
-	uint8_t id = FOS_GetUdSemaphoreBinaryId(p, semb);
-	if(id == FOS_WRONG_SEM_BIN_ID)
+	// get thread descriptor by id
+	fos_thread_t *thr = FOS_GetThreadDesc(p, id);
+	if(thr == NULL)
 		return FOS__FAIL;
 
-	fos_semaphore_binary_t *ptr = FOS_GetSemaphoreBinaryDesc(p, id);
-	if(ptr == NULL)
+	if(FOS_Thread_Suspend(thr) != FOS__OK)
 		return FOS__FAIL;
 
-	return FOS_SemaphoreBinary_Give(ptr);
+	FOS_Schedule_UpdThread(&p->sheduler, id, thr);    // remove the thread from the ready queue
+	Private_FOS_UpdThreadTimer(p, id);                // suspended thread is not woken up by the timer
+
+	if(id == p->var.current_thr)                      // if current thread is being suspended
+		FOS_System_GoToKernelMode(FOS__DISABLE);      // switch to kernel mode
+
+	return FOS__OK;
 }
 
 
-// set binary semaphore timeout
-fos_ret_t FOS_SemBinarySetTimeout(fos_t *p, user_desc_t semb, uint32_t timeout_ms)
+// resume the suspended thread with identifier
+fos_ret_t FOS_ResumeId(fos_t *p, fos_id_t id)
 {
-	if((p == NULL) || (semb == FOS_WRONG_USER_DESC))
+	if(p == NULL)
 		return FOS__FAIL;
 
-	uint8_t id = FOS_GetUdSemaphoreBinaryId(p, semb);
-	if(id == FOS_WRONG_SEM_BIN_ID)
+	// get thread descriptor by id
+	fos_thread_t *thr = FOS_GetThreadDesc(p, id);
+	if(thr == NULL)
 		return FOS__FAIL;
 
-	fos_semaphore_binary_t *ptr = FOS_GetSemaphoreBinaryDesc(p, id);
-	if(ptr == NULL)
+	if(FOS_Thread_Resume(thr) != FOS__OK)
 		return FOS__FAIL;
 
-	return FOS_SemaphoreBinary_SetTimeout(ptr, timeout_ms);
+	FOS_Schedule_UpdThread(&p->sheduler, id, thr);    // resumed thread is ready right away
+	Private_FOS_UpdThreadTimer(p, id);                // or goes on sleeping or waiting
+
+	// reschedule at once as it is done for unblocked threads
+	if(Private_FOS_IsPreemptNeeded(p, thr) || p->var.tickless_sw)
+		FOS_System_Preempt();
+
+	return FOS__OK;
 }
 
 
-// get writer object identifier by its descriptor
-static uint8_t FOS_GetFWriterId(fos_t *p, fwriter_t *fw)
+// set time slice of the thread with identifier
+fos_ret_t FOS_SetQuantumId(fos_t *p, fos_id_t id, uint32_t quantum_us)
 {
 	if(p == NULL)
-		return FOS_WRONG_FWRITER_ID;
+		return FOS__FAIL;
 
-	for(uint8_t i = 0; i < FOS_FWRITER_CNT; i++)
-		if(p->var.fwriter_desc_list[i] == fw)
-			return i;
+	// get thread descriptor by id
+	fos_thread_t *thr = FOS_GetThreadDesc(p, id);
+	if(thr == NULL)
+		return FOS__FAIL;
 
-	return FOS_WRONG_FWRITER_ID;
+	// the new time slice is applied at the next switch to the thread
+	return FOS_Thread_SetQuantum(thr, quantum_us);
 }
 
 
-// get writer object descriptor by its identifier
-fwriter_t* FOS_GetFWriterDesc(fos_t *p, uint8_t id)
+// set CPU budget of the thread with identifier: budget_us in each period_ms (budget_us = 0 - unlimited)
+fos_ret_t FOS_SetBudgetId(fos_t *p, fos_id_t id, uint32_t budget_us, uint32_t period_ms)
 {
 	if(p == NULL)
-		return NULL;
+		return FOS__FAIL;
 
-	if(id > p->var.fwriter_max_id)
-		return NULL;
+	// get thread descriptor by id
+	fos_thread_t *thr = FOS_GetThreadDesc(p, id);
+	if(thr == NULL)
+		return FOS__FAIL;
 
-	return p->var.fwriter_desc_list[id];
+	return FOS_Thread_SetBudget(thr, budget_us, period_ms);
 }
 
 
-// register writer object
-fos_ret_t FOS_FWriterReg(fos_t *p, fwriter_t *fw)
+// set CPU reservation of thread group (1..FOS_GROUP_CNT): reserve_us guaranteed and at most budget_us in each period_ms
+fos_ret_t FOS_SetGroup(fos_t *p, uint8_t group, uint32_t reserve_us, uint32_t budget_us, uint32_t period_ms)
 {
-	if((p == NULL) || (fw == NULL))
+	if((p == NULL) || (group == FOS_NO_GROUP) || (group > FOS_GROUP_CNT))
 		return FOS__FAIL;
 
-	uint8_t ind = 0;
-	fos_var_t *v = &p->var;
-
-	// search for duplicated writer objects
-	if(FOS_GetFWriterId(p, fw) != FOS_WRONG_FWRITER_ID)
+	if(FOS_Group_Set(&p->var.group[group - 1], reserve_us, budget_us, period_ms) != FOS__OK)
 		return FOS__FAIL;
 
-	// search for available section
-	ind = FOS_GetFWriterId(p, NULL);
-	if(ind == FOS_WRONG_FWRITER_ID)
-		return FOS__FAIL;
-
-	v->fwriter_desc_list[ind] = fw;        // insert the pointer into the available section
-
-	Private_FOS_UpdFWriterMaxInd(p);       // update the maximum index
+	p->var.group_sw = FOS__ENABLE;
 
 	return FOS__OK;
 }
 
 
-// identify error
-void FOS_ErrorSet(fos_t *p, fos_err_t *err)
-{
-	if((p == NULL) || (err == NULL))
-		return;
-
-	memcpy((void*)&p->var.error, err, sizeof(fos_err_t));
-
-	if(err->ext_str_ptr != NULL)
-		strncpy((void*)p->var.error.str, err->ext_str_ptr, FOS_MAX_STR_ERR_LEN);
-}
-
-
-// get semaphore identifier by user defined descriptor
-static uint8_t FOS_GetUdSemaphoreCntId(fos_t *p, user_desc_t user_desc)
+// move the thread with identifier to the group (FOS_NO_GROUP - out of groups)
+fos_ret_t FOS_SetThreadGroupId(fos_t *p, fos_id_t id, uint8_t group)
 {
-	if((p == NULL) || (user_desc == FOS_WRONG_USER_DESC))
-		return FOS_WRONG_SEM_CNT_ID;
-
-	for(uint8_t i = 0; i <= p->var.semc_max_ind; i++)
-		if(p->var.semc_desc_list[i])
-			if(p->var.semc_desc_list[i]->user_desc == user_desc)
-				return i;
-
-	return FOS_WRONG_SEM_CNT_ID;
-}
-
+	if((p == NULL) || (group > FOS_GROUP_CNT))
+		return FOS__FAIL;
 
-// get semaphore identifier by its descriptor
-static uint8_t FOS_GetSemaphoreCntId(fos_t *p, fos_semaphore_cnt_t *semc)
-{
-	if(p == NULL)
-		return FOS_WRONG_SEM_CNT_ID;
+	// get thread descriptor by id
+	fos_thread_t *thr = FOS_GetThreadDesc(p, id);
+	if(thr == NULL)
+		return FOS__FAIL;
 
-	for(uint8_t i = 0; i < FOS_SEM_COUNTING_CNT; i++)
-		if(p->var.semc_desc_list[i] == semc)
-			return i;
+	thr->set.group = group;    // the run time is charged to the group from the next switch
 
-	return FOS_WRONG_SEM_CNT_ID;
+	return FOS__OK;
 }
 
 
-// get semaphore descriptor by its identifier
-static fos_semaphore_cnt_t* FOS_GetSemaphoreCntDesc(fos_t *p, uint8_t id)
+// start time-triggered cyclic executive with the table
+// FOS__FAIL - the table is wrong or the thread of a slot is not found
+fos_ret_t FOS_TtStart(fos_t *p, const fos_tt_table_t *table)
 {
 	if(p == NULL)
-		return NULL;
-
-	if(id > p->var.semc_max_ind)
-		return NULL;
-
-	return p->var.semc_desc_list[id];
-}
-
-
-// register counting semaphore
-fos_ret_t FOS_SemCntReg(fos_t *p, fos_semaphore_cnt_t *semc)
-{
-	if((p == NULL) || (semc == NULL))
 		return FOS__FAIL;
 
-	uint8_t ind = 0;
-	fos_var_t *v = &p->var;
-
-	// search for duplicated semaphores
-	if(FOS_GetSemaphoreCntId(p, semc) != FOS_WRONG_SEM_CNT_ID)
-		return FOS__FAIL;
+	FOS_TtStop(p);    // the threads of the previous table are scheduled as usual
 
-	// search for available section
-	ind = FOS_GetSemaphoreCntId(p, NULL);
-	if(ind == FOS_WRONG_SEM_CNT_ID)
+	fos_tt_t *tt = &p->var.tt;
+	if(FOS_TT_Start(tt, table) != FOS__OK)
 		return FOS__FAIL;
 
-	// assign unique user-defined descriptor to the semaphore
-	if(FOS_SemaphoreCnt_SetUserDesc(semc, Private_FOS_GenUserDesc(p)) != FOS__OK)
-		return FOS__FAIL;
+	// the slots are bound to the threads by name once, so the dispatch needs no search
+	for(uint16_t i = 0; i < table->slot_cnt; i++)
+	{
+		tt->slot_thr[i] = Private_FOS_GetNameThreadId(p, table->slot[i].name);
+		if(tt->slot_thr[i] == FOS_WRONG_THREAD_ID)
+		{
+			FOS_TT_Stop(tt);
+			return FOS__FAIL;
+		}
+	}
 
-	v->semc_desc_list[ind] = semc;        // insert the pointer into the available section
+	// the threads of the table run in their slots only
+	for(uint16_t i = 0; i < table->slot_cnt; i++)
+		FOS_LockId(p, tt->slot_thr[i], FOS_LOCK_TT_FLAG);
 
-	Private_FOS_UpdSemCntMaxInd(p);       // update the maximum index
+	FOS_System_Preempt();    // set the main timer to the first slot boundary
 
 	return FOS__OK;
 }
 
 
-// delete counting semaphore
-fos_ret_t FOS_SemCntDelete(fos_t *p, user_desc_t semc)
+// stop time-triggered cyclic executive, the threads of the table are scheduled as usual
+fos_ret_t FOS_TtStop(fos_t *p)
 {
-	if((p == NULL) || (semc == FOS_WRONG_USER_DESC))
-		return FOS__FAIL;
-
-	uint8_t id = FOS_GetUdSemaphoreCntId(p, semc);
-	if(id == FOS_WRONG_SEM_CNT_ID)
-		return FOS__FAIL;
-
-	fos_semaphore_cnt_t *ptr = FOS_GetSemaphoreCntDesc(p, id);
-	if(ptr == NULL)
+	if(p == NULL)
 		return FOS__FAIL;
 
-	if(Private_FOS_AddOjectToDelList(p, (uint32_t)ptr, FOS_KERNEL_HEAP_ID) != FOS__OK)
-		return FOS__FAIL;
+	fos_tt_t *tt = &p->var.tt;
+	if(FOS_TT_IsRunning(tt) == FOS__DISABLE)
+		return FOS__OK;
 
-	FOS_SemaphoreCnt_UnlockAll(ptr);
-	p->var.semc_desc_list[id] = NULL;
+	uint16_t slot_cnt = tt->table->slot_cnt;
+	FOS_TT_Stop(tt);
 
-	Private_FOS_UpdSemCntMaxInd(p);    // update the maximum index
+	for(uint16_t i = 0; i < slot_cnt; i++)
+		if(tt->slot_thr[i] != FOS_WRONG_THREAD_ID)
+			FOS_UnlockId(p, tt->slot_thr[i], FOS_LOCK_TT_FLAG);
 
 	return FOS__OK;
 }
 
 
-// acquire counting semaphore
-fos_ret_t FOS_SemCntTake(fos_t *p, user_desc_t semc)
+// complete the job of the current thread and wait for its next slot of the time-triggered table
+// FOS__FAIL - the thread has no slots
+fos_ret_t FOS_TtWaitNextSlot(fos_t *p)
 {
-	if((p == NULL) || (semc == FOS_WRONG_USER_DESC))
+	if(p == NULL)
 		return FOS__FAIL;
 
-	uint8_t id = FOS_GetUdSemaphoreCntId(p, semc);
-	if(id == FOS_WRONG_SEM_CNT_ID)
-		return FOS__FAIL;
+	fos_id_t id = p->var.current_thr;
 
-	fos_semaphore_cnt_t *ptr = FOS_GetSemaphoreCntDesc(p, id);
-	if(ptr == NULL)
+	if(FOS_TT_IsSlotThread(&p->var.tt, id) == FOS__DISABLE)
 		return FOS__FAIL;
 
-	return FOS_SemaphoreCnt_Take(ptr, p->var.current_thr);
+	return FOS_LockId(p, id, FOS_LOCK_TT_FLAG);    // the thread is released at the start of its next slot
 }
 
 
-// get status of acquire counting semaphore
-fos_ret_t FOS_SemCntTakeStat(fos_t *p, user_desc_t semc)
+// get shared stack of run-to-completion threads with priority
+// FOS__FAIL - the stack is not allocated yet
+fos_ret_t FOS_GetRtcStack(fos_t *p, uint8_t priority, uint32_t *base_sp, uint32_t *stack_size)
 {
-	if((p == NULL) || (semc == FOS_WRONG_USER_DESC))
+	if((p == NULL) || (base_sp == NULL) || (stack_size == NULL))
 		return FOS__FAIL;
 
-	uint8_t id = FOS_GetUdSemaphoreCntId(p, semc);
-	if(id == FOS_WRONG_SEM_CNT_ID)
-		return FOS__FAIL;
+	if(priority >= FOS_PRIORITY_CNT)
+		priority = FOS_PRIORITY_CNT - 1;
 
-	fos_semaphore_cnt_t *ptr = FOS_GetSemaphoreCntDesc(p, id);
-	if(ptr == NULL)
+	volatile fos_rtc_stack_t *st = &p->var.rtc_stack[priority];
+	if(st->base_sp == 0)
 		return FOS__FAIL;
 
-	return FOS_SemaphoreCnt_TakeStat(ptr);
+	*base_sp    = st->base_sp;
+	*stack_size = st->stack_size;
+
+	return FOS__OK;
 }
 
 
-// release counting semaphore
-fos_ret_t FOS_SemCntGive(fos_t *p, user_desc_t semc)
+// set shared stack of run-to-completion threads with priority
+fos_ret_t FOS_SetRtcStack(fos_t *p, uint8_t priority, uint32_t base_sp, uint32_t stack_size)
 {
-	if((p == NULL) || (semc == FOS_WRONG_USER_DESC))
+	if((p == NULL) || (base_sp == 0))
 		return FOS__FAIL;
 
-	uint8_t id = FOS_GetUdSemaphoreCntId(p, semc);
-	if(id == FOS_WRONG_SEM_CNT_ID)
-		return FOS__FAIL;
+	if(priority >= FOS_PRIORITY_CNT)
+		priority = FOS_PRIORITY_CNT - 1;
 
-	fos_semaphore_cnt_t *ptr = FOS_GetSemaphoreCntDesc(p, id);
-	if(ptr == NULL)
+	volatile fos_rtc_stack_t *st = &p->var.rtc_stack[priority];
+	if(st->base_sp)                                   // the stack is allocated once
 		return FOS__FAIL;
 
-	return FOS_SemaphoreCnt_Give(ptr);
+	st->base_sp    = base_sp;
+	st->stack_size = stack_size;
+
+	return FOS__OK;
 }
 
 
-// set counting semaphore timeout
-fos_ret_t FOS_SemCntSetTimeout(fos_t *p, user_desc_t semc, uint32_t timeout_ms)
+// complete the job of the current run-to-completion thread
+fos_ret_t FOS_RtcJobComplete(fos_t *p)
 {
-	if((p == NULL) || (semc == FOS_WRONG_USER_DESC))
+	if(p == NULL)
 		return FOS__FAIL;
 
-	uint8_t id = FOS_GetUdSemaphoreCntId(p, semc);
-	if(id == FOS_WRONG_SEM_CNT_ID)
-		return FOS__FAIL;
+	fos_id_t id = p->var.current_thr;
 
-	fos_semaphore_cnt_t *ptr = FOS_GetSemaphoreCntDesc(p, id);
-	if(ptr == NULL)
+	// get thread descriptor by id
+	fos_thread_t *thr = FOS_GetThreadDesc(p, id);
+	if(FOS_Thread_CompleteRtcJob(thr) != FOS__OK)
 		return FOS__FAIL;
 
-	return FOS_SemaphoreCnt_SetTimeout(ptr, timeout_ms);
+	FOS_Schedule_UpdThread(&p->sheduler, id, thr);    // remove the thread from the ready queue
+
+	// the scheduler passes the shared stack on after the context of the thread is saved
+	FOS_System_GoToKernelMode(FOS__DISABLE);
+
+	return FOS__OK;
 }
 
 
-// get queue32 identifier by its descriptor
-static uint8_t FOS_GetQueue32Id(fos_t *p, fos_queue32_t *que)
+// get semaphore identifier by user defined descriptor
+static fos_id_t FOS_GetUdSemaphoreBinaryId(fos_t *p, user_desc_t user_desc)
 {
-	if(p == NULL)
-		return FOS_WRONG_QUE_32_ID;
+	if((p == NULL) || (user_desc == FOS_WRONG_USER_DESC))
+		return FOS_WRONG_SEM_BIN_ID;
 
-	for(uint8_t i = 0; i < FOS_SEM_QUEUE_32_CNT; i++)
-		if(p->var.queue32_desc_list[i] == que)
-			return i;
+	// the slot is taken from the descriptor, the descriptor of the object in the slot must match it
+	fos_id_t id = FOS_USER_DESC_SLOT(user_desc);
+	fos_semaphore_binary_t *obj = FOS_GetSemaphoreBinaryDesc(p, id);
+	if((obj == NULL) || (obj->user_desc != user_desc))
+		return FOS_WRONG_SEM_BIN_ID;
 
-	return FOS_WRONG_QUE_32_ID;
+	return id;
 }
 
 
-// get queue32 identifier by user defined descriptor
-static uint8_t FOS_GetUdQueue32Id(fos_t *p, user_desc_t user_desc)
+// get semaphore identifier by its descriptor
+static fos_id_t FOS_GetSemaphoreBinaryId(fos_t *p, fos_semaphore_binary_t *semb)
 {
-	if((p == NULL) || (user_desc == FOS_WRONG_USER_DESC))
-		return FOS_WRONG_QUE_32_ID;
+	if((p == NULL) || (semb == NULL))
+		return FOS_WRONG_SEM_BIN_ID;
 
-	for(uint8_t i = 0; i <= p->var.queue32_max_ind; i++)
-		if(p->var.queue32_desc_list[i])
-			if(p->var.queue32_desc_list[i]->user_desc == user_desc)
-				return i;
+	// a registered semaphore is found in the slot of its user descriptor
+	fos_id_t id = FOS_USER_DESC_SLOT(semb->user_desc);
+	if(FOS_GetSemaphoreBinaryDesc(p, id) != semb)
+		return FOS_WRONG_SEM_BIN_ID;
 
-	return FOS_WRONG_QUE_32_ID;
+	return id;
 }
 
 
-// get queue32 descriptor by its identifier
-static fos_queue32_t* FOS_GetQueue32Desc(fos_t *p, uint8_t id)
+// get binary semaphore descriptor by its identifier
+static fos_semaphore_binary_t* FOS_GetSemaphoreBinaryDesc(fos_t *p, fos_id_t id)
 {
 	if(p == NULL)
 		return NULL;
 
-	if(id > p->var.queue32_max_ind)
+	if(id > p->var.semb_max_ind)
 		return NULL;
 
-	return p->var.queue32_desc_list[id];
+	return p->var.semb_desc_list[id];
 }
 
 
-// register queue32
-fos_ret_t FOS_Queue32Reg(fos_t *p, fos_queue32_t *que)
+// register binary semaphore
+fos_ret_t FOS_SemBinaryReg(fos_t *p, fos_semaphore_binary_t *semb)
 {
-	if((p == NULL) || (que == NULL))
+	if((p == NULL) || (semb == NULL))
 		return FOS__FAIL;
 
-	uint8_t ind = 0;
+	fos_id_t ind = 0;
 	fos_var_t *v = &p->var;
 
-	// search for duplicated
-	if(FOS_GetQueue32Id(p, que) != FOS_WRONG_QUE_32_ID)
-		return FOS__FAIL;
-
-	// search for available section
-	ind = FOS_GetQueue32Id(p, NULL);
-	if(ind == FOS_WRONG_QUE_32_ID)
+	// search for duplicated semaphores
+	if(FOS_GetSemaphoreBinaryId(p, semb) != FOS_WRONG_SEM_BIN_ID)
 		return FOS__FAIL;
 
-	// assign unique user-defined descriptor to the queue32
-	if(FOS_Queue32_SetUserDesc(que, Private_FOS_GenUserDesc(p)) != FOS__OK)
+	// take free slot
+	ind = FOS_IdMap_Alloc(&v->semb_idmap);
+	if(ind == FOS_EMPTY_ID)
 		return FOS__FAIL;
 
-	v->queue32_desc_list[ind] = que;      // insert the pointer into the available section
-
-	Private_FOS_UpdQueue32MaxInd(p);      // update the maximum index
-
-	return FOS__OK;
-}
-
-
-// join counting semaphore to queue32
-fos_ret_t FOS_Queue32JoinToSemCnt(fos_t *p, fos_queue32_t *que, user_desc_t semc)
-{
-	if((p == NULL) || (que == NULL) || (semc == FOS_WRONG_USER_DESC))
+	// assign unique user-defined descriptor to the semaphore
+	if(FOS_SemaphoreBinary_SetUserDesc(semb, Private_FOS_MakeUserDesc(&v->semb_idmap, ind)) != FOS__OK)
+	{
+		FOS_IdMap_Free(&v->semb_idmap, ind);
 		return FOS__FAIL;
+	}
 
-	uint8_t id = FOS_GetUdSemaphoreCntId(p, semc);
-	if(id == FOS_WRONG_SEM_CNT_ID)
-		return FOS__FAIL;
+	v->semb_desc_list[ind] = semb;        // insert the pointer into the available section
+	FOS_Lock_Bind(&semb->fos_lock, v->lock_node);
 
-	FOS_Queue32_SetSemaphorePtr(que, FOS_GetSemaphoreCntDesc(p, id));
+	Private_FOS_UpdSemBinaryMaxInd(p);    // update the maximum index
 
 	return FOS__OK;
 }
 
 
-// delete queue32
-fos_ret_t FOS_Queue32Delete(fos_t *p, user_desc_t que)
+// delete binary semaphore
+fos_ret_t FOS_SemBinaryDelete(fos_t *p, user_desc_t semb)
 {
-	if((p == NULL) || (que == FOS_WRONG_USER_DESC))
+	if((p == NULL) || (semb == FOS_WRONG_USER_DESC))
 		return FOS__FAIL;
 
-	uint8_t id = FOS_GetUdQueue32Id(p, que);
-	if(id == FOS_WRONG_QUE_32_ID)
+	fos_id_t id = FOS_GetUdSemaphoreBinaryId(p, semb);
+	if(id == FOS_WRONG_SEM_BIN_ID)
 		return FOS__FAIL;
 
-	fos_queue32_t *ptr = FOS_GetQueue32Desc(p, id);
+	fos_semaphore_binary_t *ptr = FOS_GetSemaphoreBinaryDesc(p, id);
 	if(ptr == NULL)
 		return FOS__FAIL;
 
 	if(Private_FOS_AddOjectToDelList(p, (uint32_t)ptr, FOS_KERNEL_HEAP_ID) != FOS__OK)
 		return FOS__FAIL;
 
-	if(Private_FOS_AddOjectToDelList(p, (uint32_t)ptr->msg.buf_ptr, FOS_THREADS_HEAP_ID) != FOS__OK)
-		return FOS__FAIL;
-
-	if(ptr->semc_ptr)
-		FOS_SemCntDelete(p, ptr->semc_ptr->user_desc);
-
-	p->var.queue32_desc_list[id] = NULL;
+	FOS_SemaphoreBinary_UnlockAll(ptr);
+	p->var.semb_desc_list[id] = NULL;
+	FOS_IdMap_Free(&p->var.semb_idmap, id);
 
-	Private_FOS_UpdQueue32MaxInd(p);   // update the maximum index
+	Private_FOS_UpdSemBinaryMaxInd(p);    // update the maximum index
 
 	return FOS__OK;
 }
 
 
-// ask data
-fos_ret_t FOS_Queue32AskData(fos_t *p, user_desc_t que, fos_queue_sw_t blocking_mode_sw)
+// acquire binary semaphore
+fos_ret_t FOS_SemBinaryTake(fos_t *p, user_desc_t semb)
 {
-	if((p == NULL) || (que == FOS_WRONG_USER_DESC))
+	if((p == NULL) || (semb == FOS_WRONG_USER_DESC))
 		return FOS__FAIL;
 
-	uint8_t id = FOS_GetUdQueue32Id(p, que);
-	if(id == FOS_WRONG_QUE_32_ID)
+	fos_id_t id = FOS_GetUdSemaphoreBinaryId(p, semb);
+	if(id == FOS_WRONG_SEM_BIN_ID)
 		return FOS__FAIL;
 
-	fos_queue32_t *ptr = FOS_GetQueue32Desc(p, id);
+	fos_semaphore_binary_t *ptr = FOS_GetSemaphoreBinaryDesc(p, id);
 	if(ptr == NULL)
 		return FOS__FAIL;
 
-	uint8_t block_thr_id = FOS_SPECIAL_ID;
+	fos_ret_t ret = FOS_SemaphoreBinary_Take(ptr, p->var.current_thr);
 
-	if(blocking_mode_sw == FOS_QUEUE_SW__BLOCK)
-		if(FOS_System_GetWorkMode() == FOS__USER_WORK_MODE)
-			block_thr_id = p->var.current_thr;
+#if defined(FOS_USE_DIRECT_SWITCH)
+	uint32_t ts;
+	Private_FOS_PlanSemTimeout(p, FOS_SemaphoreBinary_GetTimeoutTs(ptr, &ts), ts);
+#endif
 
-	return FOS_Queue32_AskData(ptr, block_thr_id);
+	return ret;
 }
 
 
-// read data
-// one must ask data before read every times
-fos_ret_t FOS_Queue32ReadData(fos_t *p, user_desc_t que, uint32_t* data_ptr)
+// get taking status of binary semaphore
+// FOS__OK - normal taking, FOS__FAIL - taking with timeout
+fos_ret_t FOS_SemBinaryTakeStat(fos_t *p, user_desc_t semb)
 {
-	if((p == NULL) || (que == FOS_WRONG_USER_DESC) || (data_ptr == NULL))
+	if((p == NULL) || (semb == FOS_WRONG_USER_DESC))
 		return FOS__FAIL;
 
-	uint8_t id = FOS_GetUdQueue32Id(p, que);
-	if(id == FOS_WRONG_QUE_32_ID)
+	fos_id_t id = FOS_GetUdSemaphoreBinaryId(p, semb);
+	if(id == FOS_WRONG_SEM_BIN_ID)
 		return FOS__FAIL;
 
-	fos_queue32_t *ptr = FOS_GetQueue32Desc(p, id);
+	fos_semaphore_binary_t *ptr = FOS_GetSemaphoreBinaryDesc(p, id);
 	if(ptr == NULL)
 		return FOS__FAIL;
 
-	return FOS_Queue32_ReadData(ptr, data_ptr);
+	return FOS_SemaphoreBinary_TakeStat(ptr);
 }
 
 
-// write data
-fos_ret_t FOS_Queue32WriteData(fos_t *p, user_desc_t que, uint32_t data)
+// release binary semaphore
+fos_ret_t FOS_SemBinaryGive(fos_t *p, user_desc_t semb)
 {
-	if((p == NULL) || (que == FOS_WRONG_USER_DESC))
+	if((p == NULL) || (semb == FOS_WRONG_USER_DESC))
 		return FOS__FAIL;
 
-	uint8_t id = FOS_GetUdQueue32Id(p, que);
-	if(id == FOS_WRONG_QUE_32_ID)
+	fos_id_t id = FOS_GetUdSemaphoreBinaryId(p, semb);
+	if(id == FOS_WRONG_SEM_BIN_ID)
 		return FOS__FAIL;
 
-	fos_queue32_t *ptr = FOS_GetQueue32Desc(p, id);
+	fos_semaphore_binary_t *ptr = FOS_GetSemaphoreBinaryDesc(p, id);
 	if(ptr == NULL)
 		return FOS__FAIL;
 
-	return FOS_Queue32_WriteData(ptr, data);
+	return FOS_SemaphoreBinary_Give(ptr);
 }
 
 
-// get the system stack debug info
-fos_thread_dbg_t* FOS_GetSysStackDbgInfo(fos_t *p)
+// release binary semaphore and hand the rest of the time slice to the unblocked thread
+fos_ret_t FOS_SemBinaryGiveSwitch(fos_t *p, user_desc_t semb)
 {
 	if(p == NULL)
-		return NULL;
+		return FOS__FAIL;
 
-	return &p->sys_stack_dbg;
-}
+	if(semb == FOS_WRONG_USER_DESC)
+		return FOS__FAIL;
 
+	fos_id_t id = FOS_GetUdSemaphoreBinaryId(p, semb);
+	if(id == FOS_WRONG_SEM_BIN_ID)
+		return FOS__FAIL;
 
-// get the scheduler debug info
-fos_scheduler_dbg_t* FOS_GetSchedulerDbgInfo(fos_t *p)
-{
-	if(p == NULL)
-		return NULL;
+	// the thread unblocked by this give, a give from an interrupt cannot replace it
+	fos_id_t thr_id;
+	fos_ret_t ret = FOS_SemaphoreBinary_GiveId(FOS_GetSemaphoreBinaryDesc(p, id), &thr_id);
+	if(ret != FOS__OK)
+		return ret;
 
-	return &p->sheduler.dbg;
+	// no thread was waiting for the semaphore - nothing to hand the time slice to
+	if(thr_id == FOS_WRONG_THREAD_ID)
+		return FOS__OK;
+
+	FOS_YieldToId(p, thr_id);
+
+	return FOS__OK;
 }
 
 
-// main loop handler
-void FOS_MainLoopProc(fos_t *p)
+// set binary semaphore timeout
+fos_ret_t FOS_SemBinarySetTimeout(fos_t *p, user_desc_t semb, uint32_t timeout_ms)
+{
+	if((p == NULL) || (semb == FOS_WRONG_USER_DESC))
+		return FOS__FAIL;
+
+	fos_id_t id = FOS_GetUdSemaphoreBinaryId(p, semb);
+	if(id == FOS_WRONG_SEM_BIN_ID)
+		return FOS__FAIL;
+
+	fos_semaphore_binary_t *ptr = FOS_GetSemaphoreBinaryDesc(p, id);
+	if(ptr == NULL)
+		return FOS__FAIL;
+
+	return FOS_SemaphoreBinary_SetTimeout(ptr, timeout_ms);
+}
+
+
+// get writer object identifier by its descriptor
+static fos_id_t FOS_GetFWriterId(fos_t *p, fwriter_t *fw)
+{
+	if(p == NULL)
+		return FOS_WRONG_FWRITER_ID;
+
+	// the writer object of the file system has no user descriptor to keep its slot in,
+	// the search is done only to reject a duplicate on registration, writers are never deleted
+	for(fos_id_t i = 0; i <= p->var.fwriter_max_id; i++)
+		if(p->var.fwriter_desc_list[i] == fw)
+			return i;
+
+	return FOS_WRONG_FWRITER_ID;
+}
+
+
+// get writer object descriptor by its identifier
+fwriter_t* FOS_GetFWriterDesc(fos_t *p, fos_id_t id)
+{
+	if(p == NULL)
+		return NULL;
+
+	if(id > p->var.fwriter_max_id)
+		return NULL;
+
+	return p->var.fwriter_desc_list[id];
+}
+
+
+// register writer object
+fos_ret_t FOS_FWriterReg(fos_t *p, fwriter_t *fw)
+{
+	if((p == NULL) || (fw == NULL))
+		return FOS__FAIL;
+
+	fos_id_t ind = 0;
+	fos_var_t *v = &p->var;
+
+	// search for duplicated writer objects
+	if(FOS_GetFWriterId(p, fw) != FOS_WRONG_FWRITER_ID)
+		return FOS__FAIL;
+
+	// take free slot
+	ind = FOS_IdMap_Alloc(&v->fwriter_idmap);
+	if(ind == FOS_EMPTY_ID)
+		return FOS__FAIL;
+
+	v->fwriter_desc_list[ind] = fw;        // insert the pointer into the available section
+
+	Private_FOS_UpdFWriterMaxInd(p);       // update the maximum index
+
+	return FOS__OK;
+}
+
+
+// identify error
+void FOS_ErrorSet(fos_t *p, fos_err_t *err)
+{
+	if((p == NULL) || (err == NULL))
+		return;
+
+	memcpy((void*)&p->var.error, err, sizeof(fos_err_t));
+
+	if(err->ext_str_ptr != NULL)
+		strncpy((void*)p->var.error.str, err->ext_str_ptr, FOS_MAX_STR_ERR_LEN);
+}
+
+
+// get semaphore identifier by user defined descriptor
+static fos_id_t FOS_GetUdSemaphoreCntId(fos_t *p, user_desc_t user_desc)
+{
+	if((p == NULL) || (user_desc == FOS_WRONG_USER_DESC))
+		return FOS_WRONG_SEM_CNT_ID;
+
+	// the slot is taken from the descriptor, the descriptor of the object in the slot must match it
+	fos_id_t id = FOS_USER_DESC_SLOT(user_desc);
+	fos_semaphore_cnt_t *obj = FOS_GetSemaphoreCntDesc(p, id);
+	if((obj == NULL) || (obj->user_desc != user_desc))
+		return FOS_WRONG_SEM_CNT_ID;
+
+	return id;
+}
+
+
+// get semaphore identifier by its descriptor
+static fos_id_t FOS_GetSemaphoreCntId(fos_t *p, fos_semaphore_cnt_t *semc)
+{
+	if((p == NULL) || (semc == NULL))
+		return FOS_WRONG_SEM_CNT_ID;
+
+	// a registered semaphore is found in the slot of its user descriptor
+	fos_id_t id = FOS_USER_DESC_SLOT(semc->user_desc);
+	if(FOS_GetSemaphoreCntDesc(p, id) != semc)
+		return FOS_WRONG_SEM_CNT_ID;
+
+	return id;
+}
+
+
+// get semaphore descriptor by its identifier
+static fos_semaphore_cnt_t* FOS_GetSemaphoreCntDesc(fos_t *p, fos_id_t id)
+{
+	if(p == NULL)
+		return NULL;
+
+	if(id > p->var.semc_max_ind)
+		return NULL;
+
+	return p->var.semc_desc_list[id];
+}
+
+
+// register counting semaphore
+fos_ret_t FOS_SemCntReg(fos_t *p, fos_semaphore_cnt_t *semc)
+{
+	if((p == NULL) || (semc == NULL))
+		return FOS__FAIL;
+
+	fos_id_t ind = 0;
+	fos_var_t *v = &p->var;
+
+	// search for duplicated semaphores
+	if(FOS_GetSemaphoreCntId(p, semc) != FOS_WRONG_SEM_CNT_ID)
+		return FOS__FAIL;
+
+	// take free slot
+	ind = FOS_IdMap_Alloc(&v->semc_idmap);
+	if(ind == FOS_EMPTY_ID)
+		return FOS__FAIL;
+
+	// assign unique user-defined descriptor to the semaphore
+	if(FOS_SemaphoreCnt_SetUserDesc(semc, Private_FOS_MakeUserDesc(&v->semc_idmap, ind)) != FOS__OK)
+	{
+		FOS_IdMap_Free(&v->semc_idmap, ind);
+		return FOS__FAIL;
+	}
+
+	v->semc_desc_list[ind] = semc;        // insert the pointer into the available section
+	FOS_Lock_Bind(&semc->fos_lock, v->lock_node);
+
+	Private_FOS_UpdSemCntMaxInd(p);       // update the maximum index
+
+	return FOS__OK;
+}
+
+
+// delete counting semaphore
+fos_ret_t FOS_SemCntDelete(fos_t *p, user_desc_t semc)
+{
+	if((p == NULL) || (semc == FOS_WRONG_USER_DESC))
+		return FOS__FAIL;
+
+	fos_id_t id = FOS_GetUdSemaphoreCntId(p, semc);
+	if(id == FOS_WRONG_SEM_CNT_ID)
+		return FOS__FAIL;
+
+	fos_semaphore_cnt_t *ptr = FOS_GetSemaphoreCntDesc(p, id);
+	if(ptr == NULL)
+		return FOS__FAIL;
+
+	if(Private_FOS_AddOjectToDelList(p, (uint32_t)ptr, FOS_KERNEL_HEAP_ID) != FOS__OK)
+		return FOS__FAIL;
+
+	FOS_SemaphoreCnt_UnlockAll(ptr);
+	p->var.semc_desc_list[id] = NULL;
+	FOS_IdMap_Free(&p->var.semc_idmap, id);
+
+	Private_FOS_UpdSemCntMaxInd(p);    // update the maximum index
+
+	return FOS__OK;
+}
+
+
+// acquire counting semaphore
+fos_ret_t FOS_SemCntTake(fos_t *p, user_desc_t semc)
+{
+	if((p == NULL) || (semc == FOS_WRONG_USER_DESC))
+		return FOS__FAIL;
+
+	fos_id_t id = FOS_GetUdSemaphoreCntId(p, semc);
+	if(id == FOS_WRONG_SEM_CNT_ID)
+		return FOS__FAIL;
+
+	fos_semaphore_cnt_t *ptr = FOS_GetSemaphoreCntDesc(p, id);
+	if(ptr == NULL)
+		return FOS__FAIL;
+
+	fos_ret_t ret = FOS_SemaphoreCnt_Take(ptr, p->var.current_thr);
+
+#if defined(FOS_USE_DIRECT_SWITCH)
+	uint32_t ts;
+	Private_FOS_PlanSemTimeout(p, FOS_SemaphoreCnt_GetTimeoutTs(ptr, &ts), ts);
+#endif
+
+	return ret;
+}
+
+
+// get status of acquire counting semaphore
+fos_ret_t FOS_SemCntTakeStat(fos_t *p, user_desc_t semc)
+{
+	if((p == NULL) || (semc == FOS_WRONG_USER_DESC))
+		return FOS__FAIL;
+
+	fos_id_t id = FOS_GetUdSemaphoreCntId(p, semc);
+	if(id == FOS_WRONG_SEM_CNT_ID)
+		return FOS__FAIL;
+
+	fos_semaphore_cnt_t *ptr = FOS_GetSemaphoreCntDesc(p, id);
+	if(ptr == NULL)
+		return FOS__FAIL;
+
+	return FOS_SemaphoreCnt_TakeStat(ptr);
+}
+
+
+// release counting semaphore
+fos_ret_t FOS_SemCntGive(fos_t *p, user_desc_t semc)
+{
+	if((p == NULL) || (semc == FOS_WRONG_USER_DESC))
+		return FOS__FAIL;
+
+	fos_id_t id = FOS_GetUdSemaphoreCntId(p, semc);
+	if(id == FOS_WRONG_SEM_CNT_ID)
+		return FOS__FAIL;
+
+	fos_semaphore_cnt_t *ptr = FOS_GetSemaphoreCntDesc(p, id);
+	if(ptr == NULL)
+		return FOS__FAIL;
+
+	return FOS_SemaphoreCnt_Give(ptr);
+}
+
+
+// set counting semaphore timeout
+fos_ret_t FOS_SemCntSetTimeout(fos_t *p, user_desc_t semc, uint32_t timeout_ms)
+{
+	if((p == NULL) || (semc == FOS_WRONG_USER_DESC))
+		return FOS__FAIL;
+
+	fos_id_t id = FOS_GetUdSemaphoreCntId(p, semc);
+	if(id == FOS_WRONG_SEM_CNT_ID)
+		return FOS__FAIL;
+
+	fos_semaphore_cnt_t *ptr = FOS_GetSemaphoreCntDesc(p, id);
+	if(ptr == NULL)
+		return FOS__FAIL;
+
+	return FOS_SemaphoreCnt_SetTimeout(ptr, timeout_ms);
+}
+
+
+// get queue32 identifier by its descriptor
+static fos_id_t FOS_GetQueue32Id(fos_t *p, fos_queue32_t *que)
+{
+	if((p == NULL) || (que == NULL))
+		return FOS_WRONG_QUE_32_ID;
+
+	// a registered queue32 is found in the slot of its user descriptor
+	fos_id_t id = FOS_USER_DESC_SLOT(que->user_desc);
+	if(FOS_GetQueue32Desc(p, id) != que)
+		return FOS_WRONG_QUE_32_ID;
+
+	return id;
+}
+
+
+// get queue32 identifier by user defined descriptor
+static fos_id_t FOS_GetUdQueue32Id(fos_t *p, user_desc_t user_desc)
+{
+	if((p == NULL) || (user_desc == FOS_WRONG_USER_DESC))
+		return FOS_WRONG_QUE_32_ID;
+
+	// the slot is taken from the descriptor, the descriptor of the object in the slot must match it
+	fos_id_t id = FOS_USER_DESC_SLOT(user_desc);
+	fos_queue32_t *obj = FOS_GetQueue32Desc(p, id);
+	if((obj == NULL) || (obj->user_desc != user_desc))
+		return FOS_WRONG_QUE_32_ID;
+
+	return id;
+}
+
+
+// get queue32 descriptor by its identifier
+static fos_queue32_t* FOS_GetQueue32Desc(fos_t *p, fos_id_t id)
+{
+	if(p == NULL)
+		return NULL;
+
+	if(id > p->var.queue32_max_ind)
+		return NULL;
+
+	return p->var.queue32_desc_list[id];
+}
+
+
+// register queue32
+fos_ret_t FOS_Queue32Reg(fos_t *p, fos_queue32_t *que)
+{
+	if((p == NULL) || (que == NULL))
+		return FOS__FAIL;
+
+	fos_id_t ind = 0;
+	fos_var_t *v = &p->var;
+
+	// search for duplicated
+	if(FOS_GetQueue32Id(p, que) != FOS_WRONG_QUE_32_ID)
+		return FOS__FAIL;
+
+	// take free slot
+	ind = FOS_IdMap_Alloc(&v->queue32_idmap);
+	if(ind == FOS_EMPTY_ID)
+		return FOS__FAIL;
+
+	// assign unique user-defined descriptor to the queue32
+	if(FOS_Queue32_SetUserDesc(que, Private_FOS_MakeUserDesc(&v->queue32_idmap, ind)) != FOS__OK)
+	{
+		FOS_IdMap_Free(&v->queue32_idmap, ind);
+		return FOS__FAIL;
+	}
+
+	v->queue32_desc_list[ind] = que;      // insert the pointer into the available section
+
+	Private_FOS_UpdQueue32MaxInd(p);      // update the maximum index
+
+	return FOS__OK;
+}
+
+
+// join counting semaphore to queue32
+fos_ret_t FOS_Queue32JoinToSemCnt(fos_t *p, fos_queue32_t *que, user_desc_t semc)
+{
+	if((p == NULL) || (que == NULL) || (semc == FOS_WRONG_USER_DESC))
+		return FOS__FAIL;
+
+	fos_id_t id = FOS_GetUdSemaphoreCntId(p, semc);
+	if(id == FOS_WRONG_SEM_CNT_ID)
+		return FOS__FAIL;
+
+	FOS_Queue32_SetSemaphorePtr(que, FOS_GetSemaphoreCntDesc(p, id));
+
+	return FOS__OK;
+}
+
+
+// delete queue32
+fos_ret_t FOS_Queue32Delete(fos_t *p, user_desc_t que)
+{
+	if((p == NULL) || (que == FOS_WRONG_USER_DESC))
+		return FOS__FAIL;
+
+	fos_id_t id = FOS_GetUdQueue32Id(p, que);
+	if(id == FOS_WRONG_QUE_32_ID)
+		return FOS__FAIL;
+
+	fos_queue32_t *ptr = FOS_GetQueue32Desc(p, id);
+	if(ptr == NULL)
+		return FOS__FAIL;
+
+	if(Private_FOS_AddOjectToDelList(p, (uint32_t)ptr, FOS_KERNEL_HEAP_ID) != FOS__OK)
+		return FOS__FAIL;
+
+	if(Private_FOS_AddOjectToDelList(p, (uint32_t)ptr->msg.buf_ptr, FOS_THREADS_HEAP_ID) != FOS__OK)
+		return FOS__FAIL;
+
+	if(ptr->semc_ptr)
+		FOS_SemCntDelete(p, ptr->semc_ptr->user_desc);
+
+	p->var.queue32_desc_list[id] = NULL;
+	FOS_IdMap_Free(&p->var.queue32_idmap, id);
+
+	Private_FOS_UpdQueue32MaxInd(p);   // update the maximum index
+
+	return FOS__OK;
+}
+
+
+// ask data
+fos_ret_t FOS_Queue32AskData(fos_t *p, user_desc_t que, fos_queue_sw_t blocking_mode_sw)
+{
+	if((p == NULL) || (que == FOS_WRONG_USER_DESC))
+		return FOS__FAIL;
+
+	fos_id_t id = FOS_GetUdQueue32Id(p, que);
+	if(id == FOS_WRONG_QUE_32_ID)
+		return FOS__FAIL;
+
+	fos_queue32_t *ptr = FOS_GetQueue32Desc(p, id);
+	if(ptr == NULL)
+		return FOS__FAIL;
+
+	fos_id_t block_thr_id = FOS_SPECIAL_ID;
+
+	if(blocking_mode_sw == FOS_QUEUE_SW__BLOCK)
+		if(FOS_System_GetWorkMode() == FOS__USER_WORK_MODE)
+			block_thr_id = p->var.current_thr;
+
+	return FOS_Queue32_AskData(ptr, block_thr_id);
+}
+
+
+// read data
+// one must ask data before read every times
+fos_ret_t FOS_Queue32ReadData(fos_t *p, user_desc_t que, uint32_t* data_ptr)
+{
+	if((p == NULL) || (que == FOS_WRONG_USER_DESC) || (data_ptr == NULL))
+		return FOS__FAIL;
+
+	fos_id_t id = FOS_GetUdQueue32Id(p, que);
+	if(id == FOS_WRONG_QUE_32_ID)
+		return FOS__FAIL;
+
+	fos_queue32_t *ptr = FOS_GetQueue32Desc(p, id);
+	if(ptr == NULL)
+		return FOS__FAIL;
+
+	return FOS_Queue32_ReadData(ptr, data_ptr);
+}
+
+
+// write data
+fos_ret_t FOS_Queue32WriteData(fos_t *p, user_desc_t que, uint32_t data)
+{
+	if((p == NULL) || (que == FOS_WRONG_USER_DESC))
+		return FOS__FAIL;
+
+	fos_id_t id = FOS_GetUdQueue32Id(p, que);
+	if(id == FOS_WRONG_QUE_32_ID)
+		return FOS__FAIL;
+
+	fos_queue32_t *ptr = FOS_GetQueue32Desc(p, id);
+	if(ptr == NULL)
+		return FOS__FAIL;
+
+	return FOS_Queue32_WriteData(ptr, data);
+}
+
+
+// get mutex identifier by user defined descriptor
+static fos_id_t FOS_GetUdMutexId(fos_t *p, user_desc_t user_desc)
+{
+	if((p == NULL) || (user_desc == FOS_WRONG_USER_DESC))
+		return FOS_WRONG_MUTEX_ID;
+
+	// the slot is taken from the descriptor, the descriptor of the object in the slot must match it
+	fos_id_t id = FOS_USER_DESC_SLOT(user_desc);
+	fos_mutex_t *obj = FOS_GetMutexDesc(p, id);
+	if((obj == NULL) || (obj->user_desc != user_desc))
+		return FOS_WRONG_MUTEX_ID;
+
+	return id;
+}
+
+
+// get mutex identifier by its descriptor
+static fos_id_t FOS_GetMutexId(fos_t *p, fos_mutex_t *mtx)
+{
+	if((p == NULL) || (mtx == NULL))
+		return FOS_WRONG_MUTEX_ID;
+
+	// a registered mutex is found in the slot of its user descriptor
+	fos_id_t id = FOS_USER_DESC_SLOT(mtx->user_desc);
+	if(FOS_GetMutexDesc(p, id) != mtx)
+		return FOS_WRONG_MUTEX_ID;
+
+	return id;
+}
+
+
+// get mutex descriptor by its identifier
+static fos_mutex_t* FOS_GetMutexDesc(fos_t *p, fos_id_t id)
+{
+	if(p == NULL)
+		return NULL;
+
+	if(id > p->var.mutex_max_ind)
+		return NULL;
+
+	return p->var.mutex_desc_list[id];
+}
+
+
+// register mutex
+fos_ret_t FOS_MutexReg(fos_t *p, fos_mutex_t *mtx)
+{
+	if((p == NULL) || (mtx == NULL))
+		return FOS__FAIL;
+
+	fos_id_t ind = 0;
+	fos_var_t *v = &p->var;
+
+	// search for duplicated mutexes
+	if(FOS_GetMutexId(p, mtx) != FOS_WRONG_MUTEX_ID)
+		return FOS__FAIL;
+
+	// take free slot
+	ind = FOS_IdMap_Alloc(&v->mutex_idmap);
+	if(ind == FOS_EMPTY_ID)
+		return FOS__FAIL;
+
+	// assign unique user-defined descriptor to the mutex
+	if(FOS_Mutex_SetUserDesc(mtx, Private_FOS_MakeUserDesc(&v->mutex_idmap, ind)) != FOS__OK)
+	{
+		FOS_IdMap_Free(&v->mutex_idmap, ind);
+		return FOS__FAIL;
+	}
+
+	v->mutex_desc_list[ind] = mtx;        // insert the pointer into the available section
+	FOS_Lock_Bind(&mtx->fos_lock, v->lock_node);
+
+	Private_FOS_UpdMutexMaxInd(p);        // update the maximum index
+
+	return FOS__OK;
+}
+
+
+// delete mutex
+// FOS__FAIL - the mutex is locked
+fos_ret_t FOS_MutexDelete(fos_t *p, user_desc_t mtx)
+{
+	if((p == NULL) || (mtx == FOS_WRONG_USER_DESC))
+		return FOS__FAIL;
+
+	fos_id_t id = FOS_GetUdMutexId(p, mtx);
+	if(id == FOS_WRONG_MUTEX_ID)
+		return FOS__FAIL;
+
+	fos_mutex_t *ptr = FOS_GetMutexDesc(p, id);
+	if(ptr == NULL)
+		return FOS__FAIL;
+
+	// a locked mutex may have waiting threads, they must not be released without the ownership
+	if(FOS_Mutex_GetOwner(ptr) != FOS_WRONG_THREAD_ID)
+		return FOS__FAIL;
+
+	if(Private_FOS_AddOjectToDelList(p, (uint32_t)ptr, FOS_KERNEL_HEAP_ID) != FOS__OK)
+		return FOS__FAIL;
+
+	p->var.mutex_desc_list[id] = NULL;
+	FOS_IdMap_Free(&p->var.mutex_idmap, id);
+
+	Private_FOS_UpdMutexMaxInd(p);        // update the maximum index
+
+	return FOS__OK;
+}
+
+
+// lock mutex by the current thread
+fos_ret_t FOS_MutexLock(fos_t *p, user_desc_t mtx)
+{
+	if((p == NULL) || (mtx == FOS_WRONG_USER_DESC))
+		return FOS__FAIL;
+
+	fos_id_t id = FOS_GetUdMutexId(p, mtx);
+	if(id == FOS_WRONG_MUTEX_ID)
+		return FOS__FAIL;
+
+	fos_mutex_t *ptr = FOS_GetMutexDesc(p, id);
+	if(ptr == NULL)
+		return FOS__FAIL;
+
+	fos_id_t thr_id = p->var.current_thr;
+	fos_thread_t *thr = FOS_GetThreadDesc(p, thr_id);
+	if(thr == NULL)
+		return FOS__FAIL;
+
+	if(FOS_Mutex_Take(ptr, thr_id, Private_FOS_GetWaitPriority(thr)) != FOS__OK)
+		return FOS__FAIL;
+
+	if(FOS_Mutex_GetOwner(ptr) == thr_id)      // the mutex is taken
+	{
+		Private_FOS_MutexHold(p, thr, id);
+		Private_FOS_UpdThreadPriority(p, thr_id, thr);    // the owner is raised to the ceiling of the mutex at once
+	}else                                      // the mutex is busy and the thread is blocked
+	{
+		thr->var.mutex_wait = id;
+		Private_FOS_InheritPriority(p, id);    // the owner runs with the priority of the thread until unlock
+	}
+
+	return FOS__OK;
+}
+
+
+// unlock mutex owned by the current thread
+fos_ret_t FOS_MutexUnlock(fos_t *p, user_desc_t mtx)
+{
+	if((p == NULL) || (mtx == FOS_WRONG_USER_DESC))
+		return FOS__FAIL;
+
+	fos_id_t id = FOS_GetUdMutexId(p, mtx);
+	if(id == FOS_WRONG_MUTEX_ID)
+		return FOS__FAIL;
+
+	fos_mutex_t *ptr = FOS_GetMutexDesc(p, id);
+	if(ptr == NULL)
+		return FOS__FAIL;
+
+	fos_id_t thr_id = p->var.current_thr;
+	fos_thread_t *thr = FOS_GetThreadDesc(p, thr_id);
+	if(thr == NULL)
+		return FOS__FAIL;
+
+	if(FOS_Mutex_Give(ptr, thr_id) != FOS__OK)  // the ownership is passed to the highest priority waiting thread
+		return FOS__FAIL;
+
+	Private_FOS_MutexRelease(p, thr, id);
+	Private_FOS_UpdMutexOwner(p, id);
+
+	// restore the priority of the thread, switch if it has been lowered
+	if(Private_FOS_UpdThreadPriority(p, thr_id, thr))
+		FOS_System_Preempt();
+
+	return FOS__OK;
+}
+
+
+// send message to the thread with identifier and wait for the reply
+fos_ret_t FOS_IpcSend(fos_t *p, fos_id_t id, fos_ipc_msg_t *msg, fos_ipc_msg_t *reply)
+{
+	if((p == NULL) || (msg == NULL))
+		return FOS__FAIL;
+
+	fos_id_t src_id = p->var.current_thr;
+	fos_thread_t *src = FOS_GetThreadDesc(p, src_id);
+	fos_thread_t *dst = FOS_GetThreadDesc(p, id);
+	if((src == NULL) || (dst == NULL) || (id == src_id))
+		return FOS__FAIL;
+
+	if(dst->hot->mode != FOS__THREAD_RUN)           // the receiver must be running
+		return FOS__FAIL;
+
+	src->ipc.msg_ptr   = msg;
+	src->ipc.reply_ptr = reply;
+	src->ipc.partner   = id;
+	src->ipc.ret       = FOS__FAIL;
+
+	if(dst->ipc.state == FOS_IPC__RECV_BLOCKED)    // the receiver is waiting - rendezvous
+	{
+		Private_FOS_IpcDeliver(p, id, dst, src_id, src);
+		Private_FOS_IpcWaitReply(dst, src_id, src);
+		p->var.yield_to = id;                      // switch straight to the receiver
+	}else                                          // the sender waits in the queue of the receiver
+	{
+		src->ipc.send_next = FOS_WRONG_THREAD_ID;
+		if(dst->ipc.send_first == FOS_WRONG_THREAD_ID)
+			dst->ipc.send_first = src_id;
+		else
+			FOS_GetThreadDesc(p, dst->ipc.send_last)->ipc.send_next = src_id;
+		dst->ipc.send_last = src_id;
+
+		src->ipc.state = FOS_IPC__SEND_BLOCKED;
+	}
+
+	return FOS_LockId(p, src_id, FOS_LOCK_IPC_FLAG);    // the sender waits for the reply
+}
+
+
+// receive message, wait for it if no thread is sending
+fos_ret_t FOS_IpcReceive(fos_t *p, fos_ipc_msg_t *msg)
+{
+	if((p == NULL) || (msg == NULL))
+		return FOS__FAIL;
+
+	fos_id_t dst_id = p->var.current_thr;
+	fos_thread_t *dst = FOS_GetThreadDesc(p, dst_id);
+	if(dst == NULL)
+		return FOS__FAIL;
+
+	dst->ipc.msg_ptr = msg;
+	dst->ipc.partner = FOS_WRONG_THREAD_ID;
+	dst->ipc.ret     = FOS__FAIL;
+
+	// take the message of the first waiting sender, it keeps waiting for the reply
+	fos_id_t src_id = dst->ipc.send_first;
+	fos_thread_t *src = FOS_GetThreadDesc(p, src_id);
+	if(src)
+	{
+		Private_FOS_IpcRemoveSender(p, &dst->ipc.send_first, &dst->ipc.send_last, src_id);
+
+		*dst->ipc.msg_ptr = *src->ipc.msg_ptr;
+		dst->ipc.partner = src_id;
+		dst->ipc.ret     = FOS__OK;
+		Private_FOS_IpcWaitReply(dst, src_id, src);
+
+		return FOS__OK;
+	}
+
+	dst->ipc.state = FOS_IPC__RECV_BLOCKED;
+
+	return FOS_LockId(p, dst_id, FOS_LOCK_IPC_FLAG);    // the receiver waits for a message
+}
+
+
+// reply to the thread with identifier whose message has been received
+fos_ret_t FOS_IpcReply(fos_t *p, fos_id_t id, fos_ipc_msg_t *reply)
+{
+	if(p == NULL)
+		return FOS__FAIL;
+
+	fos_thread_t *src = FOS_GetThreadDesc(p, id);
+	if(src == NULL)
+		return FOS__FAIL;
+
+	// only the thread that has received the message replies to it
+	fos_thread_t *dst = FOS_GetThreadDesc(p, p->var.current_thr);
+	if((dst == NULL) || (src->ipc.state != FOS_IPC__REPLY_BLOCKED) || (src->ipc.partner != p->var.current_thr))
+		return FOS__FAIL;
+
+	Private_FOS_IpcRemoveSender(p, &dst->ipc.reply_first, NULL, id);
+
+	if(reply && src->ipc.reply_ptr)
+		*src->ipc.reply_ptr = *reply;
+
+	src->ipc.state = FOS_IPC__IDLE;
+	src->ipc.ret   = FOS__OK;
+
+	FOS_UnlockId(p, id, FOS_LOCK_IPC_FLAG);
+	FOS_YieldToId(p, id);                          // switch straight back to the sender
+
+	return FOS__OK;
+}
+
+
+// get user descriptor of the partner of the last message exchange of the current thread (FOS_WRONG_USER_DESC - exchange failed)
+user_desc_t FOS_IpcGetPartner(fos_t *p)
+{
+	if(p == NULL)
+		return FOS_WRONG_USER_DESC;
+
+	fos_thread_t *thr = FOS_GetThreadDesc(p, p->var.current_thr);
+	if((thr == NULL) || (thr->ipc.ret != FOS__OK))
+		return FOS_WRONG_USER_DESC;
+
+	fos_thread_t *partner = FOS_GetThreadDesc(p, thr->ipc.partner);
+	if(partner == NULL)
+		return FOS_WRONG_USER_DESC;
+
+	return partner->user_desc;
+}
+
+
+// get the system stack debug info
+fos_thread_dbg_t* FOS_GetSysStackDbgInfo(fos_t *p)
+{
+	if(p == NULL)
+		return NULL;
+
+	return &p->sys_stack_dbg;
+}
+
+
+// get the scheduler debug info
+fos_scheduler_dbg_t* FOS_GetSchedulerDbgInfo(fos_t *p)
+{
+	if(p == NULL)
+		return NULL;
+
+	return &p->sheduler.dbg;
+}
+
+
+#if defined(FOS_USE_SCHED_POLICY_RUNTIME)
+// change the scheduling policy, the ready threads are moved to the queues of the new policy
+fos_ret_t FOS_SetSchedPolicy(fos_t *p, const fos_sched_policy_t *policy)
+{
+	if((p == NULL) || (policy == NULL))
+		return FOS__FAIL;
+
+	fos_thread_t *thr;
+	fos_ret_t ret;
+	uint32_t s;
+
+	ENTER_CRITICAL(s);
+
+	for(fos_id_t i = 0; i <= p->var.thread_max_ind; i++)
+		FOS_Schedule_UpdThread(&p->sheduler, i, NULL);    // empty the queues of the old policy
+
+	ret = FOS_Schedule_SetPolicy(&p->sheduler, policy);
+
+	for(fos_id_t i = 0; i <= p->var.thread_max_ind; i++)
+	{
+		thr = FOS_GetThreadDesc(p, i);
+		if(thr)
+			FOS_Schedule_UpdThread(&p->sheduler, i, thr);
+	}
+
+	LEAVE_CRITICAL(s);
+
+	return ret;
+}
+#endif
+
+
+// main loop handler
+void FOS_MainLoopProc(fos_t *p)
+{
+	if(p == NULL)
+		return;
+
+	if(p->var.fos_sw == FOS__DISABLE)
+		return;
+
+	p->var.housekeeping_sw = FOS__DISABLE;
+
+	Private_FOS_TerminatingThreadProc(p);       // terminating thread procedure
+
+	FOS_ThreadProcDbg(&p->sys_stack_dbg, 0);    // kernel stack debug
+
+	/*
+	 * Threads stack debug
+	 */
+	if((SL_GetTick() - p->var.dbg_ts) >= FOS_STACK_CHECK_PERIOD_MS)
+	{
+		p->var.dbg_ts = SL_GetTick();
+		for(fos_id_t i = 0; i <= p->var.thread_max_ind; i++)
+		{
+			fos_thread_t *thr = FOS_GetThreadDesc(p, i);
+			if(thr && (thr->hot->mode == FOS__THREAD_RUN))
+				FOS_ThreadProcDbg(&thr->dbg, thr->user_desc);
+		}
+	}
+
+	Private_FOS_WakeUpProc(p);               // handle timeouts and wake-ups
+
+#if defined(FOS_USE_DIRECT_SWITCH)
+	Private_FOS_PlanHousekeeping(p);         // the switches till then bypass the main loop
+#endif
+
+	if(Private_FOS_Sheduler(p) < 0)          // thread scheduler
+		return;
+
+	Private_FOS_SliceProc(p);                  // choose the main timer period
+
+	FOS_System_GoToUserMode();                 // switch to user mode
+}
+
+
+// choose the next thread right in PendSV, bypassing the main loop
+// FOS__FAIL - the switch must go through the main loop
+fos_ret_t FOS_DirectSwitchProc(fos_t *p)
 {
 	if(p == NULL)
+		return FOS__FAIL;
+
+	if(p->var.fos_sw == FOS__DISABLE)
+		return FOS__FAIL;
+
+	// housekeeping is done by the main loop only
+	if(p->var.housekeeping_sw || p->var.obj_to_del_cnt)
+		return FOS__FAIL;
+	if(FOS_TIME_AFTER_EQ((uint32_t)FOS_Time_GetUs(), p->var.housekeeping_due_us))
+		return FOS__FAIL;
+
+	fos_var_t *v = &p->var;
+	fos_id_t current_thr = v->current_thr;
+	uint32_t thr_dt_us   = fos_mgv.thr_dt_us;
+	fos_thread_ptr thr   = FOS_GetThreadDesc(p, current_thr);
+
+	/*
+	 * Interrupts are masked here, so only pick-and-swap is done:
+	 * wake-ups, timeouts, exhausted budgets, groups and the time-triggered table are handled by the main loop
+	 */
+	if(Private_FOS_IsDirectSwitchable(p, thr) == FOS__DISABLE)
+		return FOS__FAIL;
+	if(FOS_Thread_GetBudgetLeft(thr) <= thr_dt_us)
+		return FOS__FAIL;
+
+	p->sheduler.var.curr_dt_us[current_thr] += thr_dt_us;    // the load statistics are summed up by the main loop
+	FOS_Schedule_Tick(&p->sheduler, current_thr, thr_dt_us);
+	FOS_Thread_AddRunTime(thr, thr_dt_us);
+	FOS_Thread_ChargeBudget(thr, thr_dt_us);                  // the budget is not used up, it was checked above
+
+	int16_t next_thr = FOS_Schedule(&p->sheduler, current_thr);
+	if(next_thr < 0)
+		return FOS__FAIL;
+
+	Private_FOS_SaveUserSP(p);
+	Private_FOS_SwitchThread(p, thr, next_thr);
+
+	Private_FOS_SliceProc(p);                  // choose the main timer period
+
+	return FOS__OK;
+}
+
+
+// check if the switch needs no more than pick-and-swap
+static fos_sw_t Private_FOS_IsDirectSwitchable(fos_t *p, fos_thread_t *thr)
+{
+	if(thr == NULL)
+		return FOS__DISABLE;
+
+	// the shared stack, the groups, the time-triggered table and the handed time slice
+	if(Private_FOS_GetThreadRtcStack(p, thr) || p->var.group_sw)
+		return FOS__DISABLE;
+	if(FOS_TT_IsRunning(&p->var.tt) || (p->var.yield_to != FOS_EMPTY_ID))
+		return FOS__DISABLE;
+
+#if defined(FOS_USE_TICKLESS_IDLE)
+	// the tickless period is chosen by the main loop, it scans the semaphore timeouts
+	if(p->sheduler.ready_thr_cnt <= 1)
+		return FOS__DISABLE;
+#endif
+
+	// a thread is due to wake up
+	uint32_t expiry;
+	if((FOS_TQueue_GetNextExpiry(&p->tqueue, &expiry) == FOS__OK) && FOS_TIME_AFTER_EQ((uint32_t)FOS_Time_GetUs(), expiry))
+		return FOS__DISABLE;
+
+	return FOS__ENABLE;
+}
+
+
+// OS kernel intialization
+static void Private_FOS_Core_Init(fos_t *p)
+{
+	memset(&p->var, 0, sizeof(fos_var_t));
+	memset(&p->sheduler, 0, sizeof(fos_scheduler_t));
+	memset(&p->sys_stack_dbg, 0 , sizeof(fos_thread_dbg_t));
+
+	FOS_Schedule_Init(&p->sheduler);
+	FOS_TQueue_Init(&p->tqueue);
+
+	FOS_IdMap_Init(&p->var.thread_idmap,  p->var.thread_idmap_bits,  FOS_MAX_THR_CNT);
+	FOS_IdMap_Init(&p->var.semb_idmap,    p->var.semb_idmap_bits,    FOS_SEM_BIN_CNT);
+	FOS_IdMap_Init(&p->var.semc_idmap,    p->var.semc_idmap_bits,    FOS_SEM_COUNTING_CNT);
+	FOS_IdMap_Init(&p->var.mutex_idmap,   p->var.mutex_idmap_bits,   FOS_MUTEX_CNT);
+	FOS_IdMap_Init(&p->var.queue32_idmap, p->var.queue32_idmap_bits, FOS_SEM_QUEUE_32_CNT);
+	FOS_IdMap_Init(&p->var.fwriter_idmap, p->var.fwriter_idmap_bits, FOS_FWRITER_CNT);
+
+	for(uint8_t i = 0; i < FOS_PRIORITY_CNT; i++)
+	{
+		p->var.rtc_stack[i].owner      = FOS_WRONG_THREAD_ID;
+		p->var.rtc_stack[i].wait_first = FOS_WRONG_THREAD_ID;
+		p->var.rtc_stack[i].wait_last  = FOS_WRONG_THREAD_ID;
+	}
+
+	p->var.yield_to = FOS_EMPTY_ID;
+
+	for(uint8_t i = 0; i < FOS_GROUP_CNT; i++)
+		FOS_Group_Init(&p->var.group[i]);
+
+	FOS_TT_Init(&p->var.tt);
+
+	FOS_Lock_NodeInit(p->var.lock_node);
+}
+
+
+// thread scheduler
+static int16_t Private_FOS_Sheduler(fos_t *p)
+{
+	fos_var_t* v = &p->var;
+
+	// acquisition of current thread statistics
+	fos_id_t current_thr = v->current_thr;
+	uint32_t thr_dt_us   = fos_mgv.thr_dt_us;
+	FOS_ScheduleDbg(&p->sheduler, v->thread_max_ind, current_thr, thr_dt_us);
+	FOS_Schedule_Tick(&p->sheduler, current_thr, thr_dt_us);
+	FOS_Thread_AddRunTime(FOS_GetThreadDesc(p, current_thr), thr_dt_us);    // job execution time of periodic thread
+
+	/*
+	 * Save context of current thread before its shared stack can be passed on
+	 */
+	fos_thread_ptr thr = FOS_GetThreadDesc(p, v->current_thr);    // get current thread descrpitor
+	if(thr)                                                       // check for its existence
+	{
+		Private_FOS_SaveUserSP(p);                                // save stack of user defined thread
+		Private_FOS_RtcStackRelease(p, v->current_thr, thr);      // the next job may start on the shared stack
+
+		// the thread that has used up its CPU budget waits for the replenishment
+		if(FOS_Thread_ChargeBudget(thr, thr_dt_us))
+		{
+			FOS_Thread_Throttle(thr);
+			FOS_Schedule_UpdThread(&p->sheduler, current_thr, thr);
+			Private_FOS_UpdThreadTimer(p, current_thr);
+		}
+
+		Private_FOS_GroupCharge(p, thr, thr_dt_us);    // and so do all the threads of its group
+	}
+
+	Private_FOS_TtProc(p);    // slot boundaries of the time-triggered table
+
+	/*
+	 * Choose next thread: the thread of the running slot, the one the time slice is handed to or by the scheduler
+	 */
+	int16_t next_thr = Private_FOS_TtGetThread(p);
+	if(next_thr < 0)
+	{
+		next_thr = Private_FOS_GroupProc(p, FOS_Schedule(&p->sheduler, v->current_thr));
+		next_thr = Private_FOS_GetYieldTarget(p, thr_dt_us, next_thr);
+	}
+	if(next_thr < 0)
+		return next_thr;
+
+	Private_FOS_SwitchThread(p, thr, next_thr);
+
+	return next_thr;
+}
+
+
+// switch from the current thread to the next one (only the hot table is touched, not the thread descriptors)
+static void Private_FOS_SwitchThread(fos_t *p, fos_thread_t *thr, int16_t next_thr)
+{
+	fos_var_t* v = &p->var;
+
+	fos_thread_hot_t *h = &v->thread_hot_list[v->current_thr];
+	if(thr)
+	{
+		if(h->state == FOS__THREAD_RUNNING)                       // if current thread is RUNNING (it can be BLOCKED)
+			h->state = FOS__THREAD_READY;                         // assign this thread state READY
+	}
+
+
+	if(FOS_GetThreadDesc(p, (fos_id_t)next_thr) == NULL)          // check for next thread existence (redundant!!!)
 		return;
 
-	if(p->var.fos_sw == FOS__DISABLE)
+	v->current_thr = (fos_id_t)next_thr;                          // assign the index of the next thread as the index of the running thread
+	v->thread_hot_list[next_thr].state = FOS__THREAD_RUNNING;     // assign this thread state RUNNING
+
+	Private_FOS_LoadUserSP(p);                      // load the stack of user defined thread
+}
+
+
+// save the stack of user defined thread
+static void Private_FOS_SaveUserSP(fos_t *p)
+{
+	fos_thread_hot_t* h = &p->var.thread_hot_list[p->var.current_thr];
+	h->sp = fos_mgv.user_sp;
+	h->sched_lock_cnt = fos_mgv.sched_lock_cnt;    // the scheduler lock belongs to the thread
+}
+
+
+// load the stack of user defined thread
+static void Private_FOS_LoadUserSP(fos_t *p)
+{
+	fos_thread_hot_t* h = &p->var.thread_hot_list[p->var.current_thr];
+	fos_mgv.user_sp = h->sp;
+	fos_mgv.sched_lock_cnt = h->sched_lock_cnt;
+}
+
+
+// make user descriptor of the object in the table slot
+// the generation of the slot changes each time the slot is freed, so a descriptor of a deleted object
+// does not match the object in the slot until the slot itself is reused 65535 times
+static user_desc_t Private_FOS_MakeUserDesc(fos_idmap_t *map, fos_id_t slot)
+{
+	return FOS_USER_DESC(FOS_IdMap_GetGen(map, slot), slot);    // generation is never 0, as FOS_WRONG_USER_DESC and FOS_KERNEL_USER_DESC
+}
+
+
+// update maximum index of thread descriptor table
+static void Private_FOS_UpdThreadMaxInd(fos_t *p)
+{
+	p->var.thread_max_ind = FOS_IdMap_GetMaxInd(&p->var.thread_idmap);    // the free slot table keeps the maximum index
+}
+
+
+// update maximum index of binary semaphore descriptor table
+static void Private_FOS_UpdSemBinaryMaxInd(fos_t *p)
+{
+	p->var.semb_max_ind = FOS_IdMap_GetMaxInd(&p->var.semb_idmap);    // the free slot table keeps the maximum index
+}
+
+
+// update maximum index of counting semaphore descriptor table
+static void Private_FOS_UpdSemCntMaxInd(fos_t *p)
+{
+	p->var.semc_max_ind = FOS_IdMap_GetMaxInd(&p->var.semc_idmap);    // the free slot table keeps the maximum index
+}
+
+
+// update maximum index of queue32 descriptor table
+static void Private_FOS_UpdQueue32MaxInd(fos_t *p)
+{
+	p->var.queue32_max_ind = FOS_IdMap_GetMaxInd(&p->var.queue32_idmap);    // the free slot table keeps the maximum index
+}
+
+
+// update maximum index of writer object descriptor table
+static void Private_FOS_UpdFWriterMaxInd(fos_t *p)
+{
+	p->var.fwriter_max_id = FOS_IdMap_GetMaxInd(&p->var.fwriter_idmap);    // the free slot table keeps the maximum index
+}
+
+
+// update maximum index of mutex descriptor table
+static void Private_FOS_UpdMutexMaxInd(fos_t *p)
+{
+	p->var.mutex_max_ind = FOS_IdMap_GetMaxInd(&p->var.mutex_idmap);    // the free slot table keeps the maximum index
+}
+
+
+// recompute thread priority from its own priority, the ceilings of its mutexes and the priorities of the threads waiting for them
+// returns FOS__ENABLE if the priority has changed
+static fos_sw_t Private_FOS_UpdThreadPriority(fos_t *p, fos_id_t id, fos_thread_t *thr)
+{
+	fos_mutex_t *mtx;
+	uint8_t pr = thr->var.base_priotity;
+
+	// only the mutexes the thread holds, the highest waiter of each is the first in its queue
+	for(fos_id_t i = thr->var.mutex_held; i != FOS_WRONG_MUTEX_ID; i = mtx->next_held)
+	{
+		mtx = FOS_GetMutexDesc(p, i);
+		if(mtx == NULL)
+			break;
+
+		if(FOS_Mutex_GetCeiling(mtx) < pr)
+			pr = FOS_Mutex_GetCeiling(mtx);
+
+		if(FOS_Mutex_GetWaitPriority(mtx) < pr)
+			pr = FOS_Mutex_GetWaitPriority(mtx);
+	}
+
+	if(thr->hot->priotity == pr)
+		return FOS__DISABLE;
+
+	thr->hot->priotity = pr;
+	FOS_Schedule_UpdThread(&p->sheduler, id, thr);    // move the thread to the list of its new priority
+
+	// the thread keeps its place by priority in the queue of the mutex it waits for
+	if(thr->var.mutex_wait != FOS_WRONG_MUTEX_ID)
+		FOS_Mutex_SetWaitPriority(FOS_GetMutexDesc(p, thr->var.mutex_wait), id, Private_FOS_GetWaitPriority(thr));
+
+	return FOS__ENABLE;
+}
+
+
+// priority the thread waits for a mutex with
+static uint8_t Private_FOS_GetWaitPriority(fos_thread_t *thr)
+{
+	return FOS_Thread_IsPeriodic(thr) ? FOS_EDF_PRIORITY : thr->hot->priotity;
+}
+
+
+// add the mutex to the list of the mutexes held by the thread
+static void Private_FOS_MutexHold(fos_t *p, fos_thread_t *thr, fos_id_t mutex_id)
+{
+	fos_mutex_t *mtx = FOS_GetMutexDesc(p, mutex_id);
+	if((thr == NULL) || (mtx == NULL))
 		return;
 
-	Private_FOS_TerminatingThreadProc(p);       // terminating thread procedure
+	mtx->next_held = thr->var.mutex_held;
+	thr->var.mutex_held = mutex_id;
+}
+
+
+// remove the mutex from the list of the mutexes held by the thread
+static void Private_FOS_MutexRelease(fos_t *p, fos_thread_t *thr, fos_id_t mutex_id)
+{
+	fos_mutex_t *mtx = FOS_GetMutexDesc(p, mutex_id);
+	if((thr == NULL) || (mtx == NULL))
+		return;
+
+	// the list is as long as the nesting of the mutexes
+	if(thr->var.mutex_held == mutex_id)
+	{
+		thr->var.mutex_held = mtx->next_held;
+	}else
+	{
+		fos_mutex_t *prev;
+		for(fos_id_t i = thr->var.mutex_held; i != FOS_WRONG_MUTEX_ID; i = prev->next_held)
+		{
+			prev = FOS_GetMutexDesc(p, i);
+			if(prev == NULL)
+				break;
+
+			if(prev->next_held == mutex_id)
+			{
+				prev->next_held = mtx->next_held;
+				break;
+			}
+		}
+	}
+
+	mtx->next_held = FOS_WRONG_MUTEX_ID;
+}
+
+
+// pass priority along the chain of mutex owners
+static void Private_FOS_InheritPriority(fos_t *p, fos_id_t mutex_id)
+{
+	fos_thread_t *owner;
+	fos_id_t owner_id;
+
+	// the chain length is limited by the thread count in case of a deadlock loop
+	for(fos_id_t i = 0; i < FOS_MAX_THR_CNT; i++)
+	{
+		owner_id = FOS_Mutex_GetOwner(FOS_GetMutexDesc(p, mutex_id));
+		owner    = FOS_GetThreadDesc(p, owner_id);
+		if(owner == NULL)
+			return;
+
+		// if the owner priority has not changed the rest of the chain is up to date
+		if(Private_FOS_UpdThreadPriority(p, owner_id, owner) == FOS__DISABLE)
+			return;
+
+		mutex_id = owner->var.mutex_wait;      // the owner may wait for another mutex itself
+	}
+}
+
+
+// the new mutex owner stops waiting and inherits priority of the rest of the waiting threads
+static void Private_FOS_UpdMutexOwner(fos_t *p, fos_id_t mutex_id)
+{
+	fos_thread_t *thr = FOS_GetThreadDesc(p, FOS_Mutex_GetOwner(FOS_GetMutexDesc(p, mutex_id)));
+	if(thr == NULL)
+		return;
+
+	thr->var.mutex_wait = FOS_WRONG_MUTEX_ID;
+	Private_FOS_MutexHold(p, thr, mutex_id);
+	Private_FOS_InheritPriority(p, mutex_id);
+}
+
+
+// get shared stack of the run-to-completion thread
+static volatile fos_rtc_stack_t* Private_FOS_GetThreadRtcStack(fos_t *p, fos_thread_t *thr)
+{
+	if(!FOS_Thread_IsRtc(thr))
+		return NULL;
+
+	// the thread is created on the stack of its own priority, the address tells that the stack is the same
+	uint8_t i = thr->var.base_priotity;
+	if(i >= FOS_PRIORITY_CNT)
+		i = FOS_PRIORITY_CNT - 1;
+
+	if(p->var.rtc_stack[i].base_sp && (p->var.rtc_stack[i].base_sp == thr->cset.base_sp))
+		return &p->var.rtc_stack[i];
+
+	return NULL;
+}
+
+
+// start the next job on the free shared stack
+// returns identifier of the thread that has started its job or FOS_WRONG_THREAD_ID
+static fos_id_t Private_FOS_RtcStackProc(fos_t *p, volatile fos_rtc_stack_t *st)
+{
+	fos_thread_t *thr;
+	fos_id_t id;
+
+	if((st == NULL) || (st->owner != FOS_WRONG_THREAD_ID))
+		return FOS_WRONG_THREAD_ID;
+
+	// activated threads get the stack in the order of activation
+	while((id = st->wait_first) != FOS_WRONG_THREAD_ID)
+	{
+		thr = FOS_GetThreadDesc(p, id);
+		if(thr == NULL)                                       // the queue is broken, the threads queue up again on activation
+		{
+			st->wait_first = FOS_WRONG_THREAD_ID;
+			st->wait_last  = FOS_WRONG_THREAD_ID;
+			break;
+		}
+
+		Private_FOS_RtcStackUnwait(p, st, id, thr);
+		if(FOS_Thread_StartRtcJob(thr) != FOS__OK)            // the thread is stopped, it queues up again on activation
+			continue;
+
+		st->owner = id;
+		if(thr->var.act_cnt)                                  // the next job of the thread waits behind the others
+			Private_FOS_RtcStackWait(p, st, id, thr);
+
+		FOS_Schedule_UpdThread(&p->sheduler, id, thr);        // put the thread into the ready queue
+		return id;
+	}
+
+	return FOS_WRONG_THREAD_ID;
+}
+
+
+// put the thread with an activated job into the queue of its shared stack
+static void Private_FOS_RtcStackWait(fos_t *p, volatile fos_rtc_stack_t *st, fos_id_t id, fos_thread_t *thr)
+{
+	if((st == NULL) || (thr == NULL) || thr->var.rtc_wait_sw)
+		return;
+
+	thr->var.rtc_next = FOS_WRONG_THREAD_ID;
+	if(st->wait_first == FOS_WRONG_THREAD_ID)
+		st->wait_first = id;
+	else
+		FOS_GetThreadDesc(p, st->wait_last)->var.rtc_next = id;
+	st->wait_last = id;
+
+	thr->var.rtc_wait_sw = FOS__ENABLE;
+}
+
+
+// remove the thread from the queue of its shared stack
+static void Private_FOS_RtcStackUnwait(fos_t *p, volatile fos_rtc_stack_t *st, fos_id_t id, fos_thread_t *thr)
+{
+	if((st == NULL) || (thr == NULL) || !thr->var.rtc_wait_sw)
+		return;
+
+	fos_thread_t *prev;
+	fos_id_t prev_id = FOS_WRONG_THREAD_ID;
+	fos_id_t i = st->wait_first;
+
+	// the queue holds only the threads of one priority with activated jobs
+	while((i != id) && (i != FOS_WRONG_THREAD_ID))
+	{
+		prev = FOS_GetThreadDesc(p, i);
+		if(prev == NULL)
+			break;
+
+		prev_id = i;
+		i = prev->var.rtc_next;
+	}
+
+	if(i == id)
+	{
+		if(prev_id == FOS_WRONG_THREAD_ID)
+			st->wait_first = thr->var.rtc_next;
+		else
+			FOS_GetThreadDesc(p, prev_id)->var.rtc_next = thr->var.rtc_next;
+
+		if(st->wait_last == id)
+			st->wait_last = prev_id;
+	}
+
+	thr->var.rtc_next    = FOS_WRONG_THREAD_ID;
+	thr->var.rtc_wait_sw = FOS__DISABLE;
+}
+
+
+// the run-to-completion thread that has completed its job passes the shared stack on
+static void Private_FOS_RtcStackRelease(fos_t *p, fos_id_t id, fos_thread_t *thr)
+{
+	volatile fos_rtc_stack_t *st = Private_FOS_GetThreadRtcStack(p, thr);
+
+	if((st == NULL) || (st->owner != id))
+		return;
+
+	// the job is running or waiting, the stack is in use
+	if((thr->hot->mode == FOS__THREAD_RUN) && (thr->hot->state != FOS__THREAD_SUSPEND))
+		return;
+
+	st->owner = FOS_WRONG_THREAD_ID;
+	Private_FOS_RtcStackProc(p, st);
+}
+
+
+// terminating thread procedure
+static void Private_FOS_TerminatingThreadProc(fos_t *p)
+{
+	fos_thread_t     *thr;
+	fos_thread_var_t *v;
+	uint8_t max_upd_needed = 0;
+
+	for(fos_id_t i = 0; i <= p->var.thread_max_ind; i++)
+	{
+		// get thread descriptor by identifier
+		thr = FOS_GetThreadDesc(p, i);
+		if(thr)
+		{
+			v = &thr->var;
+
+			if(thr->hot->mode == FOS__THREAD_TERMINATING)
+			{
+				FOS_SemBinaryDelete(p, thr->cset.semb);
+				Private_FOS_UnlinkThread(p, i);
+				thr->hot->mode = FOS__THREAD_TERMINATED;
+			}
+
+			if((thr->hot->mode == FOS__THREAD_TERMINATED) && (v->static_flag == FOS__DISABLE))
+			{
+				if(FOS_Thread_IsRtc(thr))           // the shared stack is not freed
+					thr->cset.base_sp = 0;
+
+				if(thr->cset.base_sp)
+				{
+					if(Private_FOS_AddOjectToDelList(p, thr->cset.base_sp, FOS_THREADS_HEAP_ID) == FOS__OK)
+						thr->cset.base_sp = 0;
+					else
+						continue;
+				}
+
+				if(Private_FOS_AddOjectToDelList(p, (uint32_t)thr, FOS_KERNEL_HEAP_ID) == FOS__OK)
+				{
+					p->var.thread_desc_list[i] = NULL;
+					FOS_IdMap_Free(&p->var.thread_idmap, i);
+					FOS_Thread_BindHot(thr, NULL);
+					memset(&p->var.thread_hot_list[i], 0, sizeof(fos_thread_hot_t));    // a free entry is never ready
+					FOS_Schedule_UpdThread(&p->sheduler, i, NULL);    // make sure the thread is out of the ready queue
+					FOS_TQueue_Remove(&p->tqueue, i);                 // and out of the timer queue
+					max_upd_needed = 1;
+				}
+			}
+		}
+	}
+
+	if(max_upd_needed)
+		Private_FOS_UpdThreadMaxInd(p);        // update maximum index
+}
+
+
+
+// unlink thread from the blocker object it waits on, whatever the object is:
+// binary or counting semaphore, queue32 or mutex
+static void Private_FOS_UnlinkWaitingThread(fos_t *p, fos_id_t thr_id, fos_thread_t *thr)
+{
+	if(FOS_Lock_UnlinkWaitingThread(p->var.lock_node, thr_id) != FOS__OK)
+		return;
+
+	if((thr != NULL) && (thr->var.mutex_wait != FOS_WRONG_MUTEX_ID))
+	{
+		fos_id_t mutex_id = thr->var.mutex_wait;
+		thr->var.mutex_wait = FOS_WRONG_MUTEX_ID;
+		Private_FOS_InheritPriority(p, mutex_id);    // the owner loses the priority of the thread
+	}
+}
+
+
+// unlink thread from all locking objects
+static void Private_FOS_UnlinkThread(fos_t *p, fos_id_t thr_id)
+{
+	fos_thread_t *thr = FOS_GetThreadDesc(p, thr_id);
+	fos_mutex_t *mtx;
+
+	/*
+	 * Unlink thread from the blocker object it waits on
+	 */
+	Private_FOS_UnlinkWaitingThread(p, thr_id, thr);
+
+	/*
+	 * Release the mutexes the thread owns
+	 */
+	while(thr && (thr->var.mutex_held != FOS_WRONG_MUTEX_ID))
+	{
+		fos_id_t i = thr->var.mutex_held;
+		mtx = FOS_GetMutexDesc(p, i);
+		if(mtx == NULL)                                   // a held mutex cannot be deleted
+		{
+			thr->var.mutex_held = FOS_WRONG_MUTEX_ID;
+			break;
+		}
 
-	FOS_ThreadProcDbg(&p->sys_stack_dbg, 0);    // kernel stack debug
+		FOS_Mutex_Give(mtx, thr_id);
+		Private_FOS_MutexRelease(p, thr, i);
+		Private_FOS_UpdMutexOwner(p, i);
+	}
 
 	/*
-	 * Handle states of all the threads
+	 * Pass the shared stack of run-to-completion thread on
 	 */
-	FOS_AllThreadProcState(p->var.thread_desc_list, p->var.thread_max_ind);
+	Private_FOS_RtcStackUnwait(p, Private_FOS_GetThreadRtcStack(p, thr), thr_id, thr);
+	Private_FOS_RtcStackRelease(p, thr_id, thr);
 
 	/*
-	 * Handle states of all the sem
+	 * Release the threads exchanging messages with the thread
 	 */
-	FOS_AllSemaphoreBinary_ProcTimeout(p->var.semb_desc_list, p->var.semb_max_ind);
-	FOS_AllSemaphoreCnt_ProcTimeout(p->var.semc_desc_list, p->var.semc_max_ind);
+	Private_FOS_IpcUnlink(p, thr_id);
 
-	if(Private_FOS_Sheduler(p) < 0)          // thread scheduler
-		return;
-	FOS_System_GoToUserMode();                 // switch to user mode
+	/*
+	 * The slots of the thread in the time-triggered table stay idle
+	 */
+	FOS_TT_RemoveThread(&p->var.tt, thr_id);
 }
 
 
-// OS kernel intialization
-static void Private_FOS_Core_Init(fos_t *p)
+// update thread position in the timer queue
+static void Private_FOS_UpdThreadTimer(fos_t *p, fos_id_t id)
 {
-	memset(&p->var, 0, sizeof(fos_var_t));
-	memset(&p->sheduler, 0, sizeof(fos_scheduler_t));
-	memset(&p->sys_stack_dbg, 0 , sizeof(fos_thread_dbg_t));
+	fos_thread_hot_t *h = &p->var.thread_hot_list[id];
+
+	// only a running thread blocked for a finite time waits for the timer
+	if((h->mode == FOS__THREAD_RUN) && (h->state == FOS__THREAD_BLOCKED) && (h->wake_up_time != 0) && (!h->lock_flag))
+	{
+		/*
+		 * Keys of the timer queue are the low 32 bits of the kernel time in us,
+		 * a farther wake-up is queued at the edge of the key range and re-armed from there
+		 */
+		fos_time_t key = FOS_Time_GetUs() + FOS_TIME_MAX_AHEAD_US;
+		if(h->wake_up_time < key)
+			key = h->wake_up_time;
+
+		FOS_TQueue_Insert(&p->tqueue, id, (uint32_t)key);
+	}else
+		FOS_TQueue_Remove(&p->tqueue, id);
 }
 
 
-// thread scheduler
-static int16_t Private_FOS_Sheduler(fos_t *p)
+// handle semaphore timeouts and wake up the threads whose wake-up time has come
+static void Private_FOS_WakeUpProc(fos_t *p)
 {
-	fos_var_t* v = &p->var;
-
-	// acquisition of current thread statistics
-	uint8_t  current_thr = v->current_thr;
-	uint32_t thr_dt_us   = fos_mgv.thr_dt_us;
-	FOS_ScheduleDbg(&p->sheduler, v->thread_max_ind, current_thr, thr_dt_us);
+	fos_thread_t *thr;
+	int16_t id;
 
 	/*
-	 * Choose next thread
+	 * Handle states of all the sem
 	 */
-	int16_t next_thr = FOS_Schedule(&p->sheduler, v->thread_desc_list, v->thread_max_ind);
-	if(next_thr < 0)
-		return next_thr;
-
-
+	FOS_AllSemaphoreBinary_ProcTimeout(p->var.semb_desc_list, p->var.semb_max_ind);
+	FOS_AllSemaphoreCnt_ProcTimeout(p->var.semc_desc_list, p->var.semc_max_ind);
 
 	/*
-	 * Switch threads
+	 * Wake up the threads whose wake-up time has come
 	 */
-	fos_thread_ptr thr = FOS_GetThreadDesc(p, v->current_thr);    // get current thread descrpitor
-	if(thr)                                                       // check for its existence
+	while((id = FOS_TQueue_PopExpired(&p->tqueue, (uint32_t)FOS_Time_GetUs())) >= 0)
 	{
-		Private_FOS_SaveUserSP(p);                                // save stack of user defined thread
-
-		if(thr->var.state == FOS__THREAD_RUNNING)                 // if current thread is RUNNING (it can be BLOCKED)
-			thr->var.state = FOS__THREAD_READY;                   // assign this thread state READY
+		thr = FOS_GetThreadDesc(p, (fos_id_t)id);
+		if(FOS_ThreadProcState(thr) == FOS__ENABLE)                  // if the thread became READY
+			FOS_Schedule_UpdThread(&p->sheduler, (fos_id_t)id, thr); // put it into the ready queue
+		else if(thr)
+			Private_FOS_UpdThreadTimer(p, (fos_id_t)id);             // a long sleep is re-armed
 	}
+}
 
 
-	thr = FOS_GetThreadDesc(p, (uint8_t)next_thr);  // get next thread descriptor
-	if(thr == NULL)                                 // check for its existence (redundant!!!)
-		return next_thr;
+// check if the ready thread must preempt the current thread
+static fos_sw_t Private_FOS_IsPreemptNeeded(fos_t *p, fos_thread_t *thr)
+{
+	fos_thread_t *cur;
 
-	v->current_thr = (uint8_t)next_thr;             // assign the index of the next thread as the index of the running thread
-	thr->var.state = FOS__THREAD_RUNNING;           // assign this thread state RUNNING
+	if(thr->hot->state != FOS__THREAD_READY)
+		return FOS__DISABLE;
 
-	Private_FOS_LoadUserSP(p);                      // load the stack of user defined thread
+	cur = FOS_GetThreadDesc(p, p->var.current_thr);
 
-	return next_thr;
+	return FOS_Schedule_IsPreempting(&p->sheduler, thr, cur);
 }
 
 
-// save the stack of user defined thread
-static void Private_FOS_SaveUserSP(fos_t *p)
+// check if the thread waking up will preempt the current thread (filter of the timer queue)
+static fos_sw_t Private_FOS_IsWakeUpPreempting(void *ctx, fos_id_t id)
 {
-	fos_thread_t* tp = p->var.thread_desc_list[p->var.current_thr];
-	tp->var.sp = fos_mgv.user_sp;
-}
+	fos_t *p = (fos_t*)ctx;
+	fos_thread_t *thr = FOS_GetThreadDesc(p, id);
+	fos_thread_t *cur = FOS_GetThreadDesc(p, p->var.current_thr);
 
+	// a stale entry or no current thread: the timer fires at the wake-up anyway
+	if((thr == NULL) || (cur == NULL))
+		return FOS__ENABLE;
 
-// load the stack of user defined thread
-static void Private_FOS_LoadUserSP(fos_t *p)
-{
-	fos_thread_t* tp = p->var.thread_desc_list[p->var.current_thr];
-	fos_mgv.user_sp = tp->var.sp;
+	return FOS_Schedule_IsPreempting(&p->sheduler, thr, cur);
 }
 
 
-// generate unique user descriptor
-static user_desc_t Private_FOS_GenUserDesc(fos_t *p)
+// get the time to the nearest wake-up of threads and semaphore timeouts (if sem_sw), us
+static fos_ret_t Private_FOS_GetTimeToExpiry(fos_t *p, fos_sw_t sem_sw, uint32_t *dt_us)
 {
-	p->var.last_user_desc++;
-	while((p->var.last_user_desc == FOS_KERNEL_USER_DESC) || (p->var.last_user_desc == FOS_WRONG_USER_DESC))
-		p->var.last_user_desc++;
-	return p->var.last_user_desc;
-}
+	fos_ret_t ret;
+	uint32_t now_us = (uint32_t)FOS_Time_GetUs();
+	uint32_t expiry;
+	uint32_t sem_dt_us;
+	int32_t  dt;
 
+	/*
+	 * The timer fires at the earliest wake-up of a thread that outranks the current one,
+	 * the other wake-ups due by then are released in the same pass or at the end of the slice:
+	 * an early expiry would cost the current thread the rest of its quantum and its turn in the round-robin;
+	 * the idle thread, the only ready one, gives way to any thread;
+	 * in tickless idle mode nearby wake-ups are served by one timer interrupt
+	 */
+	if(sem_sw)
+		ret = FOS_TQueue_GetNextExpiryCoalesced(&p->tqueue, &expiry, FOS_TICKLESS_COALESCE_US);
+	else if(p->sheduler.ready_thr_cnt <= 1)
+		ret = FOS_TQueue_GetNextExpiry(&p->tqueue, &expiry);
+	else
+		ret = FOS_TQueue_GetNextExpiryFiltered(&p->tqueue, Private_FOS_IsWakeUpPreempting, p, &expiry);
+	if(ret == FOS__OK)
+	{
+		dt = (int32_t)(expiry - now_us);
+		*dt_us = (dt > 0) ? (uint32_t)dt : 0;
+	}
 
-// update maximum index of thread descriptor table
-static void Private_FOS_UpdThreadMaxInd(fos_t *p)
-{
-	uint8_t ind = 0;
+	// semaphore timeouts are counted on the same time base and are checked on each kernel pass anyway
+	if(!sem_sw)
+		return ret;
 
-	// calculate maximum index
-	for(uint8_t i = 0; i < FOS_MAX_THR_CNT; i++)
-		if(p->var.thread_desc_list[i] != NULL)
-			ind = i;
+	if((Private_FOS_GetTimeToSemTimeout(p, now_us, &sem_dt_us) == FOS__OK) && ((ret != FOS__OK) || (sem_dt_us < *dt_us)))
+	{
+		*dt_us = sem_dt_us;
+		ret = FOS__OK;
+	}
 
-	p->var.thread_max_ind = ind;               // record the maximum index into a variable
+	return ret;
 }
 
 
-// update maximum index of binary semaphore descriptor table
-static void Private_FOS_UpdSemBinaryMaxInd(fos_t *p)
+// get the time to the nearest semaphore timeout, us (FOS__FAIL - no timeout is pending)
+static fos_ret_t Private_FOS_GetTimeToSemTimeout(fos_t *p, uint32_t now_us, uint32_t *dt_us)
 {
-	uint8_t ind = 0;
-
-	// calculate maximum index
-	for(uint8_t i = 0; i < FOS_SEM_BIN_CNT; i++)
-		if(p->var.semb_desc_list[i] != NULL)
-			ind = i;
-
-	p->var.semb_max_ind = ind;                // record the maximum index into a variable
-}
-
+	fos_ret_t ret = FOS__FAIL;
+	uint32_t ts;
+	int32_t  dt;
 
-// update maximum index of counting semaphore descriptor table
-static void Private_FOS_UpdSemCntMaxInd(fos_t *p)
-{
-	uint8_t ind = 0;
+	for(fos_id_t i = 0; i <= p->var.semb_max_ind; i++)
+	{
+		if(FOS_SemaphoreBinary_GetTimeoutTs(FOS_GetSemaphoreBinaryDesc(p, i), &ts) == FOS__OK)
+		{
+			dt = (int32_t)(ts - now_us);
+			dt = (dt > 0) ? dt : 0;
+			if((ret != FOS__OK) || ((uint32_t)dt < *dt_us))
+				*dt_us = (uint32_t)dt;
+			ret = FOS__OK;
+		}
+	}
 
-	// calculate maximum index
-	for(uint8_t i = 0; i < FOS_SEM_COUNTING_CNT; i++)
-		if(p->var.semc_desc_list[i] != NULL)
-			ind = i;
+	for(fos_id_t i = 0; i <= p->var.semc_max_ind; i++)
+	{
+		if(FOS_SemaphoreCnt_GetTimeoutTs(FOS_GetSemaphoreCntDesc(p, i), &ts) == FOS__OK)
+		{
+			dt = (int32_t)(ts - now_us);
+			dt = (dt > 0) ? dt : 0;
+			if((ret != FOS__OK) || ((uint32_t)dt < *dt_us))
+				*dt_us = (uint32_t)dt;
+			ret = FOS__OK;
+		}
+	}
 
-	p->var.semc_max_ind = ind;                // record the maximum index into a variable
+	return ret;
 }
 
 
-// update maximum index of queue32 descriptor table
-static void Private_FOS_UpdQueue32MaxInd(fos_t *p)
+#if defined(FOS_USE_DIRECT_SWITCH)
+// plan the next housekeeping by the main loop: at the end of the period or at the nearest semaphore timeout
+static void Private_FOS_PlanHousekeeping(fos_t *p)
 {
-	uint8_t ind = 0;
+	uint32_t now_us = (uint32_t)FOS_Time_GetUs();
+	uint32_t dt_us  = FOS_HOUSEKEEPING_PERIOD_MS * 1000;
+	uint32_t sem_dt_us;
 
-	// calculate maximum index
-	for(uint8_t i = 0; i < FOS_SEM_QUEUE_32_CNT; i++)
-		if(p->var.queue32_desc_list[i] != NULL)
-			ind = i;
+	if((Private_FOS_GetTimeToSemTimeout(p, now_us, &sem_dt_us) == FOS__OK) && (sem_dt_us < dt_us))
+		dt_us = sem_dt_us;
 
-	p->var.queue32_max_ind = ind;             // record the maximum index into a variable
+	p->var.housekeeping_due_us = now_us + dt_us;
 }
 
 
-// update maximum index of writer object descriptor table
-static void Private_FOS_UpdFWriterMaxInd(fos_t *p)
+// bring the next housekeeping forward to the semaphore timeout of the thread that has just blocked
+static void Private_FOS_PlanSemTimeout(fos_t *p, fos_ret_t ts_ret, uint32_t ts)
 {
-	uint8_t ind = 0;
+	uint32_t s;
 
-	// calculate maximum index
-	for(uint8_t i = 0; i < FOS_FWRITER_CNT; i++)
-		if(p->var.fwriter_desc_list[i] != NULL)
-			ind = i;
+	if(ts_ret != FOS__OK)    // the semaphore has no timeout or the thread has not blocked
+		return;
 
-	p->var.fwriter_max_id = ind;               // record the maximum index into a variable
+	ENTER_CRITICAL(s);
+	if(!FOS_TIME_AFTER_EQ(ts, p->var.housekeeping_due_us))
+		p->var.housekeeping_due_us = ts;
+	LEAVE_CRITICAL(s);
 }
+#endif
 
 
-// terminating thread procedure
-static void Private_FOS_TerminatingThreadProc(fos_t *p)
+// choose the main timer period for the next thread
+static void Private_FOS_SliceProc(fos_t *p)
 {
-	fos_thread_t     *thr;
-	fos_thread_var_t *v;
-	uint8_t max_upd_needed = 0;
-
-	for(uint8_t i = 0; i <= p->var.thread_max_ind; i++)
-	{
-		// get thread descriptor by identifier
-		thr = FOS_GetThreadDesc(p, i);
-		if(thr)
-		{
-			v = &thr->var;
-
-			if(v->mode == FOS__THREAD_TERMINATING)
-			{
-				FOS_SemBinaryDelete(p, thr->cset.semb);
-				Private_FOS_UnlinkThread(p, i);
-				v->mode = FOS__THREAD_TERMINATED;
-			}
+	fos_thread_t *thr = FOS_GetThreadDesc(p, p->var.current_thr);
+	uint32_t base_us  = fos_mgv.time_period_us;
 
-			if((v->mode == FOS__THREAD_TERMINATED) && (v->static_flag == FOS__DISABLE))
-			{
-				if(thr->cset.base_sp)
-				{
-					if(Private_FOS_AddOjectToDelList(p, thr->cset.base_sp, FOS_THREADS_HEAP_ID) == FOS__OK)
-						thr->cset.base_sp = 0;
-					else
-						continue;
-				}
+	// the thread's own time slice
+	if(thr && thr->set.quantum_us)
+		base_us = thr->set.quantum_us;
 
-				if(Private_FOS_AddOjectToDelList(p, (uint32_t)thr, FOS_KERNEL_HEAP_ID) == FOS__OK)
-				{
-					p->var.thread_desc_list[i] = NULL;
-					max_upd_needed = 1;
-				}
-			}
-		}
+	// or the rest of the time slice handed to the thread
+	if(p->var.yield_slice_us)
+	{
+		base_us = p->var.yield_slice_us;
+		p->var.yield_slice_us = 0;
 	}
 
-	if(max_upd_needed)
-		Private_FOS_UpdThreadMaxInd(p);        // update maximum index
-}
-
+	// the slice does not exceed the rest of the thread and group CPU budgets
+	uint32_t budget_us = FOS_Thread_GetBudgetLeft(thr);
+	uint32_t group_us  = FOS_Group_GetBudgetLeft(Private_FOS_GetThreadGroup(p, thr));
+	if(group_us < budget_us)
+		budget_us = group_us;
+	if(budget_us < base_us)
+		base_us = (budget_us > FOS_MIN_TIM_PERIOD_US) ? budget_us : FOS_MIN_TIM_PERIOD_US;
 
+	uint32_t slice_us    = base_us;
+	fos_sw_t idle_sw     = FOS__DISABLE;
+	uint32_t dt_us;
 
-// unlink thread from all locking objects
-static void Private_FOS_UnlinkThread(fos_t *p, uint8_t thr_id)
-{
-	fos_semaphore_binary_t *semb;
+#if defined(FOS_USE_TICKLESS_IDLE)
+	/*
+	 * The idle thread is always ready, so if it is the only ready thread
+	 * there is nothing to switch to until the nearest wake-up
+	 */
+	if(p->sheduler.ready_thr_cnt <= 1)
+	{
+		slice_us = FOS_TICKLESS_MAX_US;
+		idle_sw  = FOS__ENABLE;
+	}
+#endif
 
 	/*
-	 * Unlink thread from all binary semaphores
+	 * The main timer works as a one-shot compare at the nearest wake-up that preempts the current thread,
+	 * so a thread sleeping for microseconds is not held up till the end of the slice
 	 */
-	for(uint8_t i = 0; i <= p->var.semb_max_ind; i++)
+	if((Private_FOS_GetTimeToExpiry(p, idle_sw, &dt_us) == FOS__OK) && (dt_us < slice_us))
+		slice_us = (dt_us > FOS_MIN_TIM_PERIOD_US) ? dt_us : FOS_MIN_TIM_PERIOD_US;
+
+#if defined(FOS_USE_TICKLESS_IDLE)
+	p->var.tickless_sw = (slice_us > base_us) ? FOS__ENABLE : FOS__DISABLE;
+#endif
+	fos_mgv.slice_period_us = slice_us;
+
+	// the main timer fires at the nearest slot boundary of the time-triggered table
+	uint32_t tt_us = FOS_TT_GetTimeToEvent(&p->var.tt);
+	if(tt_us < fos_mgv.slice_period_us)
 	{
-		semb = FOS_GetSemaphoreBinaryDesc(p, i);
-		if(semb)
-		{
-			FOS_SemaphoreBinary_UnlinkThread(semb, thr_id);
-		}
+		fos_mgv.slice_period_us = (tt_us > FOS_MIN_TIM_PERIOD_US) ? tt_us : FOS_MIN_TIM_PERIOD_US;
+		if(fos_mgv.slice_period_us <= base_us)
+			p->var.tickless_sw = FOS__DISABLE;
 	}
+
+	// the period must fit the main timer counter
+	if(fos_mgv.slice_period_us > FOS_MAIN_TIM_MAX_US)
+		fos_mgv.slice_period_us = FOS_MAIN_TIM_MAX_US;
 }
 
 
@@ -1243,7 +2914,7 @@ static fos_ret_t Private_FOS_AddOjectToDelList(fos_t *p, uint32_t adr, uint8_t h
  */
 
 // get id of current thread
-/*uint8_t FOS_GetCurrentThreadId(fos_t *p)
+/*fos_id_t FOS_GetCurrentThreadId(fos_t *p)
 {
 	if(p == NULL)
 		return FOS_WRONG_THREAD_ID;
@@ -1253,7 +2924,7 @@ static fos_ret_t Private_FOS_AddOjectToDelList(fos_t *p, uint32_t adr, uint8_t h
 
 
 // wake up thread
-/*fos_ret_t FOS_WeakUpId(fos_t *p, uint8_t id)
+/*fos_ret_t FOS_WeakUpId(fos_t *p, fos_id_t id)
 {
 	if(p == NULL)
 		return FOS__FAIL;
@@ -1276,6 +2947,296 @@ static fos_ret_t Private_FOS_AddOjectToDelList(fos_t *p, uint32_t adr, uint8_t h
 }*/
 
 
+// get the thread the current thread has handed its time slice to, if no ready thread outranks it
+// next_thr - the choice of the scheduler, it is returned if there is no such thread
+static int16_t Private_FOS_GetYieldTarget(fos_t *p, uint32_t thr_dt_us, int16_t next_thr)
+{
+	fos_id_t id = p->var.yield_to;
+	if(id == FOS_EMPTY_ID)
+		return next_thr;
+	p->var.yield_to = FOS_EMPTY_ID;
+
+	// the thread could be blocked or terminated after the time slice was handed to it
+	fos_thread_t *thr = FOS_GetThreadDesc(p, id);
+	if((thr == NULL) || (p->var.thread_hot_list[id].state != FOS__THREAD_READY))
+		return next_thr;
+
+	// the time slice does not lift the cap of the group
+	if(FOS_Group_IsThrottled(Private_FOS_GetThreadGroup(p, thr)))
+		return next_thr;
+
+	// the hand-off does not break the priority order: the choice of the scheduler goes first if it outranks the thread
+	// (the yielding thread itself does not count)
+	if((next_thr >= 0) && (next_thr != p->var.current_thr) &&
+	   FOS_Schedule_IsPreempting(&p->sheduler, FOS_GetThreadDesc(p, (fos_id_t)next_thr), thr))
+		return next_thr;
+
+	// the thread runs for the rest of the time slice of the current thread
+	uint32_t rest_us = (fos_mgv.slice_period_us > thr_dt_us) ? (fos_mgv.slice_period_us - thr_dt_us) : 0;
+	p->var.yield_slice_us = (rest_us > FOS_MIN_TIM_PERIOD_US) ? rest_us : FOS_MIN_TIM_PERIOD_US;
+
+	return id;
+}
+
+
+// copy the message of the sender to the waiting receiver and unblock it
+static void Private_FOS_IpcDeliver(fos_t *p, fos_id_t dst_id, fos_thread_t *dst, fos_id_t src_id, fos_thread_t *src)
+{
+	*dst->ipc.msg_ptr = *src->ipc.msg_ptr;     // the only copy of the message
+
+	dst->ipc.partner = src_id;
+	dst->ipc.ret     = FOS__OK;
+	dst->ipc.state   = FOS_IPC__IDLE;
+
+	FOS_UnlockId(p, dst_id, FOS_LOCK_IPC_FLAG);
+}
+
+
+// remove the sender from the list of the receiver: the send queue (first, last) or the reply list (first, NULL)
+static void Private_FOS_IpcRemoveSender(fos_t *p, volatile fos_id_t *first, volatile fos_id_t *last, fos_id_t src_id)
+{
+	fos_id_t prev_id = FOS_WRONG_THREAD_ID;
+	fos_id_t id = *first;
+
+	for(fos_id_t i = 0; (i < FOS_MAX_THR_CNT) && (id != FOS_WRONG_THREAD_ID); i++)
+	{
+		fos_thread_t *thr = FOS_GetThreadDesc(p, id);
+		if(thr == NULL)
+			return;
+
+		if(id == src_id)
+		{
+			if(prev_id == FOS_WRONG_THREAD_ID)
+				*first = thr->ipc.send_next;
+			else
+				FOS_GetThreadDesc(p, prev_id)->ipc.send_next = thr->ipc.send_next;
+
+			if(last && (*last == src_id))
+				*last = prev_id;
+
+			thr->ipc.send_next = FOS_WRONG_THREAD_ID;
+			return;
+		}
+
+		prev_id = id;
+		id = thr->ipc.send_next;
+	}
+}
+
+
+// release the threads exchanging messages with the thread
+static void Private_FOS_IpcUnlink(fos_t *p, fos_id_t thr_id)
+{
+	fos_thread_t *thr = FOS_GetThreadDesc(p, thr_id);
+	if(thr == NULL)
+		return;
+
+	// the sender leaves the queue of its receiver or the list of the threads waiting for its reply
+	fos_thread_t *dst = FOS_GetThreadDesc(p, thr->ipc.partner);
+	if(dst && (thr->ipc.state == FOS_IPC__SEND_BLOCKED))
+		Private_FOS_IpcRemoveSender(p, &dst->ipc.send_first, &dst->ipc.send_last, thr_id);
+	else if(dst && (thr->ipc.state == FOS_IPC__REPLY_BLOCKED))
+		Private_FOS_IpcRemoveSender(p, &dst->ipc.reply_first, NULL, thr_id);
+	thr->ipc.state = FOS_IPC__IDLE;
+
+	// the threads sending to the thread and waiting for its reply get FOS__FAIL
+	Private_FOS_IpcFailSenders(p, thr_id, thr->ipc.send_first);
+	Private_FOS_IpcFailSenders(p, thr_id, thr->ipc.reply_first);
+
+	thr->ipc.send_first  = FOS_WRONG_THREAD_ID;
+	thr->ipc.send_last   = FOS_WRONG_THREAD_ID;
+	thr->ipc.reply_first = FOS_WRONG_THREAD_ID;
+}
+
+
+// the sender whose message has been received waits for the reply in the reply list of the receiver
+static void Private_FOS_IpcWaitReply(fos_thread_t *dst, fos_id_t src_id, fos_thread_t *src)
+{
+	src->ipc.send_next   = dst->ipc.reply_first;    // the order of the replies is up to the receiver
+	dst->ipc.reply_first = src_id;
+	src->ipc.state       = FOS_IPC__REPLY_BLOCKED;
+}
+
+
+// release the senders of the list of the thread with FOS__FAIL
+static void Private_FOS_IpcFailSenders(fos_t *p, fos_id_t thr_id, fos_id_t first)
+{
+	fos_thread_t *src;
+	fos_id_t id = first;
+
+	for(fos_id_t i = 0; (i < FOS_MAX_THR_CNT) && (id != FOS_WRONG_THREAD_ID); i++)
+	{
+		src = FOS_GetThreadDesc(p, id);
+		if((src == NULL) || (id == thr_id))
+			return;
+
+		fos_id_t next = src->ipc.send_next;
+		src->ipc.send_next = FOS_WRONG_THREAD_ID;
+
+		if((src->ipc.partner == thr_id) && ((src->ipc.state == FOS_IPC__SEND_BLOCKED) || (src->ipc.state == FOS_IPC__REPLY_BLOCKED)))
+		{
+			src->ipc.state = FOS_IPC__IDLE;
+			src->ipc.ret   = FOS__FAIL;
+			FOS_UnlockId(p, id, FOS_LOCK_IPC_FLAG);
+		}
+
+		id = next;
+	}
+}
+
+
+// get the group of the thread (NULL - the thread does not belong to a group)
+static fos_group_t* Private_FOS_GetThreadGroup(fos_t *p, fos_thread_t *thr)
+{
+	if((thr == NULL) || (thr->set.group == FOS_NO_GROUP) || (thr->set.group > FOS_GROUP_CNT))
+		return NULL;
+
+	return &p->var.group[thr->set.group - 1];
+}
+
+
+// charge the run time of the thread to its group, throttle the thread if the group has used up its budget
+// the other ready threads of the group are throttled when the scheduler picks them (see Private_FOS_GroupProc)
+static void Private_FOS_GroupCharge(fos_t *p, fos_thread_t *thr, uint32_t thr_dt_us)
+{
+	fos_group_t *grp = Private_FOS_GetThreadGroup(p, thr);
+	if(FOS_Group_Charge(grp, thr_dt_us) == FOS__DISABLE)
+		return;
+
+	fos_id_t id = p->var.current_thr;
+
+	FOS_Thread_ThrottleUntil(thr, FOS_Group_GetPeriodEnd(grp));
+	FOS_Schedule_UpdThread(&p->sheduler, id, thr);
+	Private_FOS_UpdThreadTimer(p, id);
+}
+
+
+// the thread belongs to a group that has got less than its reserved time (filter of the scheduler)
+static fos_sw_t Private_FOS_IsGroupReserved(void *ctx, fos_id_t id)
+{
+	fos_t *p = (fos_t*)ctx;
+	return FOS_Group_IsReserved(Private_FOS_GetThreadGroup(p, FOS_GetThreadDesc(p, id)));
+}
+
+
+// correct the choice of the scheduler by the group reservations
+static int16_t Private_FOS_GroupProc(fos_t *p, int16_t next_thr)
+{
+	if(p->var.group_sw == FOS__DISABLE)
+		return next_thr;
+
+	fos_thread_t *thr;
+	fos_group_t *grp;
+
+	/*
+	 * The thread that has become ready while its group is throttled waits for the next period too
+	 */
+	for(fos_id_t i = 0; (i < FOS_MAX_THR_CNT) && (next_thr >= 0); i++)
+	{
+		thr = FOS_GetThreadDesc(p, (fos_id_t)next_thr);
+		grp = Private_FOS_GetThreadGroup(p, thr);
+		if(FOS_Group_IsThrottled(grp) == FOS__DISABLE)
+			break;
+
+		FOS_Thread_ThrottleUntil(thr, FOS_Group_GetPeriodEnd(grp));
+		FOS_Schedule_UpdThread(&p->sheduler, (fos_id_t)next_thr, thr);
+		Private_FOS_UpdThreadTimer(p, (fos_id_t)next_thr);
+
+		next_thr = FOS_Schedule(&p->sheduler, p->var.current_thr);
+	}
+
+	if(next_thr < 0)
+		return next_thr;
+
+	/*
+	 * The groups that have got less than their reserved time go first,
+	 * the threads inside them are chosen by the scheduling policy
+	 */
+	if(Private_FOS_IsGroupReserved(p, (fos_id_t)next_thr))
+		return next_thr;
+
+	// the scheduling policy walks only the ready threads, in its own order and round-robin inside a priority
+	int16_t best = FOS_Schedule_Filtered(&p->sheduler, p->var.current_thr, Private_FOS_IsGroupReserved, p);
+
+	return (best >= 0) ? best : next_thr;
+}
+
+
+// release the threads of the time-triggered table at the starts of their slots and stop them at the ends
+static void Private_FOS_TtProc(fos_t *p)
+{
+	fos_tt_t *tt = &p->var.tt;
+	if(FOS_TT_IsRunning(tt) == FOS__DISABLE)
+		return;
+
+	FOS_TT_SetTime(tt, FOS_Time_GetUs());    // the slots are counted from the fixed start of the frame
+
+	fos_tt_event_t ev;
+	fos_thread_t *thr;
+	uint16_t slot;
+	fos_id_t id;
+
+	// the events are handled one by one, the kernel could pass several slot boundaries
+	while((ev = FOS_TT_GetEvent(tt, &slot)) != FOS_TT__NONE)
+	{
+		id  = tt->slot_thr[slot];
+		thr = FOS_GetThreadDesc(p, id);
+
+		if(ev == FOS_TT__SLOT_START)
+		{
+			// the thread that is not waiting for its slot has missed it
+			if((thr == NULL) || !(thr->hot->lock_flag & FOS_LOCK_TT_FLAG))
+			{
+				tt->miss_cnt++;
+				continue;
+			}
+
+			FOS_ThreadUnlock(thr, FOS_LOCK_TT_FLAG);
+		}
+		else
+		{
+			// the job has been completed in time
+			if((thr == NULL) || (thr->hot->lock_flag & FOS_LOCK_TT_FLAG))
+				continue;
+
+			// the overrun job is stopped and goes on in the next slot of the thread
+			tt->overrun_cnt++;
+
+			fos_err_t err = {0};
+			err.err_code    = FOS_ERROR_TT_OVERRUN;
+			err.user_desc   = thr->user_desc;
+			err.ext_str_ptr = "Time-triggered slot overrun\0";
+			FOS_ErrorSet(p, &err);
+
+			FOS_ThreadLock(thr, FOS_LOCK_TT_FLAG);
+		}
+
+		FOS_Schedule_UpdThread(&p->sheduler, id, thr);
+		Private_FOS_UpdThreadTimer(p, id);
+	}
+}
+
+
+// get the ready thread of the running slot of the time-triggered table (-1 - none)
+static int16_t Private_FOS_TtGetThread(fos_t *p)
+{
+	fos_id_t id = FOS_TT_GetActiveThread(&p->var.tt);
+
+	// the slack time of the slot is left to the scheduler
+	fos_thread_t *thr = FOS_GetThreadDesc(p, id);
+	if((thr == NULL) || ((thr->hot->state != FOS__THREAD_READY) && (thr->hot->state != FOS__THREAD_RUNNING)))
+		return -1;
+
+	// the slot does not lift the cap of the group, the thread waits for the next period as the scheduler chooses
+	if(FOS_Group_IsThrottled(Private_FOS_GetThreadGroup(p, thr)))
+		return -1;
+
+	p->var.yield_to = FOS_EMPTY_ID;    // the slot goes ahead of the handed time slice
+
+	return id;
+}
+
+
 
 
 
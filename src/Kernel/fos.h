@@ -26,10 +26,15 @@
 
 #include "System/fos_context.h"
 #include "Thread/fos_scheduler.h"
+#include "Thread/fos_tqueue.h"
+#include "Thread/fos_group.h"
+#include "Thread/fos_tt.h"
 #include "Sync/fos_semb.h"
 #include "Sync/fos_sem.h"
+#include "Sync/fos_mutex.h"
 #include "File/fwriter.h"
 #include "Data/fos_queue32.h"
+#include "Data/fos_idmap.h"
 
 /*
  * A thread is described by index and descriptor
@@ -48,30 +53,75 @@ typedef struct
 } obj_to_del_t;
 
 
+// shared stack of run-to-completion threads of the same priority
+typedef struct
+{
+	uint32_t base_sp;       // stack starting address (0 - not allocated)
+	uint32_t stack_size;    // stack size
+	fos_id_t owner;         // thread whose job is using the stack (FOS_WRONG_THREAD_ID - stack is free)
+	fos_id_t wait_first;    // first thread with an activated job waiting for the stack (FOS_WRONG_THREAD_ID - none)
+	fos_id_t wait_last;     // last thread waiting for the stack
+
+} fos_rtc_stack_t;
+
+
 // OS variables
 typedef struct
 {
 	volatile fos_sw_t       fos_sw;                                    // main OS switch
 
-	volatile uint8_t        current_thr;                               // current thread index
-	volatile uint8_t        thread_max_ind;                            // maximum index of registered thread
+	volatile fos_id_t       current_thr;                               // current thread index
+	volatile fos_id_t       thread_max_ind;                            // maximum index of registered thread
 	volatile fos_thread_ptr thread_desc_list[FOS_MAX_THR_CNT];         // list of thread descriptors
+	fos_thread_hot_t        thread_hot_list[FOS_MAX_THR_CNT];          // hot variables of threads read on each scheduler pass
+	fos_idmap_t             thread_idmap;                              // free slots of thread descriptor list
+	uint32_t                thread_idmap_bits[FOS_IDMAP_SIZE(FOS_MAX_THR_CNT)];
+	fos_lock_node_t         lock_node[FOS_MAX_THR_CNT];                // waiting queue nodes of threads, shared by all blockers of the kernel
 
-	volatile uint8_t                  semb_max_ind;                    // maximum index of registered binary semaphore
+	volatile fos_id_t                 semb_max_ind;                    // maximum index of registered binary semaphore
 	volatile fos_semaphore_binary_ptr semb_desc_list[FOS_SEM_BIN_CNT]; // list of binary semaphore descriptors
+	fos_idmap_t                       semb_idmap;                      // free slots of binary semaphore descriptor list
+	uint32_t                          semb_idmap_bits[FOS_IDMAP_SIZE(FOS_SEM_BIN_CNT)];
 
-	volatile uint8_t               semc_max_ind;                         // maximum index of registered counting semaphore
+	volatile fos_id_t              semc_max_ind;                         // maximum index of registered counting semaphore
 	volatile fos_semaphore_cnt_ptr semc_desc_list[FOS_SEM_COUNTING_CNT]; // list of counting semaphore descriptors
+	fos_idmap_t                    semc_idmap;                           // free slots of counting semaphore descriptor list
+	uint32_t                       semc_idmap_bits[FOS_IDMAP_SIZE(FOS_SEM_COUNTING_CNT)];
+
+	volatile fos_id_t      mutex_max_ind;                              // maximum index of registered mutex
+	volatile fos_mutex_ptr mutex_desc_list[FOS_MUTEX_CNT];             // list of mutex descriptors
+	fos_idmap_t            mutex_idmap;                                // free slots of mutex descriptor list
+	uint32_t               mutex_idmap_bits[FOS_IDMAP_SIZE(FOS_MUTEX_CNT)];
 
-	volatile uint8_t         queue32_max_ind;                         // maximum index of registered queue32
+	volatile fos_rtc_stack_t rtc_stack[FOS_PRIORITY_CNT];              // shared stacks of run-to-completion threads
+
+	fos_group_t      group[FOS_GROUP_CNT];                             // thread groups with CPU reservation (group N is group[N - 1])
+	volatile fos_sw_t group_sw;                                        // at least one group is set
+
+	fos_tt_t         tt;                                               // time-triggered cyclic executive
+
+	volatile fos_id_t        queue32_max_ind;                         // maximum index of registered queue32
 	volatile fos_queue32_ptr queue32_desc_list[FOS_SEM_QUEUE_32_CNT]; // list of queue32 descriptors
+	fos_idmap_t              queue32_idmap;                           // free slots of queue32 descriptor list
+	uint32_t                 queue32_idmap_bits[FOS_IDMAP_SIZE(FOS_SEM_QUEUE_32_CNT)];
 
-	volatile uint8_t     fwriter_max_id;                               // maximum index of registered writer object
+	volatile fos_id_t    fwriter_max_id;                               // maximum index of registered writer object
 	volatile fwriter_ptr fwriter_desc_list[FOS_FWRITER_CNT];           // list of writer object descriptors
+	fos_idmap_t          fwriter_idmap;                                // free slots of writer object descriptor list
+	uint32_t             fwriter_idmap_bits[FOS_IDMAP_SIZE(FOS_FWRITER_CNT)];
 
 	volatile fos_err_t   error;                                        // identified error
 
-	volatile user_desc_t last_user_desc;                               // last used user desсriptor
+
+	volatile uint32_t dbg_ts;                                          // timestamp of the last thread stack check
+
+	volatile fos_sw_t tickless_sw;                                     // tickless idle mode is active
+
+	volatile fos_id_t yield_to;                                        // thread the current thread hands its time slice to (FOS_EMPTY_ID - none)
+	volatile uint32_t yield_slice_us;                                  // rest of the time slice handed to the next thread, us (0 - none)
+
+	volatile fos_sw_t housekeeping_sw;                                 // housekeeping by the main loop is required
+	volatile uint32_t housekeeping_due_us;                             // time of the next housekeeping, us
 
 	volatile uint8_t  obj_to_del_cnt;                                  // count objects to delete
 	volatile obj_to_del_t obj_to_del[FOS_MAX_OBJ_TO_DEL];              // list of addres of objects to delete
@@ -83,6 +133,7 @@ typedef struct
 {
 	fos_var_t        var;               // variables
 	fos_scheduler_t  sheduler;          // scheduler
+	fos_tqueue_t     tqueue;            // timer queue of sleeping threads
 	fos_thread_dbg_t sys_stack_dbg;     // system stack debug
 
 } fos_t;
@@ -95,19 +146,19 @@ void FOS_Init(fos_t *p);
 fos_ret_t FOS_Start(fos_t *p);
 
 // get thread identifier by user defined descriptor
-uint8_t FOS_GetUdThreadId(fos_t *p, user_desc_t user_desc);
+fos_id_t FOS_GetUdThreadId(fos_t *p, user_desc_t user_desc);
 
 // get semaphore binary user descriptor by thread ID
-user_desc_t FOS_GetThreadSembId(fos_t *p, uint8_t id);
+user_desc_t FOS_GetThreadSembId(fos_t *p, fos_id_t id);
 
 // thread registration
 fos_ret_t FOS_ThreadReg(fos_t *p, fos_thread_t *thr);
 
 // start thread with identifier
-fos_ret_t FOS_RunId(fos_t *p, uint8_t id);
+fos_ret_t FOS_RunId(fos_t *p, fos_id_t id);
 
 // terminate thread with identifier
-fos_ret_t FOS_TerminateId(fos_t *p, uint8_t id, int32_t terminate_code);
+fos_ret_t FOS_TerminateId(fos_t *p, fos_id_t id, int32_t terminate_code);
 
 // terminate current thread
 fos_ret_t FOS_Terminate(fos_t *p, int32_t terminate_code);
@@ -115,17 +166,81 @@ fos_ret_t FOS_Terminate(fos_t *p, int32_t terminate_code);
 // yield to another process
 void FOS_Yield();
 
+// hand the rest of the time slice of the current thread to the ready thread with identifier
+fos_ret_t FOS_YieldToId(fos_t *p, fos_id_t id);
+
 //send thread with identifier to sleep
-//fos_ret_t FOS_SleepId(fos_t *p, uint8_t id, uint32_t time);
+//fos_ret_t FOS_SleepId(fos_t *p, fos_id_t id, uint32_t time);
 
 // send current thread to sleep
 fos_ret_t FOS_Sleep(fos_t *p, uint32_t time);
 
+// send current thread to sleep until *last_wake + period and move *last_wake to that time
+// FOS__FAIL - the time has already passed (overrun), the thread does not sleep
+fos_ret_t FOS_SleepUntil(fos_t *p, uint32_t *last_wake, uint32_t period);
+
+// send current thread to sleep for time_us microseconds
+fos_ret_t FOS_SleepUs(fos_t *p, uint32_t time_us);
+
+// send current thread to sleep until *last_wake_us + period_us in microseconds and move *last_wake_us to that time
+// FOS__FAIL - the time has already passed (overrun), the thread does not sleep
+fos_ret_t FOS_SleepUntilUs(fos_t *p, fos_time_t *last_wake_us, uint32_t period_us);
+
+// get monotonic kernel time, us
+fos_time_t FOS_GetTimeUs();
+
 // set blocking to thread with identifier
-fos_ret_t FOS_LockId(fos_t *p, uint8_t id, uint32_t lock);
+fos_ret_t FOS_LockId(fos_t *p, fos_id_t id, uint32_t lock);
 
 // unblock thread with identifier
-fos_ret_t FOS_UnlockId(fos_t *p, uint8_t id, uint32_t lock);
+fos_ret_t FOS_UnlockId(fos_t *p, fos_id_t id, uint32_t lock);
+
+// set own priority of the thread with identifier
+// FOS__FAIL - the thread is not found, priority is wrong or the thread is run-to-completion
+fos_ret_t FOS_SetPriorityId(fos_t *p, fos_id_t id, uint8_t priority);
+
+// suspend the thread with identifier until it is resumed
+fos_ret_t FOS_SuspendId(fos_t *p, fos_id_t id);
+
+// resume the suspended thread with identifier
+fos_ret_t FOS_ResumeId(fos_t *p, fos_id_t id);
+
+// set time slice of the thread with identifier
+fos_ret_t FOS_SetQuantumId(fos_t *p, fos_id_t id, uint32_t quantum_us);
+
+// set CPU budget of the thread with identifier: budget_us in each period_ms (budget_us = 0 - unlimited)
+fos_ret_t FOS_SetBudgetId(fos_t *p, fos_id_t id, uint32_t budget_us, uint32_t period_ms);
+
+// set CPU reservation of thread group (1..FOS_GROUP_CNT): reserve_us guaranteed and at most budget_us in each period_ms
+fos_ret_t FOS_SetGroup(fos_t *p, uint8_t group, uint32_t reserve_us, uint32_t budget_us, uint32_t period_ms);
+
+// move the thread with identifier to the group (FOS_NO_GROUP - out of groups)
+fos_ret_t FOS_SetThreadGroupId(fos_t *p, fos_id_t id, uint8_t group);
+
+// start time-triggered cyclic executive with the table
+// FOS__FAIL - the table is wrong or the thread of a slot is not found
+fos_ret_t FOS_TtStart(fos_t *p, const fos_tt_table_t *table);
+
+// stop time-triggered cyclic executive, the threads of the table are scheduled as usual
+fos_ret_t FOS_TtStop(fos_t *p);
+
+// complete the job of the current thread and wait for its next slot of the time-triggered table
+// FOS__FAIL - the thread has no slots
+fos_ret_t FOS_TtWaitNextSlot(fos_t *p);
+
+// get shared stack of run-to-completion threads with priority
+// FOS__FAIL - the stack is not allocated yet
+fos_ret_t FOS_GetRtcStack(fos_t *p, uint8_t priority, uint32_t *base_sp, uint32_t *stack_size);
+
+// set shared stack of run-to-completion threads with priority
+fos_ret_t FOS_SetRtcStack(fos_t *p, uint8_t priority, uint32_t base_sp, uint32_t stack_size);
+
+// complete the job of the current run-to-completion thread
+fos_ret_t FOS_RtcJobComplete(fos_t *p);
+
+// complete the current job of the periodic thread and wait for the next release
+// FOS__FAIL - the thread is not periodic or the job missed its deadline
+fos_ret_t FOS_WaitNextPeriod(fos_t *p);
 
 // register binary semaphore
 fos_ret_t FOS_SemBinaryReg(fos_t *p, fos_semaphore_binary_t *semb);
@@ -143,11 +258,14 @@ fos_ret_t FOS_SemBinaryTakeStat(fos_t *p, user_desc_t semb);
 // release binary semaphore
 fos_ret_t FOS_SemBinaryGive(fos_t *p, user_desc_t semb);
 
+// release binary semaphore and hand the rest of the time slice to the unblocked thread
+fos_ret_t FOS_SemBinaryGiveSwitch(fos_t *p, user_desc_t semb);
+
 // set binary semaphore timeout
 fos_ret_t FOS_SemBinarySetTimeout(fos_t *p, user_desc_t semb, uint32_t timeout_ms);
 
 // get writer object descriptor by its identifier
-fwriter_t* FOS_GetFWriterDesc(fos_t *p, uint8_t id);
+fwriter_t* FOS_GetFWriterDesc(fos_t *p, fos_id_t id);
 
 // register writer object
 fos_ret_t FOS_FWriterReg(fos_t *p, fwriter_t *fw);
@@ -192,25 +310,59 @@ fos_ret_t FOS_Queue32ReadData(fos_t *p, user_desc_t que, uint32_t* data_ptr);
 // write data
 fos_ret_t FOS_Queue32WriteData(fos_t *p, user_desc_t que, uint32_t data);
 
+// register mutex
+fos_ret_t FOS_MutexReg(fos_t *p, fos_mutex_t *mtx);
+
+// delete mutex
+// FOS__FAIL - the mutex is locked
+fos_ret_t FOS_MutexDelete(fos_t *p, user_desc_t mtx);
+
+// lock mutex by the current thread
+fos_ret_t FOS_MutexLock(fos_t *p, user_desc_t mtx);
+
+// unlock mutex owned by the current thread
+fos_ret_t FOS_MutexUnlock(fos_t *p, user_desc_t mtx);
+
+// send message to the thread with identifier and wait for the reply
+fos_ret_t FOS_IpcSend(fos_t *p, fos_id_t id, fos_ipc_msg_t *msg, fos_ipc_msg_t *reply);
+
+// receive message, wait for it if no thread is sending
+fos_ret_t FOS_IpcReceive(fos_t *p, fos_ipc_msg_t *msg);
+
+// reply to the thread with identifier whose message has been received
+fos_ret_t FOS_IpcReply(fos_t *p, fos_id_t id, fos_ipc_msg_t *reply);
+
+// get user descriptor of the partner of the last message exchange of the current thread (FOS_WRONG_USER_DESC - exchange failed)
+user_desc_t FOS_IpcGetPartner(fos_t *p);
+
 // get the system stack debug info
 fos_thread_dbg_t* FOS_GetSysStackDbgInfo(fos_t *p);
 
 // get the scheduler debug info
 fos_scheduler_dbg_t* FOS_GetSchedulerDbgInfo(fos_t *p);
 
+#if defined(FOS_USE_SCHED_POLICY_RUNTIME)
+// change the scheduling policy, the ready threads are moved to the queues of the new policy
+fos_ret_t FOS_SetSchedPolicy(fos_t *p, const fos_sched_policy_t *policy);
+#endif
+
 // main loop handler
 void FOS_MainLoopProc(fos_t *p);
 
+// choose the next thread right in PendSV, bypassing the main loop
+// FOS__FAIL - the switch must go through the main loop
+fos_ret_t FOS_DirectSwitchProc(fos_t *p);
+
 
 /*
  * Currently not used
  */
 
 // get id of current thread
-//uint8_t FOS_GetCurrentThreadId(fos_t *p);
+//fos_id_t FOS_GetCurrentThreadId(fos_t *p);
 
 // wake up thread
-//fos_ret_t FOS_WeakUpId(fos_t *p, uint8_t id);
+//fos_ret_t FOS_WeakUpId(fos_t *p, fos_id_t id);
 
 // block current thread
 //fos_ret_t FOS_Lock(fos_t *p, uint32_t lock);
@@ -31,6 +31,18 @@ static void GATE_FOS_Yield(void* data);
 // усыпить текущий поток
 static void GATE_FOS_Sleep(void* data);
 
+// усыпить текущий поток до момента *last_wake + period
+static void GATE_FOS_SleepUntil(void* data);
+
+// усыпить текущий поток на time_us мкс
+static void GATE_FOS_SleepUs(void* data);
+
+// усыпить текущий поток до момента *last_wake_us + period_us в мкс
+static void GATE_FOS_SleepUntilUs(void* data);
+
+// получить монотонное время ядра в мкс
+static void GATE_FOS_GetTimeUs(void* data);
+
 // взять бинарный семафор
 static void  GATE_FOS_SemBinaryTake(void* data);
 
@@ -107,12 +119,82 @@ static void  GATE_FOS_SemBinaryTakeStat(void* data);
 // get taking status of counting semaphore
 static void  GATE_FOS_SemCntTakeStat(void* data);
 
+// set time slice of the thread with descriptor
+static void GATE_FOS_SetQuantumDesc(void* data);
+
+// complete the current job of the periodic thread and wait for the next release
+static void GATE_FOS_WaitNextPeriod(void* data);
+
+// создать мьютекс
+static void GATE_FOS_CreateMutex(void* data);
+
+// удалить мьютекс
+static void GATE_FOS_DeleteMutex(void* data);
+
+// захватить мьютекс
+static void GATE_FOS_MutexLock(void* data);
+
+// освободить мьютекс
+static void GATE_FOS_MutexUnlock(void* data);
+
+// завершить задание потока до завершения
+static void GATE_FOS_RtcJobComplete(void* data);
+
+// установить бюджет процессорного времени потока с дескриптором
+static void GATE_FOS_SetBudgetDesc(void* data);
+
+// передать остаток кванта готовому потоку с дескриптором
+static void GATE_FOS_YieldToDesc(void* data);
+
+// дать бинарный семафор и передать остаток кванта разблокированному потоку
+static void GATE_FOS_SemBinaryGiveSwitch(void* data);
+
+// отправить сообщение потоку с дескриптором и ждать ответа
+static void GATE_FOS_IpcSend(void* data);
+
+// принять сообщение
+static void GATE_FOS_IpcReceive(void* data);
+
+// ответить потоку с дескриптором
+static void GATE_FOS_IpcReply(void* data);
+
+// получить дескриптор собеседника последнего обмена сообщениями
+static void GATE_FOS_IpcGetPartner(void* data);
+
+// настроить резервирование процессорного времени группы потоков
+static void GATE_FOS_SetGroup(void* data);
+
+// перевести поток с дескриптором в группу
+static void GATE_FOS_SetThreadGroupDesc(void* data);
+
+// запустить циклический исполнитель по таблице
+static void GATE_FOS_TtStart(void* data);
+
+// остановить циклический исполнитель
+static void GATE_FOS_TtStop(void* data);
+
+// завершить задание текущего потока и ждать его следующего слота таблицы
+static void GATE_FOS_TtWaitNextSlot(void* data);
+
+// установить собственный приоритет потока с дескриптором
+static void GATE_FOS_SetPriorityDesc(void* data);
+
+// приостановить поток с дескриптором
+static void GATE_FOS_SuspendDesc(void* data);
+
+// возобновить поток с дескриптором
+static void GATE_FOS_ResumeDesc(void* data);
+
 
 // инициализировать шлюзы системных вызовов
 void GATE_FOS_Init()
 {
 	system_reg_call(GATE_FOS_Yield, FOS_SYSCALL_FOS_YIELD);
 	system_reg_call(GATE_FOS_Sleep, FOS_SYSCALL_FOS_SLEEP);
+	system_reg_call(GATE_FOS_SleepUntil, FOS_SYSCALL_FOS_SLEEP_UNTIL);
+	system_reg_call(GATE_FOS_SleepUs, FOS_SYSCALL_FOS_SLEEP_US);
+	system_reg_call(GATE_FOS_SleepUntilUs, FOS_SYSCALL_FOS_SLEEP_UNTIL_US);
+	system_reg_call(GATE_FOS_GetTimeUs, FOS_SYSCALL_FOS_GET_TIME_US);
 
 	system_reg_call(GATE_FOS_SemBinaryTake, FOS_SYSCALL_FOS_SEMB_TAKE);
 	system_reg_call(GATE_FOS_SemBinaryGive, FOS_SYSCALL_FOS_SEMB_GIVE);
@@ -147,6 +229,31 @@ void GATE_FOS_Init()
 
 	system_reg_call(GATE_FOS_SemBinaryTakeStat, FOS_SYSCALL_FOS_SEMB_TAKE_STAT);
 	system_reg_call(GATE_FOS_SemCntTakeStat, FOS_SYSCALL_FOS_SEMC_TAKE_STAT);
+
+	system_reg_call(GATE_FOS_SetQuantumDesc, FOS_SYSCALL_FOS_SET_QUANTUM);
+	system_reg_call(GATE_FOS_WaitNextPeriod, FOS_SYSCALL_FOS_WAIT_NEXT_PERIOD);
+
+	system_reg_call(GATE_FOS_CreateMutex, FOS_SYSCALL_FOS_CREATE_MUTEX);
+	system_reg_call(GATE_FOS_DeleteMutex, FOS_SYSCALL_FOS_DELETE_MUTEX);
+	system_reg_call(GATE_FOS_MutexLock, FOS_SYSCALL_FOS_MUTEX_LOCK);
+	system_reg_call(GATE_FOS_MutexUnlock, FOS_SYSCALL_FOS_MUTEX_UNLOCK);
+
+	system_reg_call(GATE_FOS_RtcJobComplete, FOS_SYSCALL_FOS_RTC_JOB_COMPLETE);
+	system_reg_call(GATE_FOS_SetBudgetDesc, FOS_SYSCALL_FOS_SET_BUDGET);
+	system_reg_call(GATE_FOS_YieldToDesc, FOS_SYSCALL_FOS_YIELD_TO);
+	system_reg_call(GATE_FOS_SemBinaryGiveSwitch, FOS_SYSCALL_FOS_SEMB_GIVE_SWITCH);
+	system_reg_call(GATE_FOS_IpcSend, FOS_SYSCALL_FOS_IPC_SEND);
+	system_reg_call(GATE_FOS_IpcReceive, FOS_SYSCALL_FOS_IPC_RECEIVE);
+	system_reg_call(GATE_FOS_IpcReply, FOS_SYSCALL_FOS_IPC_REPLY);
+	system_reg_call(GATE_FOS_IpcGetPartner, FOS_SYSCALL_FOS_IPC_GET_PARTNER);
+	system_reg_call(GATE_FOS_SetGroup, FOS_SYSCALL_FOS_SET_GROUP);
+	system_reg_call(GATE_FOS_SetThreadGroupDesc, FOS_SYSCALL_FOS_SET_THREAD_GROUP);
+	system_reg_call(GATE_FOS_TtStart, FOS_SYSCALL_FOS_TT_START);
+	system_reg_call(GATE_FOS_TtStop, FOS_SYSCALL_FOS_TT_STOP);
+	system_reg_call(GATE_FOS_TtWaitNextSlot, FOS_SYSCALL_FOS_TT_WAIT_NEXT_SLOT);
+	system_reg_call(GATE_FOS_SetPriorityDesc, FOS_SYSCALL_FOS_SET_PRIORITY);
+	system_reg_call(GATE_FOS_SuspendDesc, FOS_SYSCALL_FOS_SUSPEND);
+	system_reg_call(GATE_FOS_ResumeDesc, FOS_SYSCALL_FOS_RESUME);
 }
 
 
@@ -165,6 +272,40 @@ static void GATE_FOS_Sleep(void* data)
 }
 
 
+// усыпить текущий поток до момента *last_wake + period
+static void GATE_FOS_SleepUntil(void* data)
+{
+	uint32_t *buf_ptr = data;
+	buf_ptr[0] = (uint32_t)USER_FOS_SleepUntil((uint32_t*)buf_ptr[1], buf_ptr[2]);
+}
+
+
+// усыпить текущий поток на time_us мкс
+static void GATE_FOS_SleepUs(void* data)
+{
+	uint32_t *buf_ptr = data;
+	buf_ptr[0] = (uint32_t)USER_FOS_SleepUs(buf_ptr[1]);
+}
+
+
+// усыпить текущий поток до момента *last_wake_us + period_us в мкс
+static void GATE_FOS_SleepUntilUs(void* data)
+{
+	uint32_t *buf_ptr = data;
+	buf_ptr[0] = (uint32_t)USER_FOS_SleepUntilUs((fos_time_t*)buf_ptr[1], buf_ptr[2]);
+}
+
+
+// получить монотонное время ядра в мкс
+static void GATE_FOS_GetTimeUs(void* data)
+{
+	uint32_t *buf_ptr = data;
+	fos_time_t t = USER_FOS_GetTimeUs();
+	buf_ptr[0] = (uint32_t)t;            // младшее слово
+	buf_ptr[1] = (uint32_t)(t >> 32);    // старшее слово
+}
+
+
 // взять бинарный семафор
 static void  GATE_FOS_SemBinaryTake(void* data)
 {
@@ -366,6 +507,182 @@ static void  GATE_FOS_SemCntTakeStat(void* data)
 }
 
 
+// set time slice of the thread with descriptor
+static void GATE_FOS_SetQuantumDesc(void* data)
+{
+	uint32_t *buf_ptr = data;
+	buf_ptr[0] = (uint32_t)USER_FOS_SetQuantumDesc((user_desc_t)buf_ptr[1], (uint32_t)buf_ptr[2]);
+}
+
+
+// complete the current job of the periodic thread and wait for the next release
+static void GATE_FOS_WaitNextPeriod(void* data)
+{
+	uint32_t *buf_ptr = data;
+	buf_ptr[0] = (uint32_t)USER_FOS_WaitNextPeriod();
+}
+
+
+// создать мьютекс
+static void GATE_FOS_CreateMutex(void* data)
+{
+	uint32_t *buf_ptr = data;
+	buf_ptr[0] = (uint32_t)USER_FOS_CreateMutex((uint8_t)buf_ptr[1]);
+}
+
+
+// удалить мьютекс
+static void GATE_FOS_DeleteMutex(void* data)
+{
+	uint32_t *buf_ptr = data;
+	buf_ptr[0] = (uint32_t)USER_FOS_DeleteMutex((user_desc_t)buf_ptr[1]);
+}
+
+
+// захватить мьютекс
+static void GATE_FOS_MutexLock(void* data)
+{
+	uint32_t *buf_ptr = data;
+	buf_ptr[0] = (uint32_t)USER_FOS_MutexLock((user_desc_t)buf_ptr[1]);
+}
+
+
+// освободить мьютекс
+static void GATE_FOS_MutexUnlock(void* data)
+{
+	uint32_t *buf_ptr = data;
+	buf_ptr[0] = (uint32_t)USER_FOS_MutexUnlock((user_desc_t)buf_ptr[1]);
+}
+
+
+// завершить задание потока до завершения
+static void GATE_FOS_RtcJobComplete(void* data)
+{
+	uint32_t *buf_ptr = data;
+	buf_ptr[0] = (uint32_t)USER_FOS_RtcJobComplete();
+}
+
+
+// установить бюджет процессорного времени потока с дескриптором
+static void GATE_FOS_SetBudgetDesc(void* data)
+{
+	uint32_t *buf_ptr = data;
+	buf_ptr[0] = (uint32_t)USER_FOS_SetBudgetDesc((user_desc_t)buf_ptr[1], (uint32_t)buf_ptr[2], (uint32_t)buf_ptr[3]);
+}
+
+
+// передать остаток кванта готовому потоку с дескриптором
+static void GATE_FOS_YieldToDesc(void* data)
+{
+	uint32_t *buf_ptr = data;
+	buf_ptr[0] = (uint32_t)USER_FOS_YieldToDesc((user_desc_t)buf_ptr[1]);
+}
+
+
+// дать бинарный семафор и передать остаток кванта разблокированному потоку
+static void GATE_FOS_SemBinaryGiveSwitch(void* data)
+{
+	uint32_t *buf_ptr = data;
+	buf_ptr[0] = (uint32_t)USER_FOS_SemBinaryGiveSwitch((user_desc_t)buf_ptr[1]);
+}
+
+
+// отправить сообщение потоку с дескриптором и ждать ответа
+static void GATE_FOS_IpcSend(void* data)
+{
+	uint32_t *buf_ptr = data;
+	buf_ptr[0] = (uint32_t)USER_FOS_IpcSend((user_desc_t)buf_ptr[1], (fos_ipc_msg_t*)buf_ptr[2], (fos_ipc_msg_t*)buf_ptr[3]);
+}
+
+
+// принять сообщение
+static void GATE_FOS_IpcReceive(void* data)
+{
+	uint32_t *buf_ptr = data;
+	buf_ptr[0] = (uint32_t)USER_FOS_IpcReceive((fos_ipc_msg_t*)buf_ptr[1]);
+}
+
+
+// ответить потоку с дескриптором
+static void GATE_FOS_IpcReply(void* data)
+{
+	uint32_t *buf_ptr = data;
+	buf_ptr[0] = (uint32_t)USER_FOS_IpcReply((user_desc_t)buf_ptr[1], (fos_ipc_msg_t*)buf_ptr[2]);
+}
+
+
+// получить дескриптор собеседника последнего обмена сообщениями
+static void GATE_FOS_IpcGetPartner(void* data)
+{
+	uint32_t *buf_ptr = data;
+	buf_ptr[0] = (uint32_t)USER_FOS_IpcGetPartner();
+}
+
+
+// настроить резервирование процессорного времени группы потоков
+static void GATE_FOS_SetGroup(void* data)
+{
+	uint32_t *buf_ptr = data;
+	buf_ptr[0] = (uint32_t)USER_FOS_SetGroup((uint8_t)buf_ptr[1], (uint32_t)buf_ptr[2], (uint32_t)buf_ptr[3], (uint32_t)buf_ptr[4]);
+}
+
+
+// перевести поток с дескриптором в группу
+static void GATE_FOS_SetThreadGroupDesc(void* data)
+{
+	uint32_t *buf_ptr = data;
+	buf_ptr[0] = (uint32_t)USER_FOS_SetThreadGroupDesc((user_desc_t)buf_ptr[1], (uint8_t)buf_ptr[2]);
+}
+
+
+// запустить циклический исполнитель по таблице
+static void GATE_FOS_TtStart(void* data)
+{
+	uint32_t *buf_ptr = data;
+	buf_ptr[0] = (uint32_t)USER_FOS_TtStart((const fos_tt_table_t*)buf_ptr[1]);
+}
+
+
+// остановить циклический исполнитель
+static void GATE_FOS_TtStop(void* data)
+{
+	uint32_t *buf_ptr = data;
+	buf_ptr[0] = (uint32_t)USER_FOS_TtStop();
+}
+
+
+// завершить задание текущего потока и ждать его следующего слота таблицы
+static void GATE_FOS_TtWaitNextSlot(void* data)
+{
+	uint32_t *buf_ptr = data;
+	buf_ptr[0] = (uint32_t)USER_FOS_TtWaitNextSlot();
+}
+
+
+// установить собственный приоритет потока с дескриптором
+static void GATE_FOS_SetPriorityDesc(void* data)
+{
+	uint32_t *buf_ptr = data;
+	buf_ptr[0] = (uint32_t)USER_FOS_SetPriorityDesc((user_desc_t)buf_ptr[1], (uint8_t)buf_ptr[2]);
+}
+
+
+// приостановить поток с дескриптором
+static void GATE_FOS_SuspendDesc(void* data)
+{
+	uint32_t *buf_ptr = data;
+	buf_ptr[0] = (uint32_t)USER_FOS_SuspendDesc((user_desc_t)buf_ptr[1]);
+}
+
+
+// возобновить поток с дескриптором
+static void GATE_FOS_ResumeDesc(void* data)
+{
+	uint32_t *buf_ptr = data;
+	buf_ptr[0] = (uint32_t)USER_FOS_ResumeDesc((user_desc_t)buf_ptr[1]);
+}
+
+
 
 
 
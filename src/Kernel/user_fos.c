@@ -24,6 +24,7 @@
 #include "Kernel/user_fos.h"
 #include "Mem/fos_heap.h"
 #include "Platform/sl_platform.h"
+#include "Platform/fos_tim_platform.h"
 
 
 static fos_t fos;                                          // ОС
@@ -53,6 +54,12 @@ static fwriter_t* Private_USER_FOS_CreateFWriterObj();
 // создать объект очереди
 static fos_queue32_t* Private_USER_FOS_CreateQueue32Obj();
 
+// создать объект мьютекса
+static fos_mutex_t* Private_USER_FOS_CreateMutexObj();
+
+// получить общий стек потоков до завершения с приоритетом (выделяется при создании первого такого потока)
+static fos_ret_t Private_USER_FOS_GetRtcStack(uint8_t priority, uint32_t *base_sp, uint32_t *stack_size);
+
 // инициализация потока
 static void USER_FOS_ThreadInit(fos_thread_t *p, fos_thread_init_t *init);
 
@@ -71,6 +78,9 @@ static fos_ret_t USER_FOS_FWriterInitAndReg(fwriter_t *fw, file_init_t *init);
 // инициализация и регистрация очереди
 static fos_ret_t USER_FOS_Queue32InitAndReg(fos_queue32_t *que, uint32_t* buf_ptr, uint16_t buf_size, user_desc_t semc);
 
+// инициализация и регистрация мьютекса
+static fos_ret_t USER_FOS_MutexInitAndReg(fos_mutex_t *mtx, uint8_t ceiling);
+
 // бработчик callback ошибки стека
 static void FOS_Proc_StackErrorCallback(user_desc_t user_desc);
 
@@ -150,13 +160,35 @@ user_desc_t USER_FOS_CreateThread(fos_thread_user_init_t *user_init)
 	if(user_init == NULL)
 		return FOS_WRONG_USER_DESC;
 
-	/*
-	 * Выделяем память под поток
-	 */
-	uint32_t thread_mem_size = user_init->stack_size + user_init->heap_size;    // вычисляем объем памяти под поток
-	void* thread_mem_ptr = FOS_Heap_ThreadsHeap_Alloc(thread_mem_size);         // выделяем память под поток
-	if(thread_mem_ptr == NULL)                                                  // проверяем что выделелась
-		return FOS_WRONG_USER_DESC;
+	void*    thread_mem_ptr = NULL;
+	uint32_t stack_base = 0;
+	uint32_t stack_size = user_init->stack_size;
+
+	if(user_init->rtc_sw)
+	{
+		/*
+		 * Поток до завершения работает на общем стеке потоков своего приоритета
+		 */
+		if(user_init->rt.period_ms)                                             // периодический поток не может быть потоком до завершения
+			return FOS_WRONG_USER_DESC;
+
+		if(user_init->heap_size)                                                // у потока до завершения нет своей кучи
+			return FOS_WRONG_USER_DESC;
+
+		if(Private_USER_FOS_GetRtcStack(user_init->priotity, &stack_base, &stack_size) != FOS__OK)
+			return FOS_WRONG_USER_DESC;
+	}else
+	{
+		/*
+		 * Выделяем память под поток
+		 */
+		uint32_t thread_mem_size = user_init->stack_size + user_init->heap_size;    // вычисляем объем памяти под поток
+		thread_mem_ptr = FOS_Heap_ThreadsHeap_Alloc(thread_mem_size);               // выделяем память под поток
+		if(thread_mem_ptr == NULL)                                                  // проверяем что выделелась
+			return FOS_WRONG_USER_DESC;
+
+		stack_base = (uint32_t)thread_mem_ptr;
+	}
 
 	/*
 	 * Создаем поток
@@ -164,7 +196,8 @@ user_desc_t USER_FOS_CreateThread(fos_thread_user_init_t *user_init)
 	fos_thread_t *thr_ptr = Private_USER_FOS_CreateThreadObj();                 // создаем объект потока
 	if(thr_ptr == NULL)                                                         // проверяем что создался
 	{
-		FOS_Heap_ThreadsHeap_Free(thread_mem_ptr);                              // освобождаем память
+		if(thread_mem_ptr)
+			FOS_Heap_ThreadsHeap_Free(thread_mem_ptr);                          // освобождаем память
 		return FOS_WRONG_USER_DESC;
 	}
 
@@ -176,7 +209,8 @@ user_desc_t USER_FOS_CreateThread(fos_thread_user_init_t *user_init)
 	if(semb == FOS_WRONG_USER_DESC)
 	{
 		FOS_Heap_KernelHeap_Free(thr_ptr);
-		FOS_Heap_ThreadsHeap_Free(thread_mem_ptr);
+		if(thread_mem_ptr)
+			FOS_Heap_ThreadsHeap_Free(thread_mem_ptr);
 		return FOS_WRONG_USER_DESC;
 	}
 
@@ -184,12 +218,17 @@ user_desc_t USER_FOS_CreateThread(fos_thread_user_init_t *user_init)
 	 * Инициализируем поток
 	 */
 	fos_thread_init_t init = {0};
-	init.set.priotity = user_init->priotity;
-	init.cset.base_sp = (uint32_t)thread_mem_ptr;
-	init.cset.stack_size = user_init->stack_size;
+	init.priotity = user_init->priotity;
+	init.set.quantum_us = user_init->quantum_us;
+	init.set.rt = user_init->rt;
+	init.set.budget = user_init->budget;
+	init.set.group = (user_init->group <= FOS_GROUP_CNT) ? user_init->group : FOS_NO_GROUP;
+	init.cset.base_sp = stack_base;
+	init.cset.stack_size = stack_size;
 	init.cset.ep = (uint32_t)user_init->user_thread_ep;
 	init.cset.alloc_type = user_init->alloc_type;
 	init.cset.semb = semb;
+	init.cset.rtc_sw = user_init->rtc_sw;
 	init.name_ptr = user_init->name_ptr;
 	USER_FOS_ThreadInit(thr_ptr, &init);
 
@@ -200,7 +239,8 @@ user_desc_t USER_FOS_CreateThread(fos_thread_user_init_t *user_init)
 	{
 		// если ошибка регистрации, освобождаем выделенную память
 		FOS_Heap_KernelHeap_Free(thr_ptr);
-		FOS_Heap_ThreadsHeap_Free(thread_mem_ptr);
+		if(thread_mem_ptr)
+			FOS_Heap_ThreadsHeap_Free(thread_mem_ptr);
 		USER_FOS_DeleteSemBinary(semb);
 		return FOS_WRONG_USER_DESC;
 	}
@@ -246,6 +286,118 @@ fos_ret_t USER_FOS_Sleep(uint32_t time)
 }
 
 
+// усыпить текущий поток до момента *last_wake + period
+fos_ret_t USER_FOS_SleepUntil(uint32_t *last_wake, uint32_t period)
+{
+	return FOS_SleepUntil(&fos, last_wake, period);
+}
+
+
+// усыпить текущий поток на time_us мкс
+fos_ret_t USER_FOS_SleepUs(uint32_t time_us)
+{
+	return FOS_SleepUs(&fos, time_us);
+}
+
+
+// усыпить текущий поток до момента *last_wake_us + period_us в мкс
+fos_ret_t USER_FOS_SleepUntilUs(fos_time_t *last_wake_us, uint32_t period_us)
+{
+	return FOS_SleepUntilUs(&fos, last_wake_us, period_us);
+}
+
+
+// получить монотонное время ядра в мкс
+fos_time_t USER_FOS_GetTimeUs()
+{
+	return FOS_GetTimeUs();
+}
+
+
+// установить собственный приоритет потока с дескриптором
+fos_ret_t USER_FOS_SetPriorityDesc(user_desc_t desc, uint8_t priority)
+{
+	return FOS_SetPriorityId(&fos, FOS_GetUdThreadId(&fos, desc), priority);
+}
+
+
+// приостановить поток с дескриптором
+fos_ret_t USER_FOS_SuspendDesc(user_desc_t desc)
+{
+	return FOS_SuspendId(&fos, FOS_GetUdThreadId(&fos, desc));
+}
+
+
+// возобновить поток с дескриптором
+fos_ret_t USER_FOS_ResumeDesc(user_desc_t desc)
+{
+	return FOS_ResumeId(&fos, FOS_GetUdThreadId(&fos, desc));
+}
+
+
+// установить квант времени потока с дескриптором
+fos_ret_t USER_FOS_SetQuantumDesc(user_desc_t desc, uint32_t quantum_us)
+{
+	return FOS_SetQuantumId(&fos, FOS_GetUdThreadId(&fos, desc), quantum_us);
+}
+
+
+// установить бюджет процессорного времени потока с дескриптором
+fos_ret_t USER_FOS_SetBudgetDesc(user_desc_t desc, uint32_t budget_us, uint32_t period_ms)
+{
+	return FOS_SetBudgetId(&fos, FOS_GetUdThreadId(&fos, desc), budget_us, period_ms);
+}
+
+
+// передать остаток кванта готовому потоку с дескриптором
+fos_ret_t USER_FOS_YieldToDesc(user_desc_t desc)
+{
+	return FOS_YieldToId(&fos, FOS_GetUdThreadId(&fos, desc));
+}
+
+
+// настроить резервирование процессорного времени группы потоков
+fos_ret_t USER_FOS_SetGroup(uint8_t group, uint32_t reserve_us, uint32_t budget_us, uint32_t period_ms)
+{
+	return FOS_SetGroup(&fos, group, reserve_us, budget_us, period_ms);
+}
+
+
+// перевести поток с дескриптором в группу
+fos_ret_t USER_FOS_SetThreadGroupDesc(user_desc_t desc, uint8_t group)
+{
+	return FOS_SetThreadGroupId(&fos, FOS_GetUdThreadId(&fos, desc), group);
+}
+
+
+// завершить текущее задание периодического потока и ждать следующего
+fos_ret_t USER_FOS_WaitNextPeriod()
+{
+	return FOS_WaitNextPeriod(&fos);
+}
+
+
+// запустить циклический исполнитель по таблице
+fos_ret_t USER_FOS_TtStart(const fos_tt_table_t *table)
+{
+	return FOS_TtStart(&fos, table);
+}
+
+
+// остановить циклический исполнитель
+fos_ret_t USER_FOS_TtStop()
+{
+	return FOS_TtStop(&fos);
+}
+
+
+// завершить задание текущего потока и ждать его следующего слота таблицы
+fos_ret_t USER_FOS_TtWaitNextSlot()
+{
+	return FOS_TtWaitNextSlot(&fos);
+}
+
+
 // создать бинарный семафор
 user_desc_t USER_FOS_CreateSemBinary(fos_semb_state_t init_state)
 {
@@ -294,6 +446,13 @@ fos_ret_t USER_FOS_SemBinaryGive(user_desc_t semb)
 }
 
 
+// дать бинарный семафор и передать остаток кванта разблокированному потоку
+fos_ret_t USER_FOS_SemBinaryGiveSwitch(user_desc_t semb)
+{
+	return FOS_SemBinaryGiveSwitch(&fos, semb);
+}
+
+
 // set binary semaphore timeout
 fos_ret_t USER_FOS_SemBinarySetTimeout(user_desc_t semb, uint32_t timeout_ms)
 {
@@ -481,6 +640,82 @@ fos_ret_t USER_FOS_Queue32WriteData(user_desc_t que, uint32_t data)
 }
 
 
+// создать мьютекс
+// ceiling - потолок приоритета (FOS_NO_CEILING - только наследование приоритета)
+user_desc_t USER_FOS_CreateMutex(uint8_t ceiling)
+{
+	fos_mutex_t* mtx_ptr = Private_USER_FOS_CreateMutexObj();
+	if(mtx_ptr == NULL)
+		return FOS_WRONG_USER_DESC;
+
+	// инициализируем и регистрируем
+	if(USER_FOS_MutexInitAndReg(mtx_ptr, ceiling) != FOS__OK)
+	{
+		// обработка ошибки
+		FOS_Heap_KernelHeap_Free(mtx_ptr);
+		return FOS_WRONG_USER_DESC;
+	}
+
+	return mtx_ptr->user_desc;
+}
+
+
+// удалить мьютекс
+fos_ret_t USER_FOS_DeleteMutex(user_desc_t mtx)
+{
+	return FOS_MutexDelete(&fos, mtx);
+}
+
+
+// захватить мьютекс
+fos_ret_t USER_FOS_MutexLock(user_desc_t mtx)
+{
+	return FOS_MutexLock(&fos, mtx);
+}
+
+
+// освободить мьютекс
+fos_ret_t USER_FOS_MutexUnlock(user_desc_t mtx)
+{
+	return FOS_MutexUnlock(&fos, mtx);
+}
+
+
+// завершить задание текущего потока до завершения
+fos_ret_t USER_FOS_RtcJobComplete()
+{
+	return FOS_RtcJobComplete(&fos);
+}
+
+
+// отправить сообщение потоку с дескриптором и ждать ответа
+fos_ret_t USER_FOS_IpcSend(user_desc_t desc, fos_ipc_msg_t *msg, fos_ipc_msg_t *reply)
+{
+	return FOS_IpcSend(&fos, FOS_GetUdThreadId(&fos, desc), msg, reply);
+}
+
+
+// принять сообщение
+fos_ret_t USER_FOS_IpcReceive(fos_ipc_msg_t *msg)
+{
+	return FOS_IpcReceive(&fos, msg);
+}
+
+
+// ответить потоку с дескриптором
+fos_ret_t USER_FOS_IpcReply(user_desc_t desc, fos_ipc_msg_t *reply)
+{
+	return FOS_IpcReply(&fos, FOS_GetUdThreadId(&fos, desc), reply);
+}
+
+
+// получить дескриптор собеседника последнего обмена сообщениями
+user_desc_t USER_FOS_IpcGetPartner()
+{
+	return FOS_IpcGetPartner(&fos);
+}
+
+
 // get the system stack debug info
 fos_thread_dbg_t* USER_FOS_GetSysStackDbgInfo()
 {
@@ -495,6 +730,15 @@ fos_scheduler_dbg_t* USER_FOS_GetSchedulerDbgInfo()
 }
 
 
+#if defined(FOS_USE_SCHED_POLICY_RUNTIME)
+// сменить политику планирования (вызывать из USER_FOS_InitAndRun или главного цикла)
+fos_ret_t USER_FOS_SetSchedPolicy(const fos_sched_policy_t *policy)
+{
+	return FOS_SetSchedPolicy(&fos, policy);
+}
+#endif
+
+
 // обработчик основного цикла
 void USER_FOS_MainLoopProc()
 {
@@ -510,7 +754,7 @@ void USER_FOS_MainLoopProc()
 
 // callback на блокировку потока с id
 // используется в слабом подтягивании
-void FOS_Lock_LockThread(uint8_t thr_id)
+void FOS_Lock_LockThread(fos_id_t thr_id)
 {
 	FOS_LockId(&fos, thr_id, FOS_LOCK_OBJ_FLAG);
 }
@@ -518,12 +762,20 @@ void FOS_Lock_LockThread(uint8_t thr_id)
 
 // callback на разблокировку потока с id
 // используется в слабом подтягивании
-void FOS_Lock_UnlockThread(uint8_t thr_id)
+void FOS_Lock_UnlockThread(fos_id_t thr_id)
 {
 	FOS_UnlockId(&fos, thr_id, FOS_LOCK_OBJ_FLAG);
 }
 
 
+// callback на выбор следующего потока прямо в PendSV
+// используется в слабом подтягивании
+fos_ret_t FOS_System_DirectSwitchProc()
+{
+	return FOS_DirectSwitchProc(&fos);
+}
+
+
 /*
  * Системные сервисы
  */
@@ -533,7 +785,11 @@ static void Iddle_Main_thr()
 {
 	while(1)
 	{
+#if defined(FOS_USE_TICKLESS_IDLE)
+		FOS_Platform_Idle();    // ждём прерывания
+#else
 		SL_Delay(10);      // обычная задержка блокирующая поток
+#endif
 	}
 }
 
@@ -552,7 +808,7 @@ static void FProc_Main_thr()
 		isDataToWrite = 0;          // сброс флага
 
 		// перебираем все FWriter id
-		for(uint8_t i = 0; i <= f->var.fwriter_max_id; i++)
+		for(fos_id_t i = 0; i <= f->var.fwriter_max_id; i++)
 		{
 			fwriter = FOS_GetFWriterDesc(f, i);              // получаем дескриптор очередного FWriter
 			if(fwriter != NULL)
@@ -611,6 +867,43 @@ static fos_queue32_t* Private_USER_FOS_CreateQueue32Obj()
 }
 
 
+// создать объект мьютекса
+static fos_mutex_t* Private_USER_FOS_CreateMutexObj()
+{
+	return (fos_mutex_t*)FOS_Heap_KernelHeap_Alloc(sizeof(fos_mutex_t));
+}
+
+
+// получить общий стек потоков до завершения с приоритетом (выделяется при создании первого такого потока)
+static fos_ret_t Private_USER_FOS_GetRtcStack(uint8_t priority, uint32_t *base_sp, uint32_t *stack_size)
+{
+	uint32_t size = *stack_size;
+
+	if(FOS_GetRtcStack(&fos, priority, base_sp, stack_size) == FOS__OK)
+		return (size <= *stack_size) ? FOS__OK : FOS__FAIL;    // общий стек должен вмещать стек потока
+
+#if (FOS_RTC_STACK_SIZE > 0)
+	if(size < FOS_RTC_STACK_SIZE)                              // общий стек выделяется с запасом под потоки с большим стеком
+		size = FOS_RTC_STACK_SIZE;
+#endif
+
+	void* stack_ptr = FOS_Heap_ThreadsHeap_Alloc(size);        // общий стек не освобождается
+	if(stack_ptr == NULL)
+		return FOS__FAIL;
+
+	if(FOS_SetRtcStack(&fos, priority, (uint32_t)stack_ptr, size) != FOS__OK)
+	{
+		FOS_Heap_ThreadsHeap_Free(stack_ptr);
+		return FOS__FAIL;
+	}
+
+	*base_sp    = (uint32_t)stack_ptr;
+	*stack_size = size;
+
+	return FOS__OK;
+}
+
+
 // инициализация потока
 static void USER_FOS_ThreadInit(fos_thread_t *p, fos_thread_init_t *init)
 {
@@ -658,6 +951,14 @@ static fos_ret_t USER_FOS_Queue32InitAndReg(fos_queue32_t *que, uint32_t* buf_pt
 }
 
 
+// инициализация и регистрация мьютекса
+static fos_ret_t USER_FOS_MutexInitAndReg(fos_mutex_t *mtx, uint8_t ceiling)
+{
+	FOS_Mutex_Init(mtx, ceiling);
+	return FOS_MutexReg(&fos, mtx);
+}
+
+
 // бработчик callback ошибки стека
 static void FOS_Proc_StackErrorCallback(user_desc_t user_desc)
 {
@@ -709,7 +1010,7 @@ static void USER_FOS_GarbageCollection()
  */
 
 // получить id текущего потока
-/*uint8_t USER_FOS_GetCurrentThreadId()
+/*fos_id_t USER_FOS_GetCurrentThreadId()
 {
 	return FOS_GetCurrentThreadId(&fos);
 }*/
@@ -723,14 +1024,14 @@ static void USER_FOS_GarbageCollection()
 
 
 // получить id потока по его дескриптору
-/*uint8_t USER_FOS_GetThreadId(fos_thread_t *thr)
+/*fos_id_t USER_FOS_GetThreadId(fos_thread_t *thr)
 {
 	return FOS_GetThreadId(&fos, thr);
 }*/
 
 
 // получение дескриптора потока по id
-/*fos_thread_t* USER_FOS_GetThreadDesc(uint8_t id)
+/*fos_thread_t* USER_FOS_GetThreadDesc(fos_id_t id)
 {
 	return FOS_GetThreadDesc(&fos, id);
 }*/
@@ -744,7 +1045,7 @@ static void USER_FOS_GarbageCollection()
 
 
 // успыпить поток с id
-/*fos_ret_t USER_FOS_SleepId(uint8_t id, uint32_t time)
+/*fos_ret_t USER_FOS_SleepId(fos_id_t id, uint32_t time)
 {
 	return FOS_SleepId(&fos, id, time);
 }*/
@@ -758,14 +1059,14 @@ static void USER_FOS_GarbageCollection()
 
 
 // запустить поток с id
-/*fos_ret_t USER_FOS_RunId(uint8_t id)
+/*fos_ret_t USER_FOS_RunId(fos_id_t id)
 {
 	return FOS_RunId(&fos, id);
 }*/
 
 
 // разбудить поток с id
-/*fos_ret_t USER_FOS_WeakUpId(uint8_t id)
+/*fos_ret_t USER_FOS_WeakUpId(fos_id_t id)
 {
 	return FOS_WeakUpId(&fos, id);
 }*/
@@ -779,7 +1080,7 @@ static void USER_FOS_GarbageCollection()
 
 
 // установить блокировку на поток с id
-/*fos_ret_t USER_FOS_LockId(uint8_t id, uint32_t lock)
+/*fos_ret_t USER_FOS_LockId(fos_id_t id, uint32_t lock)
 {
 	return FOS_LockId(&fos, id, lock & FOS_USER_LOCK_MASK);
 }*/
@@ -800,7 +1101,7 @@ static void USER_FOS_GarbageCollection()
 
 
 // снять блокировку с потока с id
-/*fos_ret_t USER_FOS_UnlockId(uint8_t id, uint32_t lock)
+/*fos_ret_t USER_FOS_UnlockId(fos_id_t id, uint32_t lock)
 {
 	return FOS_UnlockId(&fos, id, lock & FOS_USER_LOCK_MASK);
 }*/
@@ -54,6 +54,54 @@ fos_ret_t USER_FOS_IsThreadAlive(user_desc_t desc);
 // усыпить текущий поток
 fos_ret_t USER_FOS_Sleep(uint32_t time);
 
+// усыпить текущий поток до момента *last_wake + period
+fos_ret_t USER_FOS_SleepUntil(uint32_t *last_wake, uint32_t period);
+
+// усыпить текущий поток на time_us мкс
+fos_ret_t USER_FOS_SleepUs(uint32_t time_us);
+
+// усыпить текущий поток до момента *last_wake_us + period_us в мкс
+fos_ret_t USER_FOS_SleepUntilUs(fos_time_t *last_wake_us, uint32_t period_us);
+
+// получить монотонное время ядра в мкс
+fos_time_t USER_FOS_GetTimeUs();
+
+// установить собственный приоритет потока с дескриптором
+fos_ret_t USER_FOS_SetPriorityDesc(user_desc_t desc, uint8_t priority);
+
+// приостановить поток с дескриптором
+fos_ret_t USER_FOS_SuspendDesc(user_desc_t desc);
+
+// возобновить поток с дескриптором
+fos_ret_t USER_FOS_ResumeDesc(user_desc_t desc);
+
+// установить квант времени потока с дескриптором
+fos_ret_t USER_FOS_SetQuantumDesc(user_desc_t desc, uint32_t quantum_us);
+
+// установить бюджет процессорного времени потока с дескриптором
+fos_ret_t USER_FOS_SetBudgetDesc(user_desc_t desc, uint32_t budget_us, uint32_t period_ms);
+
+// передать остаток кванта готовому потоку с дескриптором
+fos_ret_t USER_FOS_YieldToDesc(user_desc_t desc);
+
+// настроить резервирование процессорного времени группы потоков
+fos_ret_t USER_FOS_SetGroup(uint8_t group, uint32_t reserve_us, uint32_t budget_us, uint32_t period_ms);
+
+// перевести поток с дескриптором в группу
+fos_ret_t USER_FOS_SetThreadGroupDesc(user_desc_t desc, uint8_t group);
+
+// завершить текущее задание периодического потока и ждать следующего
+fos_ret_t USER_FOS_WaitNextPeriod();
+
+// запустить циклический исполнитель по таблице
+fos_ret_t USER_FOS_TtStart(const fos_tt_table_t *table);
+
+// остановить циклический исполнитель
+fos_ret_t USER_FOS_TtStop();
+
+// завершить задание текущего потока и ждать его следующего слота таблицы
+fos_ret_t USER_FOS_TtWaitNextSlot();
+
 // создать бинарный семафор
 user_desc_t USER_FOS_CreateSemBinary(fos_semb_state_t init_state);
 
@@ -70,6 +118,9 @@ fos_ret_t USER_FOS_SemBinaryTakeStat(user_desc_t semb);
 // дать бинарный семафор
 fos_ret_t USER_FOS_SemBinaryGive(user_desc_t semb);
 
+// дать бинарный семафор и передать остаток кванта разблокированному потоку
+fos_ret_t USER_FOS_SemBinaryGiveSwitch(user_desc_t semb);
+
 // set binary semaphore timeout
 fos_ret_t USER_FOS_SemBinarySetTimeout(user_desc_t semb, uint32_t timeout_ms);
 
@@ -118,12 +169,45 @@ fos_ret_t USER_FOS_Queue32ReadData(user_desc_t que, uint32_t* data_ptr);
 // дать счётный семафор
 fos_ret_t USER_FOS_Queue32WriteData(user_desc_t que, uint32_t data);
 
+// создать мьютекс
+// ceiling - потолок приоритета (FOS_NO_CEILING - только наследование приоритета)
+user_desc_t USER_FOS_CreateMutex(uint8_t ceiling);
+
+// удалить мьютекс
+fos_ret_t USER_FOS_DeleteMutex(user_desc_t mtx);
+
+// захватить мьютекс
+fos_ret_t USER_FOS_MutexLock(user_desc_t mtx);
+
+// освободить мьютекс
+fos_ret_t USER_FOS_MutexUnlock(user_desc_t mtx);
+
+// завершить задание текущего потока до завершения
+fos_ret_t USER_FOS_RtcJobComplete();
+
+// отправить сообщение потоку с дескриптором и ждать ответа
+fos_ret_t USER_FOS_IpcSend(user_desc_t desc, fos_ipc_msg_t *msg, fos_ipc_msg_t *reply);
+
+// принять сообщение
+fos_ret_t USER_FOS_IpcReceive(fos_ipc_msg_t *msg);
+
+// ответить потоку с дескриптором
+fos_ret_t USER_FOS_IpcReply(user_desc_t desc, fos_ipc_msg_t *reply);
+
+// получить дескриптор собеседника последнего обмена сообщениями
+user_desc_t USER_FOS_IpcGetPartner();
+
 // get the system stack debug info
 fos_thread_dbg_t* USER_FOS_GetSysStackDbgInfo();
 
 // get the scheduler debug info
 fos_scheduler_dbg_t* USER_FOS_GetSchedulerDbgInfo();
 
+#if defined(FOS_USE_SCHED_POLICY_RUNTIME)
+// сменить политику планирования (вызывать из USER_FOS_InitAndRun или главного цикла)
+fos_ret_t USER_FOS_SetSchedPolicy(const fos_sched_policy_t *policy);
+#endif
+
 // обработчик основного цикла
 void USER_FOS_MainLoopProc();
 
@@ -21,6 +21,15 @@
 */
 
 #include "Platform/fos_tim_platform.h"
+#include "Platform/sl_platform.h"
+#include "fos_conf.h"
+
+
+#if defined(FOS_TIME_BASE_DWT_HZ)
+	#define FOS_DEMCR         (*(volatile uint32_t*)0xE000EDFC)    // debug exception and monitor control register
+	#define FOS_DWT_CTRL      (*(volatile uint32_t*)0xE0001000)    // DWT control register
+	#define FOS_DWT_CYCCNT    (*(volatile uint32_t*)0xE0001004)    // DWT cycle counter
+#endif
 
 
 /*
@@ -68,6 +77,79 @@ __weak void FOS_Platform_MainTim_SetARR(uint32_t val){}
 __weak void CallPendSV(){}
 
 
+/*
+ * Prototype of idle function (wait for interrupt)
+ */
+__weak void FOS_Platform_Idle()
+{
+	__asm volatile ("wfi");
+}
+
+
+#if defined(FOS_TIME_BASE_DWT_HZ)
+
+/*
+ * Prototype of time base start function
+ * The time base is a free-running 32-bit up-counter, DWT cycle counter by default
+ */
+__weak void FOS_Platform_TimeBase_Start()
+{
+	FOS_DEMCR     |= (1 << 24);      // TRCENA: enable DWT
+	FOS_DWT_CYCCNT = 0;
+	FOS_DWT_CTRL  |= 1;              // CYCCNTENA: start the cycle counter
+}
+
+
+/*
+ * Prototype of time base get counter function
+ * The counter must not wrap more than once between two readings of the kernel time
+ */
+__weak uint32_t FOS_Platform_TimeBase_GetCounter()
+{
+	return FOS_DWT_CYCCNT;
+}
+
+
+/*
+ * Prototype of time base get counter frequency function, Hz
+ * The frequency is at least 1 MHz, it is read once by FOS_Time_Init()
+ */
+__weak uint32_t FOS_Platform_TimeBase_GetFreq()
+{
+	return FOS_TIME_BASE_DWT_HZ;
+}
+
+#else
+
+/*
+ * Prototype of time base start function
+ * Without the cycle counter the time base is the 1 ms tick counted in microseconds
+ */
+__weak void FOS_Platform_TimeBase_Start(){}
+
+
+/*
+ * Prototype of time base get counter function
+ * The counter must not wrap more than once between two readings of the kernel time
+ */
+__weak uint32_t FOS_Platform_TimeBase_GetCounter()
+{
+	return SL_GetTick() * 1000;      // wraps modulo 2^32 like a hardware counter
+}
+
+
+/*
+ * Prototype of time base get counter frequency function, Hz
+ * The frequency is at least 1 MHz, it is read once by FOS_Time_Init()
+ */
+__weak uint32_t FOS_Platform_TimeBase_GetFreq()
+{
+	return 1000000;
+}
+
+#endif
+
+
 
 
 
@@ -70,6 +70,34 @@ __weak void FOS_Platform_MainTim_SetARR(uint32_t val);
 __weak void CallPendSV();
 
 
+/*
+ * Prototype of idle function (wait for interrupt)
+ */
+__weak void FOS_Platform_Idle();
+
+
+/*
+ * Prototype of time base start function
+ * The time base is a free-running 32-bit up-counter: DWT cycle counter if FOS_TIME_BASE_DWT_HZ is set,
+ * otherwise SL_GetTick() * 1000, which gives microsecond units with 1 ms granularity
+ */
+__weak void FOS_Platform_TimeBase_Start();
+
+
+/*
+ * Prototype of time base get counter function
+ * The counter must not wrap more than once between two readings of the kernel time
+ */
+__weak uint32_t FOS_Platform_TimeBase_GetCounter();
+
+
+/*
+ * Prototype of time base get counter frequency function, Hz
+ * The frequency is at least 1 MHz, it is read once by FOS_Time_Init()
+ */
+__weak uint32_t FOS_Platform_TimeBase_GetFreq();
+
+
 
 
 #endif /* APPLICATION_FOS_PLATFORM_FOS_TIM_PLATFORM_H_ */
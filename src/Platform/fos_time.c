@@ -0,0 +1,106 @@
+/**************************************************************************//**
+ * @file      fos_time.c
+ * @brief     Monotonic microsecond time base of the kernel. Source file.
+ * @version   V1.0.00
+ * @date      16.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "Platform/fos_time.h"
+#include "Platform/fos_tim_platform.h"
+#include "Platform/sl_platform.h"
+
+
+static volatile uint32_t fos_time_last_cnt;    // platform counter at the previous reading
+static volatile uint64_t fos_time_us;          // microseconds since the time base start
+static volatile uint32_t fos_time_frac;        // fraction of microsecond not yet added to fos_time_us, 1/2^32 us
+static uint32_t fos_time_scale;                // microseconds per counter tick, 1/2^32 us (0 - the counter ticks in microseconds)
+
+
+/*
+ * Start the time base
+ * Call once before the kernel start
+ */
+void FOS_Time_Init()
+{
+	uint32_t freq = FOS_Platform_TimeBase_GetFreq();
+
+	FOS_Platform_TimeBase_Start();
+
+	// the only division is done here, the readings convert ticks by a multiplication and a shift
+	fos_time_scale = (freq > 1000000) ? (uint32_t)((((uint64_t)1000000 << 32) + freq / 2) / freq) : 0;
+
+	fos_time_last_cnt = FOS_Platform_TimeBase_GetCounter();
+	fos_time_us       = 0;
+	fos_time_frac     = 0;
+}
+
+
+/*
+ * Get the monotonic time since the time base start, us
+ * The 32-bit platform counter is extended to 64 bits on each call,
+ * so the kernel must call it at least once per wrap of the counter
+ * With the default counter (SL_GetTick() * 1000) the granularity is 1 ms unless FOS_TIME_BASE_DWT_HZ is set
+ */
+fos_time_t FOS_Time_GetUs()
+{
+	fos_time_t now;
+	uint64_t frac;
+	uint32_t cnt;
+	uint32_t dt;
+	uint32_t s;
+
+	ENTER_CRITICAL(s);
+
+	cnt = FOS_Platform_TimeBase_GetCounter();
+	dt  = cnt - fos_time_last_cnt;    // the difference is wrap-safe
+	fos_time_last_cnt = cnt;
+
+	if(fos_time_scale == 0)
+	{
+		fos_time_us += dt;
+	}
+	else
+	{
+		// 32x32 bit product, the fraction is carried to the next reading so the time does not drift
+		frac = (uint64_t)dt * fos_time_scale + fos_time_frac;
+		fos_time_us  += (uint32_t)(frac >> 32);
+		fos_time_frac = (uint32_t)frac;
+	}
+
+	now = fos_time_us;
+
+	LEAVE_CRITICAL(s);
+
+	return now;
+}
+
+
+/*
+ * Convert the SL_GetTick() timestamp to the microsecond time base
+ * The timestamp is taken relative to the current time, a past timestamp gives the current time
+ */
+fos_time_t FOS_Time_FromTick(uint32_t ts_ms)
+{
+	fos_time_t now = FOS_Time_GetUs();
+	int32_t dt_ms  = (int32_t)(ts_ms - SL_GetTick());
+
+	if(dt_ms <= 0)
+		return now;
+
+	return now + (fos_time_t)dt_ms * 1000;
+}
@@ -0,0 +1,55 @@
+/**************************************************************************//**
+ * @file      fos_time.h
+ * @brief     Monotonic microsecond time base of the kernel. Header file.
+ * @version   V1.0.00
+ * @date      16.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef APPLICATION_FOS_PLATFORM_FOS_TIME_H_
+#define APPLICATION_FOS_PLATFORM_FOS_TIME_H_
+
+
+#include "fos_types.h"
+
+
+/*
+ * Start the time base
+ * Call once before the kernel start
+ * The DWT cycle counter (FOS_TIME_BASE_DWT_HZ) stops while the core sleeps in WFI,
+ * so it is valid only without FOS_USE_TICKLESS_IDLE
+ */
+void FOS_Time_Init();
+
+
+/*
+ * Get the monotonic time since the time base start, us
+ * The 32-bit platform counter is extended to 64 bits on each call,
+ * so the kernel must call it at least once per wrap of the counter
+ * With the default counter (SL_GetTick() * 1000) the granularity is 1 ms unless FOS_TIME_BASE_DWT_HZ is set
+ */
+fos_time_t FOS_Time_GetUs();
+
+
+/*
+ * Convert the SL_GetTick() timestamp to the microsecond time base
+ * The timestamp is taken relative to the current time, a past timestamp gives the current time
+ */
+fos_time_t FOS_Time_FromTick(uint32_t ts_ms);
+
+
+#endif /* APPLICATION_FOS_PLATFORM_FOS_TIME_H_ */
@@ -24,6 +24,7 @@
 
 #include "Run/fos_run.h"
 #include "Platform/fos_tim_platform.h"
+#include "Platform/fos_time.h"
 #include "Platform/sl_platform.h"
 
 
@@ -43,6 +44,7 @@ __weak void USER_FOS_InitAndRun()
  */
 void RUN_FOS_InitAndRun()
 {
+	FOS_Time_Init();                     // microsecond time base start
 	FOS_Platform_MainTim_Start();        // timer start
 	FOS_Platform_MainTim_Disable();      // and instant timer pause
 
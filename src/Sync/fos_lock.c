@@ -25,13 +25,16 @@
 #include <string.h>
 
 
-// инкремент индекса
-static uint8_t Private_FOS_Lock_IncInd(uint8_t ind);
+// удалить поток из очереди блокиратора
+static void Private_FOS_Lock_Remove(fos_lock_t *p, fos_id_t thr_id);
+
+// поставить поток в очередь блокиратора после всех потоков с ключом не больше key
+static void Private_FOS_Lock_Insert(fos_lock_t *p, fos_id_t thr_id, uint8_t key);
 
 
 // заглушка на блокировку потока с id
 // реализация через функцию ядра
-__weak void FOS_Lock_LockThread(uint8_t thr_id)
+__weak void FOS_Lock_LockThread(fos_id_t thr_id)
 {
 
 }
@@ -39,7 +42,7 @@ __weak void FOS_Lock_LockThread(uint8_t thr_id)
 
 // заглушка на разблокировку потока с id
 // реализация через функцию ядра
-__weak void FOS_Lock_UnlockThread(uint8_t thr_id)
+__weak void FOS_Lock_UnlockThread(fos_id_t thr_id)
 {
 
 }
@@ -53,28 +56,49 @@ void FOS_Lock_Init(fos_lock_t *p)
 		return;
 
 	memset(p, 0, sizeof(fos_lock_t));
-	memset((void*)p->lock_thr_is_list, FOS_WRONG_THREAD_ID, FOS_MAX_THR_CNT);   // массив заполняем FOS_WRONG_THREAD_ID
+	p->first_lock_thr = FOS_WRONG_THREAD_ID;
+	p->last_lock_thr  = FOS_WRONG_THREAD_ID;
 }
 
 
-// взять блокировку; блокирует поток с id = thr_id
-fos_ret_t FOS_Lock_Take(fos_lock_t *p, uint8_t thr_id)
+// инициализация таблицы узлов очередей ожидания ядра (FOS_MAX_THR_CNT узлов)
+void FOS_Lock_NodeInit(fos_lock_node_t *node)
 {
-	if((p == NULL) || (thr_id >= FOS_MAX_THR_CNT))
-		return FOS__FAIL;
+	if(node == NULL)
+		return;
 
-	if(p->lock_thr_cnt == 0)                   // если не было заблокированных потоков
+	for(fos_id_t i = 0; i < FOS_MAX_THR_CNT; i++)
 	{
-		p->first_lock_thr = 0;                 // обнуляем индексы
-		p->last_lock_thr  = 0;                 // ...
-		p->lock_thr_is_list[0] = thr_id;       // в массив с нулевым индексом записываем id первого блокируемого потока
-	}else
-	{                                                                           // если это не первый заблокированный поток
-		p->last_lock_thr = Private_FOS_Lock_IncInd(p->last_lock_thr);           // инкермент индекса посденего заблокированного потоа
-		p->lock_thr_is_list[p->last_lock_thr] = thr_id;                         // по этому индексу в массив запоминаем id очередного блокируемого потока
+		node[i].next = FOS_WRONG_THREAD_ID;
+		node[i].prev = FOS_WRONG_THREAD_ID;
+		node[i].lock = NULL;
+		node[i].key  = UINT8_MAX;
 	}
+}
 
-	p->lock_thr_cnt++;              // инкермент счётчика заблокированных потоков
+
+// привязать блокиратор к таблице узлов ядра, в котором он зарегистрирован
+void FOS_Lock_Bind(fos_lock_t *p, fos_lock_node_t *node)
+{
+	if(p == NULL)
+		return;
+
+	p->node = node;
+}
+
+
+// взять блокировку; блокирует поток с id = thr_id
+fos_ret_t FOS_Lock_Take(fos_lock_t *p, fos_id_t thr_id)
+{
+	if((p == NULL) || (p->node == NULL) || (thr_id >= FOS_MAX_THR_CNT))
+		return FOS__FAIL;
+
+	fos_lock_node_t *n = &p->node[thr_id];
+
+	if(n->lock != NULL)                        // поток уже стоит в очереди другого блокиратора
+		Private_FOS_Lock_Remove(n->lock, thr_id);
+
+	Private_FOS_Lock_Insert(p, thr_id, UINT8_MAX);    // ставим поток в конец очереди
 
 	FOS_Lock_LockThread(thr_id);    // блокируем поток
 
@@ -85,6 +109,51 @@ fos_ret_t FOS_Lock_Take(fos_lock_t *p, uint8_t thr_id)
 }
 
 
+// взять блокировку с местом в очереди по ключу: потоки с меньшим ключом разблокируются раньше,
+// с равным - в порядке блокировки
+fos_ret_t FOS_Lock_TakeOrdered(fos_lock_t *p, fos_id_t thr_id, uint8_t key)
+{
+	if((p == NULL) || (p->node == NULL) || (thr_id >= FOS_MAX_THR_CNT))
+		return FOS__FAIL;
+
+	fos_lock_node_t *n = &p->node[thr_id];
+
+	if(n->lock != NULL)                        // поток уже стоит в очереди другого блокиратора
+		Private_FOS_Lock_Remove(n->lock, thr_id);
+
+	Private_FOS_Lock_Insert(p, thr_id, key);
+
+	FOS_Lock_LockThread(thr_id);    // блокируем поток
+
+	return FOS__OK;
+}
+
+
+// сменить ключ потока, стоящего в упорядоченной очереди (поток переставляется)
+fos_ret_t FOS_Lock_SetKey(fos_lock_t *p, fos_id_t thr_id, uint8_t key)
+{
+	if((p == NULL) || (p->node == NULL) || (thr_id >= FOS_MAX_THR_CNT) || (p->node[thr_id].lock != p))
+		return FOS__FAIL;
+
+	if(p->node[thr_id].key == key)
+		return FOS__OK;
+
+	Private_FOS_Lock_Remove(p, thr_id);
+	Private_FOS_Lock_Insert(p, thr_id, key);
+
+	return FOS__OK;
+}
+
+
+// вернуть ключ первого потока очереди (UINT8_MAX - очередь пуста)
+uint8_t FOS_Lock_GetFirstKey(fos_lock_t *p)
+{
+	if((p == NULL) || (p->lock_thr_cnt == 0))
+		return UINT8_MAX;
+	return p->node[p->first_lock_thr].key;
+}
+
+
 // отдать блокировку; разблокирует заблокированные потоки в порядке очереди их блокировки
 fos_ret_t FOS_Lock_Give(fos_lock_t *p, fos_sw_t timeout_flag)
 {
@@ -93,11 +162,8 @@ fos_ret_t FOS_Lock_Give(fos_lock_t *p, fos_sw_t timeout_flag)
 
 	if(p->lock_thr_cnt)                   // если есть заблокированные потоки
 	{
-		uint8_t thr_id = p->lock_thr_is_list[p->first_lock_thr];         // получаем id первого заблокированного потока
-		p->lock_thr_is_list[p->first_lock_thr] = FOS_WRONG_THREAD_ID;    // удаляем id этого потока из массива
-		p->first_lock_thr = Private_FOS_Lock_IncInd(p->first_lock_thr);  // инкремент индекса первого заблокированного потока
-
-		p->lock_thr_cnt--;                // декремент счётчика заблокированных потоков
+		fos_id_t thr_id = p->first_lock_thr;    // получаем id первого заблокированного потока
+		Private_FOS_Lock_Remove(p, thr_id);     // удаляем его из очереди
 
 		// обработка таймаута
 //		p->timeout_flag = timeout_flag;
@@ -113,7 +179,7 @@ fos_ret_t FOS_Lock_Give(fos_lock_t *p, fos_sw_t timeout_flag)
 
 
 // вернуть число заблокированных потоков
-uint8_t FOS_Lock_GetLockedThreadsCount(fos_lock_t *p)
+uint16_t FOS_Lock_GetLockedThreadsCount(fos_lock_t *p)
 {
 	if(p == NULL)
 		return 0;
@@ -121,37 +187,112 @@ uint8_t FOS_Lock_GetLockedThreadsCount(fos_lock_t *p)
 }
 
 
+// вернуть id первого заблокированного потока (FOS_WRONG_THREAD_ID - очередь пуста)
+fos_id_t FOS_Lock_GetFirstThread(fos_lock_t *p)
+{
+	if((p == NULL) || (p->lock_thr_cnt == 0))
+		return FOS_WRONG_THREAD_ID;
+	return p->first_lock_thr;
+}
+
+
+// вернуть id потока, стоящего в очереди после thr_id (FOS_WRONG_THREAD_ID - thr_id последний)
+fos_id_t FOS_Lock_GetNextThread(fos_lock_t *p, fos_id_t thr_id)
+{
+	if((p == NULL) || (p->node == NULL) || (thr_id >= FOS_MAX_THR_CNT) || (p->node[thr_id].lock != p))
+		return FOS_WRONG_THREAD_ID;
+	return p->node[thr_id].next;
+}
+
+
 // отсоединить поток от блокиратора
-fos_ret_t FOS_Lock_UnlinkThread(fos_lock_t *p, uint8_t thr_id)
+fos_ret_t FOS_Lock_UnlinkThread(fos_lock_t *p, fos_id_t thr_id)
 {
-	if(p == NULL)
+	if((p == NULL) || (p->node == NULL) || (thr_id >= FOS_MAX_THR_CNT) || (p->node[thr_id].lock != p))
 		return FOS__FAIL;
 
-	for(uint8_t i = 0; i < FOS_MAX_THR_CNT; i++)
-	{
-		if(thr_id == p->lock_thr_is_list[i])
-		{
-			p->lock_thr_is_list[i] = FOS_WRONG_THREAD_ID;
-			return FOS__OK;
-		}
-	}
+	Private_FOS_Lock_Remove(p, thr_id);
+	return FOS__OK;
+}
+
 
-	return FOS__FAIL;
+// вернуть блокиратор, в очереди которого стоит поток (NULL - поток не ждёт блокиратора)
+fos_lock_t* FOS_Lock_GetThreadLock(fos_lock_node_t *node, fos_id_t thr_id)
+{
+	if((node == NULL) || (thr_id >= FOS_MAX_THR_CNT))
+		return NULL;
+	return node[thr_id].lock;
 }
 
 
+// отсоединить поток от блокиратора, в очереди которого он стоит, какого бы типа ни был объект
+// FOS__FAIL - поток не ждёт блокиратора
+fos_ret_t FOS_Lock_UnlinkWaitingThread(fos_lock_node_t *node, fos_id_t thr_id)
+{
+	return FOS_Lock_UnlinkThread(FOS_Lock_GetThreadLock(node, thr_id), thr_id);
+}
+
+
+
+
+
+
+
+// удалить поток из очереди блокиратора
+static void Private_FOS_Lock_Remove(fos_lock_t *p, fos_id_t thr_id)
+{
+	fos_lock_node_t *n = &p->node[thr_id];
+
+	if(n->prev != FOS_WRONG_THREAD_ID)
+		p->node[n->prev].next = n->next;
+	else
+		p->first_lock_thr = n->next;
 
+	if(n->next != FOS_WRONG_THREAD_ID)
+		p->node[n->next].prev = n->prev;
+	else
+		p->last_lock_thr = n->prev;
 
+	n->next = FOS_WRONG_THREAD_ID;
+	n->prev = FOS_WRONG_THREAD_ID;
+	n->lock = NULL;
 
+	p->lock_thr_cnt--;    // декремент счётчика заблокированных потоков
+}
 
 
-// инкремент индекса
-static uint8_t Private_FOS_Lock_IncInd(uint8_t ind)
+// поставить поток в очередь блокиратора после всех потоков с ключом не больше key
+static void Private_FOS_Lock_Insert(fos_lock_t *p, fos_id_t thr_id, uint8_t key)
 {
-	ind++;
-	if(ind >= FOS_MAX_THR_CNT)
-		ind = 0;
-	return ind;
+	fos_lock_node_t *n = &p->node[thr_id];
+	fos_id_t prev = p->last_lock_thr;
+
+	// идём от конца очереди, так что при равных ключах сохраняется порядок блокировки
+	if(p->lock_thr_cnt == 0)
+		prev = FOS_WRONG_THREAD_ID;
+	while((prev != FOS_WRONG_THREAD_ID) && (p->node[prev].key > key))
+		prev = p->node[prev].prev;
+
+	n->lock = p;
+	n->key  = key;
+	n->prev = prev;
+
+	if(prev == FOS_WRONG_THREAD_ID)            // в начало очереди
+	{
+		n->next = (p->lock_thr_cnt == 0) ? FOS_WRONG_THREAD_ID : p->first_lock_thr;
+		p->first_lock_thr = thr_id;
+	}else
+	{
+		n->next = p->node[prev].next;
+		p->node[prev].next = thr_id;
+	}
+
+	if(n->next == FOS_WRONG_THREAD_ID)         // в конец очереди
+		p->last_lock_thr = thr_id;
+	else
+		p->node[n->next].prev = thr_id;
+
+	p->lock_thr_cnt++;    // инкремент счётчика заблокированных потоков
 }
 
 
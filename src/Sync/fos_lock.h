@@ -30,17 +30,46 @@
 // инициализация
 void FOS_Lock_Init(fos_lock_t *p);
 
+// инициализация таблицы узлов очередей ожидания ядра (FOS_MAX_THR_CNT узлов)
+void FOS_Lock_NodeInit(fos_lock_node_t *node);
+
+// привязать блокиратор к таблице узлов ядра, в котором он зарегистрирован
+void FOS_Lock_Bind(fos_lock_t *p, fos_lock_node_t *node);
+
 // взять блокировку; блокирует поток с id = thr_id
-fos_ret_t FOS_Lock_Take(fos_lock_t *p, uint8_t thr_id);
+fos_ret_t FOS_Lock_Take(fos_lock_t *p, fos_id_t thr_id);
+
+// взять блокировку с местом в очереди по ключу: потоки с меньшим ключом разблокируются раньше,
+// с равным - в порядке блокировки
+fos_ret_t FOS_Lock_TakeOrdered(fos_lock_t *p, fos_id_t thr_id, uint8_t key);
+
+// сменить ключ потока, стоящего в упорядоченной очереди (поток переставляется)
+fos_ret_t FOS_Lock_SetKey(fos_lock_t *p, fos_id_t thr_id, uint8_t key);
+
+// вернуть ключ первого потока очереди (UINT8_MAX - очередь пуста)
+uint8_t FOS_Lock_GetFirstKey(fos_lock_t *p);
 
 // отдать блокировку; разблокирует заблокированные потоки в порядке очереди их блокировки
 fos_ret_t FOS_Lock_Give(fos_lock_t *p, fos_sw_t timeout_flag);
 
 // вернуть число заблокированных потоков
-uint8_t FOS_Lock_GetLockedThreadsCount(fos_lock_t *p);
+uint16_t FOS_Lock_GetLockedThreadsCount(fos_lock_t *p);
+
+// вернуть id первого заблокированного потока (FOS_WRONG_THREAD_ID - очередь пуста)
+fos_id_t FOS_Lock_GetFirstThread(fos_lock_t *p);
+
+// вернуть id потока, стоящего в очереди после thr_id (FOS_WRONG_THREAD_ID - thr_id последний)
+fos_id_t FOS_Lock_GetNextThread(fos_lock_t *p, fos_id_t thr_id);
 
 // отсоединить поток от блокиратора
-fos_ret_t FOS_Lock_UnlinkThread(fos_lock_t *p, uint8_t thr_id);
+fos_ret_t FOS_Lock_UnlinkThread(fos_lock_t *p, fos_id_t thr_id);
+
+// вернуть блокиратор, в очереди которого стоит поток (NULL - поток не ждёт блокиратора)
+fos_lock_t* FOS_Lock_GetThreadLock(fos_lock_node_t *node, fos_id_t thr_id);
+
+// отсоединить поток от блокиратора, в очереди которого он стоит, какого бы типа ни был объект
+// FOS__FAIL - поток не ждёт блокиратора
+fos_ret_t FOS_Lock_UnlinkWaitingThread(fos_lock_node_t *node, fos_id_t thr_id);
 
 
 
@@ -0,0 +1,157 @@
+/**************************************************************************//**
+ * @file      fos_mutex.c
+ * @brief     Mutex with priority inheritance and priority ceiling. Source file.
+ * @version   V1.0.00
+ * @date      16.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "Sync/fos_mutex.h"
+#include "Sync/fos_lock.h"
+
+
+// инициализация
+// ceiling - приоритет, до которого сразу поднимается владелец (FOS_NO_CEILING - только наследование)
+void FOS_Mutex_Init(fos_mutex_t *p, uint8_t ceiling)
+{
+	if(p == NULL)
+		return;
+
+	if((ceiling != FOS_NO_CEILING) && (ceiling >= FOS_PRIORITY_CNT))
+		ceiling = FOS_PRIORITY_CNT - 1;
+
+	p->owner = FOS_WRONG_THREAD_ID;
+	p->ceiling = ceiling;
+	p->next_held = FOS_WRONG_MUTEX_ID;
+	p->user_desc = FOS_WRONG_USER_DESC;
+	FOS_Lock_Init(&p->fos_lock);
+}
+
+
+// установить пользовательский дескриптор
+fos_ret_t FOS_Mutex_SetUserDesc(fos_mutex_t *p, user_desc_t user_desc)
+{
+	if(p == NULL)
+		return FOS__FAIL;
+
+	p->user_desc = user_desc;
+
+	return FOS__OK;
+}
+
+
+// взять мьютекс; если мьютекс занят, поток с id = thr_id и приоритетом priority блокируется
+// FOS__FAIL - поток уже владеет мьютексом
+fos_ret_t FOS_Mutex_Take(fos_mutex_t *p, fos_id_t thr_id, uint8_t priority)
+{
+	if((p == NULL) || (thr_id >= FOS_MAX_THR_CNT))
+		return FOS__FAIL;
+
+	if(p->owner == FOS_WRONG_THREAD_ID)              // если мьютекс свободен
+	{
+		p->owner = thr_id;                           // поток становится владельцем
+		return FOS__OK;
+	}
+
+	if(p->owner == thr_id)                           // повторный захват привёл бы к взаимной блокировке
+		return FOS__FAIL;
+
+	return FOS_Lock_TakeOrdered(&p->fos_lock, thr_id, priority);    // блокируем поток, очередь упорядочена по приоритету
+}
+
+
+// отдать мьютекс; владение переходит к ожидающему потоку с наивысшим приоритетом
+// FOS__FAIL - поток thr_id не владеет мьютексом
+fos_ret_t FOS_Mutex_Give(fos_mutex_t *p, fos_id_t thr_id)
+{
+	if((p == NULL) || (thr_id != p->owner))
+		return FOS__FAIL;
+
+	p->owner = FOS_Lock_GetFirstThread(&p->fos_lock);    // первый в очереди - поток с наивысшим приоритетом
+
+	if(p->owner != FOS_WRONG_THREAD_ID)
+		FOS_Lock_Give(&p->fos_lock, FOS__DISABLE);       // разблокируем поток
+
+	return FOS__OK;
+}
+
+
+// получить id владельца (FOS_WRONG_THREAD_ID - мьютекс свободен)
+fos_id_t FOS_Mutex_GetOwner(fos_mutex_t *p)
+{
+	if(p == NULL)
+		return FOS_WRONG_THREAD_ID;
+	return p->owner;
+}
+
+
+// получить потолок приоритета (FOS_NO_CEILING - только наследование)
+uint8_t FOS_Mutex_GetCeiling(fos_mutex_t *p)
+{
+	if(p == NULL)
+		return FOS_NO_CEILING;
+	return p->ceiling;
+}
+
+
+// получить наивысший приоритет ожидающих потоков (FOS_NO_PRIORITY - ожидающих нет)
+uint8_t FOS_Mutex_GetWaitPriority(fos_mutex_t *p)
+{
+	if(p == NULL)
+		return FOS_NO_PRIORITY;
+	return FOS_Lock_GetFirstKey(&p->fos_lock);      // очередь упорядочена, первый поток - наивысший
+}
+
+
+// сменить приоритет ожидающего потока (его место в очереди)
+fos_ret_t FOS_Mutex_SetWaitPriority(fos_mutex_t *p, fos_id_t thr_id, uint8_t priority)
+{
+	if(p == NULL)
+		return FOS__FAIL;
+	return FOS_Lock_SetKey(&p->fos_lock, thr_id, priority);
+}
+
+
+// получить id первого ожидающего потока (FOS_WRONG_THREAD_ID - ожидающих нет)
+fos_id_t FOS_Mutex_GetFirstWaitThread(fos_mutex_t *p)
+{
+	if(p == NULL)
+		return FOS_WRONG_THREAD_ID;
+	return FOS_Lock_GetFirstThread(&p->fos_lock);
+}
+
+
+// получить id потока, ожидающего после thr_id (FOS_WRONG_THREAD_ID - thr_id последний)
+fos_id_t FOS_Mutex_GetNextWaitThread(fos_mutex_t *p, fos_id_t thr_id)
+{
+	if(p == NULL)
+		return FOS_WRONG_THREAD_ID;
+	return FOS_Lock_GetNextThread(&p->fos_lock, thr_id);
+}
+
+
+// отсоединить поток от мьютекса
+fos_ret_t FOS_Mutex_UnlinkThread(fos_mutex_t *p, fos_id_t thr_id)
+{
+	if(p == NULL)
+		return FOS__FAIL;
+
+	return FOS_Lock_UnlinkThread(&p->fos_lock, thr_id);
+}
+
+
+
@@ -0,0 +1,69 @@
+/**************************************************************************//**
+ * @file      fos_mutex.h
+ * @brief     Mutex with priority inheritance and priority ceiling. Header file.
+ * @version   V1.0.00
+ * @date      16.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef APPLICATION_FOS_SYNC_FOS_MUTEX_H_
+#define APPLICATION_FOS_SYNC_FOS_MUTEX_H_
+
+
+#include "fos_types.h"
+
+// инициализация
+// ceiling - приоритет, до которого сразу поднимается владелец (FOS_NO_CEILING - только наследование)
+void FOS_Mutex_Init(fos_mutex_t *p, uint8_t ceiling);
+
+// установить пользовательский дескриптор
+fos_ret_t FOS_Mutex_SetUserDesc(fos_mutex_t *p, user_desc_t user_desc);
+
+// взять мьютекс; если мьютекс занят, поток с id = thr_id и приоритетом priority блокируется
+// FOS__FAIL - поток уже владеет мьютексом
+fos_ret_t FOS_Mutex_Take(fos_mutex_t *p, fos_id_t thr_id, uint8_t priority);
+
+// отдать мьютекс; владение переходит к ожидающему потоку с наивысшим приоритетом
+// FOS__FAIL - поток thr_id не владеет мьютексом
+fos_ret_t FOS_Mutex_Give(fos_mutex_t *p, fos_id_t thr_id);
+
+// получить id владельца (FOS_WRONG_THREAD_ID - мьютекс свободен)
+fos_id_t FOS_Mutex_GetOwner(fos_mutex_t *p);
+
+// получить потолок приоритета (FOS_NO_CEILING - только наследование)
+uint8_t FOS_Mutex_GetCeiling(fos_mutex_t *p);
+
+// получить наивысший приоритет ожидающих потоков (FOS_NO_PRIORITY - ожидающих нет)
+uint8_t FOS_Mutex_GetWaitPriority(fos_mutex_t *p);
+
+// сменить приоритет ожидающего потока (его место в очереди)
+fos_ret_t FOS_Mutex_SetWaitPriority(fos_mutex_t *p, fos_id_t thr_id, uint8_t priority);
+
+// получить id первого ожидающего потока (FOS_WRONG_THREAD_ID - ожидающих нет)
+fos_id_t FOS_Mutex_GetFirstWaitThread(fos_mutex_t *p);
+
+// получить id потока, ожидающего после thr_id (FOS_WRONG_THREAD_ID - thr_id последний)
+fos_id_t FOS_Mutex_GetNextWaitThread(fos_mutex_t *p, fos_id_t thr_id);
+
+// отсоединить поток от мьютекса
+fos_ret_t FOS_Mutex_UnlinkThread(fos_mutex_t *p, fos_id_t thr_id);
+
+
+#endif /* APPLICATION_FOS_SYNC_FOS_MUTEX_H_ */
+
+
+
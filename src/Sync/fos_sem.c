@@ -24,6 +24,7 @@
 #include "Sync/fos_sem.h"
 #include "Sync/fos_lock.h"
 #include "Platform/sl_platform.h"
+#include "Platform/fos_time.h"
 #include <string.h>
 
 
@@ -57,7 +58,7 @@ fos_ret_t FOS_SemaphoreCnt_SetUserDesc(fos_semaphore_cnt_t *p, user_desc_t user_
 
 // взять
 // поток с FOS_SPECIAL_ID уменьшает счётчик но не блоирует
-fos_ret_t FOS_SemaphoreCnt_Take(fos_semaphore_cnt_t *p, uint8_t thr_id)
+fos_ret_t FOS_SemaphoreCnt_Take(fos_semaphore_cnt_t *p, fos_id_t thr_id)
 {
 	if(p == NULL)
 		return FOS__FAIL;
@@ -70,8 +71,14 @@ fos_ret_t FOS_SemaphoreCnt_Take(fos_semaphore_cnt_t *p, uint8_t thr_id)
 		p->cnt--;       // декремент
 	}else               // если счётчик пуст
 	{
-		if(thr_id != FOS_SPECIAL_ID)
-			return FOS_Lock_Take(&p->fos_lock, thr_id);    // блокируем поток его берущий
+		if(thr_id == FOS_SPECIAL_ID)
+			return FOS__OK;
+
+		// таймаут первого заблокированного потока отсчитывается от его блокировки
+		if(FOS_Lock_GetLockedThreadsCount(&p->fos_lock) == 0)
+			p->timeout.timeout_ts_us = (uint32_t)FOS_Time_GetUs() + p->timeout.timeout_us;
+
+		return FOS_Lock_Take(&p->fos_lock, thr_id);    // блокируем поток его берущий
 	}
 
 	return FOS__OK;
@@ -117,7 +124,7 @@ fos_ret_t FOS_SemaphoreCnt_Give(fos_semaphore_cnt_t *p)
 		p->cnt = p->max_cnt;
 
     p->timeout.timeout_flag  = FOS__DISABLE;                              // снимаем флаг таймату по выдаче
-    p->timeout.timeout_ts_ms = SL_GetTick() + p->timeout.timeout_ms;      // обновляем метку времени наступления таймаута
+    p->timeout.timeout_ts_us = (uint32_t)FOS_Time_GetUs() + p->timeout.timeout_us;    // обновляем метку времени наступления таймаута
 
 	LEAVE_CRITICAL(s);
 
@@ -134,13 +141,13 @@ static fos_ret_t FOS_SemaphoreCnt_ProcTimeout(fos_semaphore_cnt_t *p)
 	fos_ret_t ret = FOS__OK;
 	uint32_t s;
 
-	if(p->timeout.timeout_ms)                               // если таймауты включены
+	if(p->timeout.timeout_us)                               // если таймауты включены
 	{
 		if(FOS_Lock_GetLockedThreadsCount(&p->fos_lock))    // если есть заблокированные потоки
 		{
-			if(SL_GetTick() >= p->timeout.timeout_ts_ms)
+			if(FOS_TIME_AFTER_EQ((uint32_t)FOS_Time_GetUs(), p->timeout.timeout_ts_us))
 			{
-				p->timeout.timeout_ts_ms = SL_GetTick() + p->timeout.timeout_ms;
+				p->timeout.timeout_ts_us = (uint32_t)FOS_Time_GetUs() + p->timeout.timeout_us;
 
 				ENTER_CRITICAL(s);
                 p->timeout.timeout_flag = FOS__ENABLE;           // поднимаем флаг таймаута
@@ -149,7 +156,7 @@ static fos_ret_t FOS_SemaphoreCnt_ProcTimeout(fos_semaphore_cnt_t *p)
 			}
 
 		}else{
-			p->timeout.timeout_ts_ms = SL_GetTick() + p->timeout.timeout_ms;
+			p->timeout.timeout_ts_us = (uint32_t)FOS_Time_GetUs() + p->timeout.timeout_us;
 		}
 	}
 
@@ -158,18 +165,18 @@ static fos_ret_t FOS_SemaphoreCnt_ProcTimeout(fos_semaphore_cnt_t *p)
 
 
 // обработка таймаута всех семафоров
-void FOS_AllSemaphoreCnt_ProcTimeout(volatile fos_semaphore_cnt_ptr *sem_desc_list, uint8_t sem_max_ind)
+void FOS_AllSemaphoreCnt_ProcTimeout(volatile fos_semaphore_cnt_ptr *sem_desc_list, fos_id_t sem_max_ind)
 {
 	if((sem_desc_list == NULL) || (sem_max_ind >= FOS_SEM_COUNTING_CNT))
 		return;
 
-	for(uint8_t i = 0; i <= sem_max_ind; i++)
+	for(fos_id_t i = 0; i <= sem_max_ind; i++)
 		FOS_SemaphoreCnt_ProcTimeout(sem_desc_list[i]);
 }
 
 
 // отсоединить поток
-fos_ret_t FOS_SemaphoreCnt_UnlinkThread(fos_semaphore_cnt_t *p, uint8_t thr_id)
+fos_ret_t FOS_SemaphoreCnt_UnlinkThread(fos_semaphore_cnt_t *p, fos_id_t thr_id)
 {
 	if(p == NULL)
 		return FOS__FAIL;
@@ -201,7 +208,27 @@ fos_ret_t FOS_SemaphoreCnt_SetTimeout(fos_semaphore_cnt_t *p, uint32_t timeout_m
 	if(timeout_ms == FOS_INF_TIME)
 		timeout_ms = 0;
 
-	p->timeout.timeout_ms = timeout_ms;
+	// таймаут отсчитывается по микросекундной шкале времени ядра, метки 32-битные
+	if(timeout_ms > FOS_TIME_MAX_AHEAD_US / 1000)
+		timeout_ms = FOS_TIME_MAX_AHEAD_US / 1000;
+
+	p->timeout.timeout_us = timeout_ms * 1000;
+
+	return FOS__OK;
+}
+
+
+// получить метку времени ближайшего таймаута (FOS__FAIL - таймаут не ожидается)
+fos_ret_t FOS_SemaphoreCnt_GetTimeoutTs(fos_semaphore_cnt_t *p, uint32_t *ts)
+{
+	if((p == NULL) || (ts == NULL))
+		return FOS__FAIL;
+
+	// таймаут наступает, только если он включен и есть заблокированные потоки
+	if((p->timeout.timeout_us == 0) || (FOS_Lock_GetLockedThreadsCount(&p->fos_lock) == 0))
+		return FOS__FAIL;
+
+	*ts = p->timeout.timeout_ts_us;
 
 	return FOS__OK;
 }
@@ -220,3 +247,4 @@ fos_ret_t FOS_SemaphoreCnt_SetTimeout(fos_semaphore_cnt_t *p, uint32_t timeout_m
 
 
 
+
@@ -35,7 +35,7 @@ fos_ret_t FOS_SemaphoreCnt_SetUserDesc(fos_semaphore_cnt_t *p, user_desc_t user_
 
 // взять
 // поток с FOS_SPECIAL_ID уменьшает счётчик но не блоирует
-fos_ret_t FOS_SemaphoreCnt_Take(fos_semaphore_cnt_t *p, uint8_t thr_id);
+fos_ret_t FOS_SemaphoreCnt_Take(fos_semaphore_cnt_t *p, fos_id_t thr_id);
 
 // получить статус взятия семафора
 // FOS__OK - нормальное взятие семафора, FOS__FAIL - взятие по таймауту
@@ -45,10 +45,10 @@ fos_ret_t FOS_SemaphoreCnt_TakeStat(fos_semaphore_cnt_t *p);
 fos_ret_t FOS_SemaphoreCnt_Give(fos_semaphore_cnt_t *p);
 
 // обработка таймаута всех семафоров
-void FOS_AllSemaphoreCnt_ProcTimeout(volatile fos_semaphore_cnt_ptr *sem_desc_list, uint8_t sem_max_ind);
+void FOS_AllSemaphoreCnt_ProcTimeout(volatile fos_semaphore_cnt_ptr *sem_desc_list, fos_id_t sem_max_ind);
 
 // отсоединить поток
-fos_ret_t FOS_SemaphoreCnt_UnlinkThread(fos_semaphore_cnt_t *p, uint8_t thr_id);
+fos_ret_t FOS_SemaphoreCnt_UnlinkThread(fos_semaphore_cnt_t *p, fos_id_t thr_id);
 
 // освободить все потоки
 fos_ret_t FOS_SemaphoreCnt_UnlockAll(fos_semaphore_cnt_t *p);
@@ -56,6 +56,9 @@ fos_ret_t FOS_SemaphoreCnt_UnlockAll(fos_semaphore_cnt_t *p);
 // установить таймаут
 fos_ret_t FOS_SemaphoreCnt_SetTimeout(fos_semaphore_cnt_t *p, uint32_t timeout_ms);
 
+// получить метку времени ближайшего таймаута (FOS__FAIL - таймаут не ожидается)
+fos_ret_t FOS_SemaphoreCnt_GetTimeoutTs(fos_semaphore_cnt_t *p, uint32_t *ts);
+
 
 
 #endif /* SYNC_FOS_SEM_H_ */
@@ -24,6 +24,7 @@
 #include "Sync/fos_semb.h"
 #include "Sync/fos_lock.h"
 #include "Platform/sl_platform.h"
+#include "Platform/fos_time.h"
 #include <string.h>
 
 
@@ -51,7 +52,7 @@ fos_ret_t FOS_SemaphoreBinary_SetUserDesc(fos_semaphore_binary_t *p, user_desc_t
 
 
 // взять
-fos_ret_t FOS_SemaphoreBinary_Take(fos_semaphore_binary_t *p, uint8_t thr_id)
+fos_ret_t FOS_SemaphoreBinary_Take(fos_semaphore_binary_t *p, fos_id_t thr_id)
 {
 	if((p == NULL) || (thr_id >= FOS_MAX_THR_CNT))
 		return FOS__FAIL;
@@ -63,6 +64,11 @@ fos_ret_t FOS_SemaphoreBinary_Take(fos_semaphore_binary_t *p, uint8_t thr_id)
 	break;
 
 	case FOS_SEMB_STATE__LOCK:                       // если семафор был заблокирован
+
+		// таймаут первого заблокированного потока отсчитывается от его блокировки
+		if(FOS_Lock_GetLockedThreadsCount(&p->fos_lock) == 0)
+			p->timeout.timeout_ts_us = (uint32_t)FOS_Time_GetUs() + p->timeout.timeout_us;
+
 		return FOS_Lock_Take(&p->fos_lock, thr_id);  // блокируем поток его берущий
 
 	}
@@ -87,11 +93,19 @@ fos_ret_t FOS_SemaphoreBinary_TakeStat(fos_semaphore_binary_t *p)
 
 // дать
 fos_ret_t FOS_SemaphoreBinary_Give(fos_semaphore_binary_t *p)
+{
+	return FOS_SemaphoreBinary_GiveId(p, NULL);
+}
+
+
+// дать и вернуть id разблокированного потока (FOS_WRONG_THREAD_ID - ожидающих не было)
+fos_ret_t FOS_SemaphoreBinary_GiveId(fos_semaphore_binary_t *p, fos_id_t *thr_id)
 {
 	if(p == NULL)
 		return FOS__FAIL;
 
 	fos_ret_t ret = FOS__OK;
+	fos_id_t  id  = FOS_WRONG_THREAD_ID;
 	uint32_t s;
 	ENTER_CRITICAL(s);
 
@@ -104,7 +118,10 @@ fos_ret_t FOS_SemaphoreBinary_Give(fos_semaphore_binary_t *p)
 	case FOS_SEMB_STATE__LOCK:                              // если семафор был заблокирован
 
 		if(FOS_Lock_GetLockedThreadsCount(&p->fos_lock))    // если есть заблокированные потоки
+		{
+			id  = FOS_Lock_GetFirstThread(&p->fos_lock);    // в той же критической секции, что и разблокировка
 			ret = FOS_Lock_Give(&p->fos_lock, FOS__DISABLE);// разблокируем очередной поток и выходим
+		}
 		else
 			p->state = FOS_SEMB_STATE__UNLOCK;              // если заблокированных полтокв нет, разблокируем семафор
 
@@ -112,10 +129,13 @@ fos_ret_t FOS_SemaphoreBinary_Give(fos_semaphore_binary_t *p)
 	}
 
 	p->timeout.timeout_flag  = FOS__DISABLE;                              // снимаем флаг таймату по выдаче
-	p->timeout.timeout_ts_ms = SL_GetTick() + p->timeout.timeout_ms;      // обновляем метку времени наступления таймаута
+	p->timeout.timeout_ts_us = (uint32_t)FOS_Time_GetUs() + p->timeout.timeout_us;    // обновляем метку времени наступления таймаута
 
 	LEAVE_CRITICAL(s);
 
+	if(thr_id)
+		*thr_id = id;
+
 	return ret;
 }
 
@@ -129,13 +149,13 @@ static fos_ret_t FOS_SemaphoreBinary_ProcTimeout(fos_semaphore_binary_t *p)
 	fos_ret_t ret = FOS__OK;
 	uint32_t s;
 
-	if(p->timeout.timeout_ms)                               // если таймауты включены
+	if(p->timeout.timeout_us)                               // если таймауты включены
 	{
 		if(FOS_Lock_GetLockedThreadsCount(&p->fos_lock))    // если есть заблокированные потоки
 		{
-			if(SL_GetTick() >= p->timeout.timeout_ts_ms)
+			if(FOS_TIME_AFTER_EQ((uint32_t)FOS_Time_GetUs(), p->timeout.timeout_ts_us))
 			{
-				p->timeout.timeout_ts_ms = SL_GetTick() + p->timeout.timeout_ms;
+				p->timeout.timeout_ts_us = (uint32_t)FOS_Time_GetUs() + p->timeout.timeout_us;
 
 				ENTER_CRITICAL(s);
 				p->timeout.timeout_flag = FOS__ENABLE;           // поднимаем флаг таймаута
@@ -144,7 +164,7 @@ static fos_ret_t FOS_SemaphoreBinary_ProcTimeout(fos_semaphore_binary_t *p)
 			}
 
 		}else{
-			p->timeout.timeout_ts_ms = SL_GetTick() + p->timeout.timeout_ms;
+			p->timeout.timeout_ts_us = (uint32_t)FOS_Time_GetUs() + p->timeout.timeout_us;
 		}
 	}
 
@@ -153,18 +173,18 @@ static fos_ret_t FOS_SemaphoreBinary_ProcTimeout(fos_semaphore_binary_t *p)
 
 
 // обработка таймаута всех семафоров
-void FOS_AllSemaphoreBinary_ProcTimeout(volatile fos_semaphore_binary_ptr *semb_desc_list, uint8_t semb_max_ind)
+void FOS_AllSemaphoreBinary_ProcTimeout(volatile fos_semaphore_binary_ptr *semb_desc_list, fos_id_t semb_max_ind)
 {
 	if((semb_desc_list == NULL) || (semb_max_ind >= FOS_SEM_BIN_CNT))
 		return;
 
-	for(uint8_t i = 0; i <= semb_max_ind; i++)
+	for(fos_id_t i = 0; i <= semb_max_ind; i++)
 		FOS_SemaphoreBinary_ProcTimeout(semb_desc_list[i]);
 }
 
 
 // отсоединить поток
-fos_ret_t FOS_SemaphoreBinary_UnlinkThread(fos_semaphore_binary_t *p, uint8_t thr_id)
+fos_ret_t FOS_SemaphoreBinary_UnlinkThread(fos_semaphore_binary_t *p, fos_id_t thr_id)
 {
 	if(p == NULL)
 		return FOS__FAIL;
@@ -196,12 +216,33 @@ fos_ret_t FOS_SemaphoreBinary_SetTimeout(fos_semaphore_binary_t *p, uint32_t tim
 	if(timeout_ms == FOS_INF_TIME)
 		timeout_ms = 0;
 
-	p->timeout.timeout_ms = timeout_ms;
+	// таймаут отсчитывается по микросекундной шкале времени ядра, метки 32-битные
+	if(timeout_ms > FOS_TIME_MAX_AHEAD_US / 1000)
+		timeout_ms = FOS_TIME_MAX_AHEAD_US / 1000;
+
+	p->timeout.timeout_us = timeout_ms * 1000;
 
 	return FOS__OK;
 }
 
 
+// получить метку времени ближайшего таймаута (FOS__FAIL - таймаут не ожидается)
+fos_ret_t FOS_SemaphoreBinary_GetTimeoutTs(fos_semaphore_binary_t *p, uint32_t *ts)
+{
+	if((p == NULL) || (ts == NULL))
+		return FOS__FAIL;
+
+	// таймаут наступает, только если он включен и есть заблокированные потоки
+	if((p->timeout.timeout_us == 0) || (FOS_Lock_GetLockedThreadsCount(&p->fos_lock) == 0))
+		return FOS__FAIL;
+
+	*ts = p->timeout.timeout_ts_us;
+
+	return FOS__OK;
+}
+
+
+
 
 
 
@@ -33,7 +33,7 @@ void FOS_SemaphoreBinary_Init(fos_semaphore_binary_t *p, fos_semb_state_t init_s
 fos_ret_t FOS_SemaphoreBinary_SetUserDesc(fos_semaphore_binary_t *p, user_desc_t user_desc);
 
 // взять
-fos_ret_t FOS_SemaphoreBinary_Take(fos_semaphore_binary_t *p, uint8_t thr_id);
+fos_ret_t FOS_SemaphoreBinary_Take(fos_semaphore_binary_t *p, fos_id_t thr_id);
 
 // получить статус взятия семафора
 // FOS__OK - нормальное взятие семафора, FOS__FAIL - взятие по таймауту
@@ -42,18 +42,24 @@ fos_ret_t FOS_SemaphoreBinary_TakeStat(fos_semaphore_binary_t *p);
 // дать
 fos_ret_t FOS_SemaphoreBinary_Give(fos_semaphore_binary_t *p);
 
+// дать и вернуть id разблокированного потока (FOS_WRONG_THREAD_ID - ожидающих не было)
+fos_ret_t FOS_SemaphoreBinary_GiveId(fos_semaphore_binary_t *p, fos_id_t *thr_id);
+
 // отсоединить поток
-fos_ret_t FOS_SemaphoreBinary_UnlinkThread(fos_semaphore_binary_t *p, uint8_t thr_id);
+fos_ret_t FOS_SemaphoreBinary_UnlinkThread(fos_semaphore_binary_t *p, fos_id_t thr_id);
 
 // освободить все потоки
 fos_ret_t FOS_SemaphoreBinary_UnlockAll(fos_semaphore_binary_t *p);
 
 // обработка таймаута всех семафоров
-void FOS_AllSemaphoreBinary_ProcTimeout(volatile fos_semaphore_binary_ptr *semb_desc_list, uint8_t semb_max_ind);
+void FOS_AllSemaphoreBinary_ProcTimeout(volatile fos_semaphore_binary_ptr *semb_desc_list, fos_id_t semb_max_ind);
 
 // установить таймаут
 fos_ret_t FOS_SemaphoreBinary_SetTimeout(fos_semaphore_binary_t *p, uint32_t timeout_ms);
 
+// получить метку времени ближайшего таймаута (FOS__FAIL - таймаут не ожидается)
+fos_ret_t FOS_SemaphoreBinary_GetTimeoutTs(fos_semaphore_binary_t *p, uint32_t *ts);
+
 
 
 #endif /* APPLICATION_FOS_SYNC_FOS_SEMB_H_ */
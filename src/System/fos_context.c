@@ -32,6 +32,41 @@ uint32_t kernel_stack[FOS_KERNEL_STACK_SIZE / 4]; // стек ядра
 
 
 
+#if defined(FOS_USE_SCHED_PROFILE)
+// засечь начало переключения контекста
+static void FOS_System_SwitchProfStart()
+{
+	fos_mgv.switch_ts    = FOS_Platform_TimeBase_GetCounter();
+	fos_mgv.switch_ts_sw = FOS__ENABLE;
+}
+
+
+// учесть длительность переключения контекста
+static void FOS_System_SwitchProfStop(fos_switch_prof_t *p)
+{
+	if(fos_mgv.switch_ts_sw == FOS__DISABLE)       // запуск ядра, переключения из потока не было
+		return;
+
+	fos_mgv.switch_ts_sw = FOS__DISABLE;
+
+	uint32_t dt = FOS_Platform_TimeBase_GetCounter() - fos_mgv.switch_ts;
+	p->ticks_last = dt;
+	p->ticks_sum += dt;
+	p->cnt++;
+	if(dt > p->ticks_max)
+		p->ticks_max = dt;
+}
+#endif
+
+
+// заглушка на выбор следующего потока прямо в PendSV
+// реализация через функцию ядра
+__weak fos_ret_t FOS_System_DirectSwitchProc()
+{
+	return FOS__FAIL;
+}
+
+
 // подготовить второй аппаратный стек
 void FOS_System_PreparePSP()
 {
@@ -57,8 +92,7 @@ void FOS_System_SetMainTimPeriod(uint32_t period_us)
 	if(period_us > FOS_MAX_TIM_PERIOD_US)
 		period_us = FOS_MAX_TIM_PERIOD_US;
 
-	if(!fos_mgv.time_period_us)
-		fos_mgv.time_period_us = period_us;
+	fos_mgv.time_period_us = period_us;           // применяется при следующем переключении контекста
 }
 
 
@@ -67,12 +101,62 @@ void FOS_System_GoToKernelMode(fos_sw_t swithed_by_tim)
 {
 	if(fos_mgv.mode != FOS__KERNEL_WORK_MODE)     // если не режим ядра
 	{
+		// вытеснение по таймеру откладывается до разблокировки планировщика
+		if(swithed_by_tim && fos_mgv.sched_lock_cnt)
+		{
+			FOS_Platform_MainTim_Disable();   // квант исчерпан, таймер больше не нужен
+			fos_mgv.swithed_by_tim = FOS__ENABLE;
+			fos_mgv.switch_pending = FOS__ENABLE;
+			return;
+		}
+
 		fos_mgv.swithed_by_tim = swithed_by_tim;
 		CallPendSV();                         // переключаемся в него
 	}
 }
 
 
+// вытеснить текущий поток (откладывается, пока планировщик заблокирован)
+void FOS_System_Preempt()
+{
+	if(fos_mgv.mode == FOS__KERNEL_WORK_MODE)
+		return;
+
+	if(fos_mgv.sched_lock_cnt)
+	{
+		if(fos_mgv.switch_pending == FOS__DISABLE)   // отложенное вытеснение по таймеру не перезаписываем
+			fos_mgv.swithed_by_tim = FOS__DISABLE;
+		fos_mgv.switch_pending = FOS__ENABLE;
+		return;
+	}
+
+	FOS_System_GoToKernelMode(FOS__DISABLE);
+}
+
+
+// заблокировать планировщик (вложенные вызовы допускаются)
+void FOS_System_SchedLock()
+{
+	fos_mgv.sched_lock_cnt++;
+}
+
+
+// разблокировать планировщик и выполнить отложенное переключение
+void FOS_System_SchedUnlock()
+{
+	if(fos_mgv.sched_lock_cnt == 0)
+		return;
+
+	fos_mgv.sched_lock_cnt--;
+
+	if(fos_mgv.sched_lock_cnt == 0 && fos_mgv.switch_pending)
+	{
+		fos_mgv.switch_pending = FOS__DISABLE;
+		FOS_System_GoToKernelMode(fos_mgv.swithed_by_tim);
+	}
+}
+
+
 // перейти в режим пользователя
 void FOS_System_GoToUserMode()
 {
@@ -148,7 +232,11 @@ __attribute__((optimize("O0"))) void PendSV_Handler()
 		GET_PSP(fos_mgv.kernel_sp);              // сохраняем указатель стека ядра
 		SET_PSP(fos_mgv.user_sp);                // загружаем указатель стека пользователя
 
-		FOS_Platform_MainTim_SetARR(fos_mgv.time_period_us);   // ставим период таймера на переключение контекста
+#if defined(FOS_USE_SCHED_PROFILE)
+		FOS_System_SwitchProfStop(&fos_mgv.switch_main_loop);  // переключение через основной цикл ядра
+#endif
+
+		FOS_Platform_MainTim_SetARR(fos_mgv.slice_period_us);  // ставим период таймера на переключение контекста
 		FOS_Platform_MainTim_SetCounter(0);                    // обнуляем счётчик таймера
 		FOS_Platform_MainTim_Enable();                         // и запускаем таймер
 
@@ -157,16 +245,40 @@ __attribute__((optimize("O0"))) void PendSV_Handler()
 	case FOS__USER_WORK_MODE:                    // если был режим пользоваетля
 
 		FOS_Platform_MainTim_Disable();          // выключаем таймер на переключение контекста
+		fos_mgv.switch_pending = FOS__DISABLE;   // отложенное переключение выполняется сейчас
+
+#if defined(FOS_USE_SCHED_PROFILE)
+		FOS_System_SwitchProfStart();            // локальные переменные здесь недопустимы, кадр стека обработчика фиксирован
+#endif
 
 		// запомниаем время затраченное прерванным процессом
 		if(fos_mgv.swithed_by_tim)
-			fos_mgv.thr_dt_us = fos_mgv.time_period_us;
+			fos_mgv.thr_dt_us = fos_mgv.slice_period_us;
 		else
 			fos_mgv.thr_dt_us = FOS_Platform_MainTim_GetCounter();
 
+		GET_PSP(fos_mgv.user_sp);                // сохраняем указатель стека пользователя
+
+#if defined(FOS_USE_DIRECT_SWITCH)
+		// пробуем переключиться сразу на следующий поток, минуя ядро
+		if(FOS_System_DirectSwitchProc() == FOS__OK)
+		{
+			SET_PSP(fos_mgv.user_sp);                              // загружаем указатель стека следующего потока
+
+#if defined(FOS_USE_SCHED_PROFILE)
+			FOS_System_SwitchProfStop(&fos_mgv.switch_direct);     // переключение прямо в PendSV
+#endif
+
+			FOS_Platform_MainTim_SetARR(fos_mgv.slice_period_us);  // ставим период таймера на переключение контекста
+			FOS_Platform_MainTim_SetCounter(0);                    // обнуляем счётчик таймера
+			FOS_Platform_MainTim_Enable();                         // и запускаем таймер
+
+			break;
+		}
+#endif
+
 		fos_mgv.mode = FOS__KERNEL_WORK_MODE;    // переключаем флаг режима в ядро
 
-		GET_PSP(fos_mgv.user_sp);                // сохраняем указатель стека пользователя
 		SET_PSP(fos_mgv.kernel_sp);              // загружаем указатель стека ядра
 
 		break;
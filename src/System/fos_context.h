@@ -39,9 +39,22 @@ void FOS_System_GoToKernelMode(fos_sw_t swithed_by_tim);
 // перейти в режим пользователя
 void FOS_System_GoToUserMode();
 
+// вытеснить текущий поток (откладывается, пока планировщик заблокирован)
+void FOS_System_Preempt();
+
+// заблокировать планировщик (вложенные вызовы допускаются)
+void FOS_System_SchedLock();
+
+// разблокировать планировщик и выполнить отложенное переключение
+void FOS_System_SchedUnlock();
+
 // получить текущий режим работы ОС
 fos_work_mode_t FOS_System_GetWorkMode();
 
+// выбрать следующий поток прямо в PendSV (FOS__FAIL - переключиться через ядро)
+// реализация через функцию ядра
+__weak fos_ret_t FOS_System_DirectSwitchProc();
+
 // обработчик прерывания PendSV
 void PendSV_Handler();
 
@@ -51,6 +51,32 @@
 #define FOS_SYSCALL_FOS_QUEUE_32_ASK        0x18        // fos_ret_t USER_FOS_Queue32AskData(user_desc_t que, fos_queue_sw_t blocking_mode_sw);
 #define FOS_SYSCALL_FOS_SEMB_TAKE_STAT      0x19        // fos_ret_t USER_FOS_SemBinaryTakeStat(user_desc_t semb);
 #define FOS_SYSCALL_FOS_SEMC_TAKE_STAT      0x1A        // fos_ret_t USER_FOS_SemCntTakeStat(user_desc_t semc);
+#define FOS_SYSCALL_FOS_SET_QUANTUM         0x1B        // fos_ret_t USER_FOS_SetQuantumDesc(user_desc_t desc, uint32_t quantum_us);
+#define FOS_SYSCALL_FOS_WAIT_NEXT_PERIOD    0x1C        // fos_ret_t USER_FOS_WaitNextPeriod();
+#define FOS_SYSCALL_FOS_CREATE_MUTEX        0x1D        // user_desc_t USER_FOS_CreateMutex(uint8_t ceiling);
+#define FOS_SYSCALL_FOS_DELETE_MUTEX        0x1E        // fos_ret_t USER_FOS_DeleteMutex(user_desc_t mtx);
+#define FOS_SYSCALL_FOS_MUTEX_LOCK          0x1F        // fos_ret_t USER_FOS_MutexLock(user_desc_t mtx);
+#define FOS_SYSCALL_FOS_MUTEX_UNLOCK        0x20        // fos_ret_t USER_FOS_MutexUnlock(user_desc_t mtx);
+#define FOS_SYSCALL_FOS_RTC_JOB_COMPLETE    0x21        // fos_ret_t USER_FOS_RtcJobComplete();
+#define FOS_SYSCALL_FOS_SET_BUDGET          0x22        // fos_ret_t USER_FOS_SetBudgetDesc(user_desc_t desc, uint32_t budget_us, uint32_t period_ms);
+#define FOS_SYSCALL_FOS_YIELD_TO            0x23        // fos_ret_t USER_FOS_YieldToDesc(user_desc_t desc);
+#define FOS_SYSCALL_FOS_SEMB_GIVE_SWITCH    0x24        // fos_ret_t USER_FOS_SemBinaryGiveSwitch(user_desc_t semb);
+#define FOS_SYSCALL_FOS_IPC_SEND            0x25        // fos_ret_t USER_FOS_IpcSend(user_desc_t desc, fos_ipc_msg_t *msg, fos_ipc_msg_t *reply);
+#define FOS_SYSCALL_FOS_IPC_RECEIVE         0x26        // fos_ret_t USER_FOS_IpcReceive(fos_ipc_msg_t *msg);
+#define FOS_SYSCALL_FOS_IPC_REPLY           0x27        // fos_ret_t USER_FOS_IpcReply(user_desc_t desc, fos_ipc_msg_t *reply);
+#define FOS_SYSCALL_FOS_IPC_GET_PARTNER     0x28        // user_desc_t USER_FOS_IpcGetPartner();
+#define FOS_SYSCALL_FOS_SET_GROUP           0x29        // fos_ret_t USER_FOS_SetGroup(uint8_t group, uint32_t reserve_us, uint32_t budget_us, uint32_t period_ms);
+#define FOS_SYSCALL_FOS_SET_THREAD_GROUP    0x2A        // fos_ret_t USER_FOS_SetThreadGroupDesc(user_desc_t desc, uint8_t group);
+#define FOS_SYSCALL_FOS_TT_START            0x2B        // fos_ret_t USER_FOS_TtStart(const fos_tt_table_t *table);
+#define FOS_SYSCALL_FOS_TT_STOP             0x2C        // fos_ret_t USER_FOS_TtStop();
+#define FOS_SYSCALL_FOS_TT_WAIT_NEXT_SLOT   0x2D        // fos_ret_t USER_FOS_TtWaitNextSlot();
+#define FOS_SYSCALL_FOS_SET_PRIORITY        0x2E        // fos_ret_t USER_FOS_SetPriorityDesc(user_desc_t desc, uint8_t priority);
+#define FOS_SYSCALL_FOS_SUSPEND             0x2F        // fos_ret_t USER_FOS_SuspendDesc(user_desc_t desc);
+#define FOS_SYSCALL_FOS_RESUME              0x30        // fos_ret_t USER_FOS_ResumeDesc(user_desc_t desc);
+#define FOS_SYSCALL_FOS_SLEEP_UNTIL         0x31        // fos_ret_t USER_FOS_SleepUntil(uint32_t *last_wake, uint32_t period);
+#define FOS_SYSCALL_FOS_SLEEP_US            0x32        // fos_ret_t USER_FOS_SleepUs(uint32_t time_us);
+#define FOS_SYSCALL_FOS_SLEEP_UNTIL_US      0x33        // fos_ret_t USER_FOS_SleepUntilUs(fos_time_t *last_wake_us, uint32_t period_us);
+#define FOS_SYSCALL_FOS_GET_TIME_US         0x34        // fos_time_t USER_FOS_GetTimeUs();
 
 
 #endif /* APPLICATION_FOS_FOS_SVC_ID_H_ */
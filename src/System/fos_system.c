@@ -24,6 +24,7 @@
 #include "System/fos_system.h"
 #include "System/fos_svcall.h"
 #include "System/fos_svc_id.h"
+#include "System/fos_context.h"
 
 
 // уступить другому процессу
@@ -46,6 +47,55 @@ fos_ret_t SYS_FOS_Sleep(uint32_t time)
 }
 
 
+// усыпить текущий поток до момента *last_wake + period
+fos_ret_t SYS_FOS_SleepUntil(uint32_t *last_wake, uint32_t period)
+{
+	uint32_t buf[3];
+	buf[1] = (uint32_t)last_wake;
+	buf[2] = period;
+
+	system_call(FOS_SYSCALL_FOS_SLEEP_UNTIL, buf);
+
+	return (fos_ret_t)buf[0];
+}
+
+
+// усыпить текущий поток на time_us мкс
+fos_ret_t SYS_FOS_SleepUs(uint32_t time_us)
+{
+	uint32_t buf[2];
+	buf[1] = time_us;
+
+	system_call(FOS_SYSCALL_FOS_SLEEP_US, buf);
+
+	return (fos_ret_t)buf[0];
+}
+
+
+// усыпить текущий поток до момента *last_wake_us + period_us в мкс
+fos_ret_t SYS_FOS_SleepUntilUs(fos_time_t *last_wake_us, uint32_t period_us)
+{
+	uint32_t buf[3];
+	buf[1] = (uint32_t)last_wake_us;
+	buf[2] = period_us;
+
+	system_call(FOS_SYSCALL_FOS_SLEEP_UNTIL_US, buf);
+
+	return (fos_ret_t)buf[0];
+}
+
+
+// получить монотонное время ядра в мкс
+fos_time_t SYS_FOS_GetTimeUs()
+{
+	uint32_t buf[2];
+
+	system_call(FOS_SYSCALL_FOS_GET_TIME_US, buf);
+
+	return ((fos_time_t)buf[1] << 32) | buf[0];
+}
+
+
 // взять бинарный семафор
 fos_ret_t SYS_FOS_SemBinaryTake(user_desc_t semb)
 {
@@ -362,6 +412,290 @@ fos_ret_t SYS_FOS_Queue32WriteData(user_desc_t que, uint32_t data)
 }
 
 
+// set time slice of the thread with descriptor
+fos_ret_t SYS_FOS_SetQuantumDesc(user_desc_t desc, uint32_t quantum_us)
+{
+	uint32_t buf[3];
+	buf[1] = (uint32_t)desc;
+	buf[2] = (uint32_t)quantum_us;
+
+	system_call(FOS_SYSCALL_FOS_SET_QUANTUM, buf);
+
+	return (fos_ret_t)buf[0];
+}
+
+
+// complete the current job of the periodic thread and wait for the next release
+fos_ret_t SYS_FOS_WaitNextPeriod()
+{
+	uint32_t buf[1];
+
+	system_call(FOS_SYSCALL_FOS_WAIT_NEXT_PERIOD, buf);
+
+	return (fos_ret_t)buf[0];
+}
+
+
+// create mutex
+user_desc_t SYS_FOS_CreateMutex(uint8_t ceiling)
+{
+	uint32_t buf[2];
+	buf[1] = (uint32_t)ceiling;
+
+	system_call(FOS_SYSCALL_FOS_CREATE_MUTEX, buf);
+
+	return (user_desc_t)buf[0];
+}
+
+
+// delete mutex
+fos_ret_t SYS_FOS_DeleteMutex(user_desc_t mtx)
+{
+	uint32_t buf[2];
+	buf[1] = (uint32_t)mtx;
+
+	system_call(FOS_SYSCALL_FOS_DELETE_MUTEX, buf);
+
+	return (fos_ret_t)buf[0];
+}
+
+
+// lock mutex
+fos_ret_t SYS_FOS_MutexLock(user_desc_t mtx)
+{
+	uint32_t buf[2];
+	buf[1] = (uint32_t)mtx;
+
+	system_call(FOS_SYSCALL_FOS_MUTEX_LOCK, buf);
+
+	return (fos_ret_t)buf[0];
+}
+
+
+// unlock mutex
+fos_ret_t SYS_FOS_MutexUnlock(user_desc_t mtx)
+{
+	uint32_t buf[2];
+	buf[1] = (uint32_t)mtx;
+
+	system_call(FOS_SYSCALL_FOS_MUTEX_UNLOCK, buf);
+
+	return (fos_ret_t)buf[0];
+}
+
+
+// complete the job of the current run-to-completion thread
+fos_ret_t SYS_FOS_RtcJobComplete()
+{
+	uint32_t buf[1];
+
+	system_call(FOS_SYSCALL_FOS_RTC_JOB_COMPLETE, buf);
+
+	return (fos_ret_t)buf[0];
+}
+
+
+// set CPU budget of the thread with descriptor
+fos_ret_t SYS_FOS_SetBudgetDesc(user_desc_t desc, uint32_t budget_us, uint32_t period_ms)
+{
+	uint32_t buf[4];
+	buf[1] = (uint32_t)desc;
+	buf[2] = (uint32_t)budget_us;
+	buf[3] = (uint32_t)period_ms;
+
+	system_call(FOS_SYSCALL_FOS_SET_BUDGET, buf);
+
+	return (fos_ret_t)buf[0];
+}
+
+
+// lock the scheduler (no system call)
+void SYS_FOS_SchedLock()
+{
+	FOS_System_SchedLock();
+}
+
+
+// unlock the scheduler (no system call unless a switch has been deferred)
+void SYS_FOS_SchedUnlock()
+{
+	FOS_System_SchedUnlock();
+}
+
+
+// hand the rest of the time slice to the ready thread with descriptor
+fos_ret_t SYS_FOS_YieldToDesc(user_desc_t desc)
+{
+	uint32_t buf[2];
+	buf[1] = (uint32_t)desc;
+
+	system_call(FOS_SYSCALL_FOS_YIELD_TO, buf);
+
+	return (fos_ret_t)buf[0];
+}
+
+
+// release binary semaphore and hand the rest of the time slice to the unblocked thread
+fos_ret_t SYS_FOS_SemBinaryGiveSwitch(user_desc_t semb)
+{
+	uint32_t buf[2];
+	buf[1] = (uint32_t)semb;
+
+	system_call(FOS_SYSCALL_FOS_SEMB_GIVE_SWITCH, buf);
+
+	return (fos_ret_t)buf[0];
+}
+
+
+// send message to the thread with descriptor and wait for the reply
+fos_ret_t SYS_FOS_IpcSend(user_desc_t desc, fos_ipc_msg_t *msg, fos_ipc_msg_t *reply)
+{
+	uint32_t buf[4];
+	buf[1] = (uint32_t)desc;
+	buf[2] = (uint32_t)msg;
+	buf[3] = (uint32_t)reply;
+
+	system_call(FOS_SYSCALL_FOS_IPC_SEND, buf);
+
+	return (fos_ret_t)buf[0];
+}
+
+
+// receive message
+fos_ret_t SYS_FOS_IpcReceive(fos_ipc_msg_t *msg)
+{
+	uint32_t buf[2];
+	buf[1] = (uint32_t)msg;
+
+	system_call(FOS_SYSCALL_FOS_IPC_RECEIVE, buf);
+
+	return (fos_ret_t)buf[0];
+}
+
+
+// reply to the thread with descriptor
+fos_ret_t SYS_FOS_IpcReply(user_desc_t desc, fos_ipc_msg_t *reply)
+{
+	uint32_t buf[3];
+	buf[1] = (uint32_t)desc;
+	buf[2] = (uint32_t)reply;
+
+	system_call(FOS_SYSCALL_FOS_IPC_REPLY, buf);
+
+	return (fos_ret_t)buf[0];
+}
+
+
+// get descriptor of the partner of the last message exchange
+user_desc_t SYS_FOS_IpcGetPartner()
+{
+	uint32_t buf[1];
+
+	system_call(FOS_SYSCALL_FOS_IPC_GET_PARTNER, buf);
+
+	return (user_desc_t)buf[0];
+}
+
+
+// set CPU reservation of thread group
+fos_ret_t SYS_FOS_SetGroup(uint8_t group, uint32_t reserve_us, uint32_t budget_us, uint32_t period_ms)
+{
+	uint32_t buf[5];
+	buf[1] = (uint32_t)group;
+	buf[2] = (uint32_t)reserve_us;
+	buf[3] = (uint32_t)budget_us;
+	buf[4] = (uint32_t)period_ms;
+
+	system_call(FOS_SYSCALL_FOS_SET_GROUP, buf);
+
+	return (fos_ret_t)buf[0];
+}
+
+
+// move the thread with descriptor to the group
+fos_ret_t SYS_FOS_SetThreadGroupDesc(user_desc_t desc, uint8_t group)
+{
+	uint32_t buf[3];
+	buf[1] = (uint32_t)desc;
+	buf[2] = (uint32_t)group;
+
+	system_call(FOS_SYSCALL_FOS_SET_THREAD_GROUP, buf);
+
+	return (fos_ret_t)buf[0];
+}
+
+
+// start time-triggered cyclic executive with the table
+fos_ret_t SYS_FOS_TtStart(const fos_tt_table_t *table)
+{
+	uint32_t buf[2];
+	buf[1] = (uint32_t)table;
+
+	system_call(FOS_SYSCALL_FOS_TT_START, buf);
+
+	return (fos_ret_t)buf[0];
+}
+
+
+// stop time-triggered cyclic executive
+fos_ret_t SYS_FOS_TtStop()
+{
+	uint32_t buf[1];
+
+	system_call(FOS_SYSCALL_FOS_TT_STOP, buf);
+
+	return (fos_ret_t)buf[0];
+}
+
+
+// complete the job of the current thread and wait for its next slot of the time-triggered table
+fos_ret_t SYS_FOS_TtWaitNextSlot()
+{
+	uint32_t buf[1];
+
+	system_call(FOS_SYSCALL_FOS_TT_WAIT_NEXT_SLOT, buf);
+
+	return (fos_ret_t)buf[0];
+}
+
+
+// set own priority of the thread with descriptor
+fos_ret_t SYS_FOS_SetPriorityDesc(user_desc_t desc, uint8_t priority)
+{
+	uint32_t buf[3];
+	buf[1] = (uint32_t)desc;
+	buf[2] = (uint32_t)priority;
+
+	system_call(FOS_SYSCALL_FOS_SET_PRIORITY, buf);
+
+	return (fos_ret_t)buf[0];
+}
+
+
+// suspend the thread with descriptor
+fos_ret_t SYS_FOS_SuspendDesc(user_desc_t desc)
+{
+	uint32_t buf[2];
+	buf[1] = (uint32_t)desc;
+
+	system_call(FOS_SYSCALL_FOS_SUSPEND, buf);
+
+	return (fos_ret_t)buf[0];
+}
+
+
+// resume the thread with descriptor
+fos_ret_t SYS_FOS_ResumeDesc(user_desc_t desc)
+{
+	uint32_t buf[2];
+	buf[1] = (uint32_t)desc;
+
+	system_call(FOS_SYSCALL_FOS_RESUME, buf);
+
+	return (fos_ret_t)buf[0];
+}
+
+
 
 
 
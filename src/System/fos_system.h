@@ -25,6 +25,7 @@
 
 
 #include "Thread/fos_thread.h"
+#include "Thread/fos_tt.h"
 #include "File/Sys/file_sys.h"
 
 
@@ -35,6 +36,18 @@ void SYS_FOS_Yield();
 // используется в слабом подтягивании
 fos_ret_t SYS_FOS_Sleep(uint32_t time);
 
+// усыпить текущий поток до момента *last_wake + period
+fos_ret_t SYS_FOS_SleepUntil(uint32_t *last_wake, uint32_t period);
+
+// усыпить текущий поток на time_us мкс
+fos_ret_t SYS_FOS_SleepUs(uint32_t time_us);
+
+// усыпить текущий поток до момента *last_wake_us + period_us в мкс
+fos_ret_t SYS_FOS_SleepUntilUs(fos_time_t *last_wake_us, uint32_t period_us);
+
+// получить монотонное время ядра в мкс
+fos_time_t SYS_FOS_GetTimeUs();
+
 // взять бинарный светофор
 fos_ret_t SYS_FOS_SemBinaryTake(user_desc_t semb);
 
@@ -116,6 +129,80 @@ fos_ret_t SYS_FOS_Queue32ReadData(user_desc_t que, uint32_t* data_ptr);
 // write data to queue32
 fos_ret_t SYS_FOS_Queue32WriteData(user_desc_t que, uint32_t data);
 
+// set time slice of the thread with descriptor
+fos_ret_t SYS_FOS_SetQuantumDesc(user_desc_t desc, uint32_t quantum_us);
+
+// complete the current job of the periodic thread and wait for the next release
+fos_ret_t SYS_FOS_WaitNextPeriod();
+
+// create mutex
+user_desc_t SYS_FOS_CreateMutex(uint8_t ceiling);
+
+// delete mutex
+fos_ret_t SYS_FOS_DeleteMutex(user_desc_t mtx);
+
+// lock mutex
+fos_ret_t SYS_FOS_MutexLock(user_desc_t mtx);
+
+// unlock mutex
+fos_ret_t SYS_FOS_MutexUnlock(user_desc_t mtx);
+
+// complete the job of the current run-to-completion thread
+fos_ret_t SYS_FOS_RtcJobComplete();
+
+// lock the scheduler (no system call)
+void SYS_FOS_SchedLock();
+
+// unlock the scheduler (no system call unless a switch has been deferred)
+void SYS_FOS_SchedUnlock();
+
+// set CPU budget of the thread with descriptor
+fos_ret_t SYS_FOS_SetBudgetDesc(user_desc_t desc, uint32_t budget_us, uint32_t period_ms);
+
+// hand the rest of the time slice to the ready thread with descriptor
+fos_ret_t SYS_FOS_YieldToDesc(user_desc_t desc);
+
+// release binary semaphore and hand the rest of the time slice to the unblocked thread
+fos_ret_t SYS_FOS_SemBinaryGiveSwitch(user_desc_t semb);
+
+// send message to the thread with descriptor and wait for the reply
+fos_ret_t SYS_FOS_IpcSend(user_desc_t desc, fos_ipc_msg_t *msg, fos_ipc_msg_t *reply);
+
+// receive message
+fos_ret_t SYS_FOS_IpcReceive(fos_ipc_msg_t *msg);
+
+// reply to the thread with descriptor
+fos_ret_t SYS_FOS_IpcReply(user_desc_t desc, fos_ipc_msg_t *reply);
+
+// get descriptor of the partner of the last message exchange
+user_desc_t SYS_FOS_IpcGetPartner();
+
+// set CPU reservation of thread group
+fos_ret_t SYS_FOS_SetGroup(uint8_t group, uint32_t reserve_us, uint32_t budget_us, uint32_t period_ms);
+
+// move the thread with descriptor to the group
+fos_ret_t SYS_FOS_SetThreadGroupDesc(user_desc_t desc, uint8_t group);
+
+
+// start time-triggered cyclic executive with the table
+fos_ret_t SYS_FOS_TtStart(const fos_tt_table_t *table);
+
+// stop time-triggered cyclic executive
+fos_ret_t SYS_FOS_TtStop();
+
+// complete the job of the current thread and wait for its next slot of the time-triggered table
+fos_ret_t SYS_FOS_TtWaitNextSlot();
+
+
+// set own priority of the thread with descriptor
+fos_ret_t SYS_FOS_SetPriorityDesc(user_desc_t desc, uint8_t priority);
+
+// suspend the thread with descriptor
+fos_ret_t SYS_FOS_SuspendDesc(user_desc_t desc);
+
+// resume the thread with descriptor
+fos_ret_t SYS_FOS_ResumeDesc(user_desc_t desc);
+
 
 #endif /* APPLICATION_FOS_SYSTEM_FOS_SYSTEM_H_ */
 
@@ -0,0 +1,149 @@
+/**************************************************************************//**
+ * @file      fos_group.c
+ * @brief     CPU reservation of thread group. Source file.
+ * @version   V1.0.00
+ * @date      16.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "Thread/fos_group.h"
+#include "Platform/sl_platform.h"
+#include <string.h>
+
+
+// начать новый период, если текущий закончился
+static void Private_FOS_Group_Replenish(fos_group_t *p);
+
+
+// инициализация
+void FOS_Group_Init(fos_group_t *p)
+{
+	if(p == NULL)
+		return;
+
+	memset(p, 0, sizeof(fos_group_t));
+}
+
+
+// настроить группу: reserve_us гарантировано и не более budget_us в каждом периоде period_ms
+// FOS__FAIL - гарантия больше периода
+fos_ret_t FOS_Group_Set(fos_group_t *p, uint32_t reserve_us, uint32_t budget_us, uint32_t period_ms)
+{
+	if(p == NULL)
+		return FOS__FAIL;
+
+	if(period_ms && (reserve_us > period_ms * 1000))
+		return FOS__FAIL;
+
+	// предельное время не меньше периода - ограничения нет
+	if((period_ms == 0) || (budget_us >= period_ms * 1000))
+		budget_us = 0;
+
+	// гарантия не больше предела
+	if(budget_us && (reserve_us > budget_us))
+		reserve_us = budget_us;
+	if(period_ms == 0)
+		reserve_us = 0;
+
+	p->reserve_us = reserve_us;
+	p->budget_us  = budget_us;
+	p->period_ms  = period_ms;
+
+	// новый период начинается сейчас
+	p->period_ts = SL_GetTick();
+	p->used_us   = 0;
+
+	return FOS__OK;
+}
+
+
+// учесть время выполнения потока группы (возвращает FOS__ENABLE, если предельное время исчерпано)
+fos_sw_t FOS_Group_Charge(fos_group_t *p, uint32_t dt_us)
+{
+	if((p == NULL) || (p->period_ms == 0))
+		return FOS__DISABLE;
+
+	Private_FOS_Group_Replenish(p);
+
+	p->used_us += dt_us;
+	if((p->budget_us == 0) || (p->used_us < p->budget_us))
+		return FOS__DISABLE;
+
+	p->throttle_cnt++;
+
+	return FOS__ENABLE;
+}
+
+
+// исчерпано ли предельное время группы в текущем периоде
+fos_sw_t FOS_Group_IsThrottled(fos_group_t *p)
+{
+	if((p == NULL) || (p->budget_us == 0))
+		return FOS__DISABLE;
+
+	Private_FOS_Group_Replenish(p);
+
+	return (p->used_us >= p->budget_us) ? FOS__ENABLE : FOS__DISABLE;
+}
+
+
+// получила ли группа меньше гарантированного времени в текущем периоде
+fos_sw_t FOS_Group_IsReserved(fos_group_t *p)
+{
+	if((p == NULL) || (p->reserve_us == 0))
+		return FOS__DISABLE;
+
+	Private_FOS_Group_Replenish(p);
+
+	return (p->used_us < p->reserve_us) ? FOS__ENABLE : FOS__DISABLE;
+}
+
+
+// получить остаток предельного времени группы в мкс (FOS_INF_TIME - без ограничения)
+uint32_t FOS_Group_GetBudgetLeft(fos_group_t *p)
+{
+	if((p == NULL) || (p->budget_us == 0))
+		return FOS_INF_TIME;
+
+	Private_FOS_Group_Replenish(p);
+
+	return (p->used_us < p->budget_us) ? (p->budget_us - p->used_us) : 0;
+}
+
+
+// получить время начала следующего периода
+uint32_t FOS_Group_GetPeriodEnd(fos_group_t *p)
+{
+	if(p == NULL)
+		return 0;
+
+	return p->period_ts + p->period_ms;
+}
+
+
+// начать новый период, если текущий закончился
+static void Private_FOS_Group_Replenish(fos_group_t *p)
+{
+	uint32_t now = SL_GetTick();
+
+	// окно сдвигается на целое число периодов, поэтому границы окон не уплывают от момента проверки
+	if(FOS_TIME_AFTER_EQ(now, p->period_ts + p->period_ms))
+	{
+		p->period_ts += ((now - p->period_ts) / p->period_ms) * p->period_ms;
+		p->used_us    = 0;
+	}
+}
@@ -0,0 +1,67 @@
+/**************************************************************************//**
+ * @file      fos_group.h
+ * @brief     CPU reservation of thread group. Header file.
+ * @version   V1.0.00
+ * @date      16.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef APPLICATION_FOS_THREAD_FOS_GROUP_H_
+#define APPLICATION_FOS_THREAD_FOS_GROUP_H_
+
+
+#include "fos_types.h"
+
+
+// группа потоков с резервированием процессорного времени
+typedef struct
+{
+	uint32_t reserve_us;                 // гарантированное время группы в каждом периоде, мкс (0 - без гарантии)
+	uint32_t budget_us;                  // предельное время группы в каждом периоде, мкс (0 - без ограничения)
+	uint32_t period_ms;                  // период, мс (0 - группа не настроена)
+
+	volatile uint32_t period_ts;         // начало текущего периода
+	volatile uint32_t used_us;           // время, израсходованное потоками группы в текущем периоде, мкс
+	volatile uint32_t throttle_cnt;      // число исчерпаний предельного времени
+
+} fos_group_t;
+
+
+// инициализация
+void FOS_Group_Init(fos_group_t *p);
+
+// настроить группу: reserve_us гарантировано и не более budget_us в каждом периоде period_ms
+// FOS__FAIL - гарантия больше периода
+fos_ret_t FOS_Group_Set(fos_group_t *p, uint32_t reserve_us, uint32_t budget_us, uint32_t period_ms);
+
+// учесть время выполнения потока группы (возвращает FOS__ENABLE, если предельное время исчерпано)
+fos_sw_t FOS_Group_Charge(fos_group_t *p, uint32_t dt_us);
+
+// исчерпано ли предельное время группы в текущем периоде
+fos_sw_t FOS_Group_IsThrottled(fos_group_t *p);
+
+// получила ли группа меньше гарантированного времени в текущем периоде
+fos_sw_t FOS_Group_IsReserved(fos_group_t *p);
+
+// получить остаток предельного времени группы в мкс (FOS_INF_TIME - без ограничения)
+uint32_t FOS_Group_GetBudgetLeft(fos_group_t *p);
+
+// получить время начала следующего периода
+uint32_t FOS_Group_GetPeriodEnd(fos_group_t *p);
+
+
+#endif /* APPLICATION_FOS_THREAD_FOS_GROUP_H_ */
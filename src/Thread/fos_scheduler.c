@@ -22,135 +22,263 @@
 
 #include "Thread/fos_scheduler.h"
 #include "Platform/sl_platform.h"
+#if defined(FOS_USE_SCHED_PROFILE)
+	#include "Platform/fos_tim_platform.h"
+#endif
 #include <string.h>
 
 
-// спланировать задачу (возвращает номре выбранной задачи или -1, если её нет)
-int16_t FOS_Schedule(fos_scheduler_t *ptr, volatile fos_thread_ptr *thr_desc_list, uint8_t thr_max_id)
+// поставить поток в конец списка приоритета
+static void Private_FOS_Schedule_Insert(fos_ready_queue_t *rq, fos_id_t id, uint8_t pr);
+
+// удалить поток из списка его приоритета
+static void Private_FOS_Schedule_Remove(fos_ready_queue_t *rq, fos_id_t id);
+
+#if defined(FOS_USE_AGING)
+// поднять приоритет готовых потоков, которые слишком долго ждут выполнения
+static void Private_FOS_Schedule_Aging(fos_scheduler_t *ptr, fos_id_t current_thr);
+
+// вернуть поток, поднятый старением, в список его приоритета
+static void Private_FOS_Schedule_ResetBoost(fos_ready_queue_t *rq, fos_id_t id);
+#endif
+
+/*
+ * Политика фиксированных приоритетов
+ */
+
+// инициализация очередей
+static void Private_FOS_SchedPrio_Init(fos_scheduler_t *ptr);
+
+// поставить готовый поток в очередь или обновить его положение
+static void Private_FOS_SchedPrio_Enqueue(fos_scheduler_t *ptr, fos_id_t id, fos_thread_t *thr);
+
+// удалить поток из очереди
+static void Private_FOS_SchedPrio_Dequeue(fos_scheduler_t *ptr, fos_id_t id);
+
+// выбрать следующий поток
+static int16_t Private_FOS_SchedPrio_PickNext(fos_scheduler_t *ptr, fos_id_t current_thr);
+
+// учесть время работы потока
+static void Private_FOS_SchedPrio_Tick(fos_scheduler_t *ptr, fos_id_t id, uint32_t thr_dt_us);
+
+// должен ли поток a вытеснить поток b
+static fos_sw_t Private_FOS_SchedPrio_IsPreempting(fos_thread_t *a, fos_thread_t *b);
+
+// поставить поток в список приоритета pr (FOS_NO_PRIORITY - убрать из списков)
+static void Private_FOS_SchedPrio_Place(fos_ready_queue_t *rq, fos_id_t id, uint8_t pr);
+
+// выбрать следующий поток среди принятых фильтром
+static int16_t Private_FOS_SchedPrio_PickFiltered(fos_scheduler_t *ptr, fos_id_t current_thr, fos_sched_filter_t filter, void *ctx);
+
+// выбрать поток, принятый фильтром, в списках приоритетов из битовой карты bmp
+static int16_t Private_FOS_SchedPrio_PickIn(fos_ready_queue_t *rq, uint32_t bmp, fos_id_t current_thr, fos_sched_filter_t filter, void *ctx);
+
+
+/*
+ * Политика EDF поверх фиксированных приоритетов
+ */
+
+// инициализация очередей
+static void Private_FOS_SchedEdf_Init(fos_scheduler_t *ptr);
+
+// поставить готовый поток в очередь или обновить его положение
+static void Private_FOS_SchedEdf_Enqueue(fos_scheduler_t *ptr, fos_id_t id, fos_thread_t *thr);
+
+// удалить поток из очереди
+static void Private_FOS_SchedEdf_Dequeue(fos_scheduler_t *ptr, fos_id_t id);
+
+// выбрать следующий поток
+static int16_t Private_FOS_SchedEdf_PickNext(fos_scheduler_t *ptr, fos_id_t current_thr);
+
+// выбрать следующий поток среди принятых фильтром
+static int16_t Private_FOS_SchedEdf_PickFiltered(fos_scheduler_t *ptr, fos_id_t current_thr, fos_sched_filter_t filter, void *ctx);
+
+// должен ли поток a вытеснить поток b
+static fos_sw_t Private_FOS_SchedEdf_IsPreempting(fos_thread_t *a, fos_thread_t *b);
+
+
+// политика фиксированных приоритетов с циклическим обходом (периодические потоки - на своём приоритете)
+const fos_sched_policy_t fos_sched_policy_prio =
 {
-	if((ptr == NULL) || (thr_desc_list == NULL) || (thr_max_id >= FOS_MAX_THR_CNT))
-		return -1;
+	.init          = Private_FOS_SchedPrio_Init,
+	.enqueue       = Private_FOS_SchedPrio_Enqueue,
+	.dequeue       = Private_FOS_SchedPrio_Dequeue,
+	.on_block      = Private_FOS_SchedPrio_Dequeue,
+	.pick_next     = Private_FOS_SchedPrio_PickNext,
+	.pick_filtered = Private_FOS_SchedPrio_PickFiltered,
+	.tick          = Private_FOS_SchedPrio_Tick,
+	.is_preempting = Private_FOS_SchedPrio_IsPreempting,
+};
+
+
+// политика фиксированных приоритетов, периодические потоки - по EDF на уровне FOS_EDF_PRIORITY
+const fos_sched_policy_t fos_sched_policy_edf =
+{
+	.init          = Private_FOS_SchedEdf_Init,
+	.enqueue       = Private_FOS_SchedEdf_Enqueue,
+	.dequeue       = Private_FOS_SchedEdf_Dequeue,
+	.on_block      = Private_FOS_SchedEdf_Dequeue,
+	.pick_next     = Private_FOS_SchedEdf_PickNext,
+	.pick_filtered = Private_FOS_SchedEdf_PickFiltered,
+	.tick          = Private_FOS_SchedPrio_Tick,
+	.is_preempting = Private_FOS_SchedEdf_IsPreempting,
+};
 
-	fos_thread_state_t thr_state;      // состояние потока
-	fos_thread_ptr     thr_desc;       // дескриптор потока
-	uint8_t thr_pr;                    // приоритет потока
-	uint8_t ind;                       // индекс
-	uint8_t isActiveThr = 0;           // флаг наличия активного потока
-	uint8_t active_thr;                // индекс активного потока
 
-	/*
-	 * Сбрасываем все списки
-	 */
-	memset(ptr->thr_plist, FOS_EMPTY_ID, FOS_MAX_THR_CNT);
-	memset(ptr->run_list, FOS_EMPTY_ID, FOS_MAX_THR_CNT);
-	memset(ptr->priority_list, 0, FOS_PRIORITY_CNT);
+/*
+ * Политика выбирается при компиляции (FOS_SCHED_POLICY) - вызовы через константную таблицу подставляются компилятором напрямую,
+ * либо во время работы (FOS_USE_SCHED_POLICY_RUNTIME) - через указатель в планировщике
+ */
+#if defined(FOS_USE_SCHED_POLICY_RUNTIME)
+	#define FOS_SCHED_POLICY_GET(ptr)   ((ptr)->policy)
+#else
+	#define FOS_SCHED_POLICY_GET(ptr)   (&FOS_SCHED_POLICY)
+#endif
+
+
+// инициализация
+void FOS_Schedule_Init(fos_scheduler_t *ptr)
+{
+	if(ptr == NULL)
+		return;
+
+#if defined(FOS_USE_SCHED_POLICY_RUNTIME)
+	ptr->policy = &FOS_SCHED_POLICY;
+#endif
 
+	memset(ptr->ready, 0, sizeof(ptr->ready));
 	ptr->ready_thr_cnt = 0;
-	ptr->run_list_cnt = 0;
 
-	/*
-	 * Строим список потоков
-	 */
-	for(uint8_t i = 0; i <= thr_max_id; i++)         // перебираем все потоки
-	{
-		thr_desc = thr_desc_list[i];                 // получаем дескриптор очередного потока
-		if(thr_desc == NULL)                         // проверяем что он есть
-			continue;
+	FOS_SCHED_POLICY_GET(ptr)->init(ptr);
+}
 
-		thr_state = thr_desc->var.state;             // получаем состояние
-		thr_pr = thr_desc->set.priotity;             // получаем приоритет
-		if(thr_pr >= FOS_PRIORITY_CNT)               // проверяем приоритет
-			thr_pr = FOS_PRIORITY_CNT - 1;
 
-		// если поток запущен или готов к выполнению
-		if((thr_state == FOS__THREAD_READY) || (thr_state == FOS__THREAD_RUNNING))
-		{
-			ptr->thr_plist[i] = thr_pr;         // ставим его приоритет в списке потоков
-			ptr->priority_list[thr_pr]++;       // инкрементируем счётчик в списке приоритетов
-			ptr->ready_thr_cnt++;               // инкрементируем счётчик готовых потоков
-		}else
-		{
-			ptr->thr_plist[i] = FOS_SUSPEND_BLOCKED_ID;  // иначе, ставем индекс спащего/заблокированного потока
-		}
-	}
+#if defined(FOS_USE_SCHED_POLICY_RUNTIME)
+// сменить политику планирования (очередь готовых должна быть пуста)
+fos_ret_t FOS_Schedule_SetPolicy(fos_scheduler_t *ptr, const fos_sched_policy_t *policy)
+{
+	if((ptr == NULL) || (policy == NULL) || ptr->ready_thr_cnt)
+		return FOS__FAIL;
 
-	// если готовых задач нет
-	if(ptr->ready_thr_cnt == 0)
-		return -1;                   // возвращаем -1
+	ptr->policy = policy;
+	policy->init(ptr);
 
-	/*
-	 * Ищем максимальный приоритет потока
-	 */
-	thr_pr = 0;                                          // изначально приоритет наивысший
-	for(uint8_t i = 0; i < FOS_PRIORITY_CNT; i++)        // перебираем список приоритетов
-	{
-		if(ptr->priority_list[thr_pr] != 0)              // если не 0
-			break;                                       // выходим
-		thr_pr++;                                        // иначе понижаем приоритет (увеличиваем значение приоритета)
-	}
+	return FOS__OK;
+}
+#endif
 
-	/*
-	 * Заполняем список задач на выполнение
-	 */
-	ind = 0;
-	for(uint8_t i = 0; i <= thr_max_id; i++)             // перебираем все потоки
-	{
-		if(ptr->thr_plist[i] == thr_pr)                  // находим поток с целевым приоритетом (его получили на предыдущем шаге)
-		{
-			ptr->run_list[ind] = i;                      // запоминаем индекс потокв в списк выполнения
-			ind++;                                       // увеличиваем индекс
 
-			thr_desc = thr_desc_list[i];                 // получаем дескриптор поток
-			if(thr_desc == NULL)                         // проверяем что он есть (избыточно!!!)
-				continue;
+// обновить положение потока в очереди готовых в соответствии с его состоянием и приоритетом
+// thr == NULL - удалить поток из очереди
+void FOS_Schedule_UpdThread(fos_scheduler_t *ptr, fos_id_t id, fos_thread_t *thr)
+{
+	if((ptr == NULL) || (id >= FOS_MAX_THR_CNT))
+		return;
 
-			// обрабатываем ситуацию что это был активный поток
-			if(thr_desc->var.state == FOS__THREAD_RUNNING)
-			{
-				isActiveThr = 1;                         // ставим флаг наличия активного потока
-				active_thr = i;                          // запоминаем его индекс
-			}
-		}
-	}
-	ptr->run_list_cnt = ind;                             // запоминаем число потоков в списке выполнения
+	const fos_sched_policy_t *policy = FOS_SCHED_POLICY_GET(ptr);
+	uint32_t s;
 
-	/*
-	 * Если на очереди одна задача
-	 */
-	if(ptr->run_list_cnt == 1)
-		return ptr->run_list[0];        // возвращаем ее индекс
+	// в очереди стоят только запущенные и готовые к выполнению потоки
+	fos_sw_t ready_sw = (thr && ((thr->hot->state == FOS__THREAD_READY) || (thr->hot->state == FOS__THREAD_RUNNING))) ? FOS__ENABLE : FOS__DISABLE;
 
-	/*
-	 * Если на очерди более одной задачи и нет активной
-	 */
-	if(isActiveThr == 0)
-		return ptr->run_list[0];        // возвращаем индекс первой в списке выполнения задачи
+	ENTER_CRITICAL(s);
 
-	/*
-	 * Если на очерди более одной задачи и есть активная
-	 */
-	for(uint8_t i = 0; i < ptr->run_list_cnt; i++)       // перебираем все задачи в списке выполнения
+	if(ready_sw)
 	{
-		// ищем активную задачу
-		if(ptr->run_list[i] == active_thr)
+		policy->enqueue(ptr, id, thr);
+
+		if(!ptr->ready[id])
 		{
-			ind = i;                                     // запоминаем индекс активной задачи в списке выполнения
-			break;                                       // выходим
+			ptr->ready[id] = 1;
+			ptr->ready_thr_cnt++;
 		}
+	}else if(ptr->ready[id])
+	{
+		if(thr && (thr->hot->state == FOS__THREAD_BLOCKED))
+			policy->on_block(ptr, id);
+		else
+			policy->dequeue(ptr, id);
+
+		ptr->ready[id] = 0;
+		ptr->ready_thr_cnt--;
 	}
 
-	// циклически переходим на следующую за активной задачей
-	ind++;
-	if(ind >=  ptr->run_list_cnt)      // кольцуем задачи
-		ind = 0;
+	LEAVE_CRITICAL(s);
+}
+
+
+// должен ли поток a вытеснить поток b
+fos_sw_t FOS_Schedule_IsPreempting(fos_scheduler_t *ptr, fos_thread_t *a, fos_thread_t *b)
+{
+	if(ptr == NULL)
+		return FOS__DISABLE;
+
+	return FOS_SCHED_POLICY_GET(ptr)->is_preempting(a, b);
+}
+
+
+// учесть время работы потока перед выбором следующего
+void FOS_Schedule_Tick(fos_scheduler_t *ptr, fos_id_t id, uint32_t thr_dt_us)
+{
+	if(ptr == NULL)
+		return;
 
-	// возвращаем индекс очередной задачи
-	return ptr->run_list[ind];
+	uint32_t s;
+	ENTER_CRITICAL(s);
+	FOS_SCHED_POLICY_GET(ptr)->tick(ptr, id, thr_dt_us);
+	LEAVE_CRITICAL(s);
+}
+
+
+// спланировать задачу (возвращает номре выбранной задачи или -1, если её нет)
+// current_thr - индекс последнего выполнявшегося потока
+int16_t FOS_Schedule(fos_scheduler_t *ptr, fos_id_t current_thr)
+{
+	if(ptr == NULL)
+		return -1;
+
+	int16_t id;
+	uint32_t s;
+
+	ENTER_CRITICAL(s);
+#if defined(FOS_USE_SCHED_PROFILE)
+	uint32_t t0 = FOS_Platform_TimeBase_GetCounter();
+#endif
+	id = FOS_SCHED_POLICY_GET(ptr)->pick_next(ptr, current_thr);
+#if defined(FOS_USE_SCHED_PROFILE)
+	uint32_t dt = FOS_Platform_TimeBase_GetCounter() - t0;    // только выбор, без входа в критическую секцию
+	ptr->dbg.pick_ticks_last = dt;
+	ptr->dbg.pick_ticks_sum += dt;
+	ptr->dbg.pick_cnt++;
+	if(dt > ptr->dbg.pick_ticks_max)
+		ptr->dbg.pick_ticks_max = dt;
+#endif
+	LEAVE_CRITICAL(s);
+
+	return id;
+}
+
+
+// спланировать задачу среди готовых потоков, принятых фильтром (-1 - таких нет)
+// порядок тот же, что у FOS_Schedule: по приоритету и по очереди внутри приоритета
+int16_t FOS_Schedule_Filtered(fos_scheduler_t *ptr, fos_id_t current_thr, fos_sched_filter_t filter, void *ctx)
+{
+	if((ptr == NULL) || (filter == NULL))
+		return -1;
+
+	int16_t id;
+	uint32_t s;
+
+	ENTER_CRITICAL(s);
+	id = FOS_SCHED_POLICY_GET(ptr)->pick_filtered(ptr, current_thr, filter, ctx);
+	LEAVE_CRITICAL(s);
+
+	return id;
 }
 
 
 // отладка
-void FOS_ScheduleDbg(fos_scheduler_t *ptr, uint8_t thr_max_id, uint8_t id, uint32_t thr_dt_us)
+void FOS_ScheduleDbg(fos_scheduler_t *ptr, fos_id_t thr_max_id, fos_id_t id, uint32_t thr_dt_us)
 {
 	const uint32_t period_ms = 1000;
 
@@ -165,7 +293,7 @@ void FOS_ScheduleDbg(fos_scheduler_t *ptr, uint8_t thr_max_id, uint8_t id, uint3
 
 	uint32_t all_dt_us = 0;
 
-	for(uint8_t i = 0; i <= thr_max_id; i++)
+	for(fos_id_t i = 0; i <= thr_max_id; i++)
 	{
 		ptr->dbg.thr_active_per_1s[i] = ptr->var.curr_dt_us[i] / period_ms;    // получем число мк за мс
 		ptr->var.curr_dt_us[i] = 0;
@@ -179,5 +307,393 @@ void FOS_ScheduleDbg(fos_scheduler_t *ptr, uint8_t thr_max_id, uint8_t id, uint3
 }
 
 
+/*
+ * Политика фиксированных приоритетов
+ */
+
+// инициализация очередей
+static void Private_FOS_SchedPrio_Init(fos_scheduler_t *ptr)
+{
+	memset(ptr->rq.next, FOS_EMPTY_ID, sizeof(ptr->rq.next));
+	memset(ptr->rq.prev, FOS_EMPTY_ID, sizeof(ptr->rq.prev));
+	memset(ptr->rq.prio, FOS_NO_PRIORITY, sizeof(ptr->rq.prio));
+	memset(ptr->rq.head, FOS_EMPTY_ID, sizeof(ptr->rq.head));
+	ptr->rq.prio_bmp = 0;
+
+#if defined(FOS_USE_AGING)
+	memset(ptr->rq.boost, 0, sizeof(ptr->rq.boost));
+	memset(ptr->rq.wait_ts, 0, sizeof(ptr->rq.wait_ts));
+	ptr->rq.aging_ts = 0;
+#endif
+}
+
+
+// поставить готовый поток в очередь или обновить его положение
+static void Private_FOS_SchedPrio_Enqueue(fos_scheduler_t *ptr, fos_id_t id, fos_thread_t *thr)
+{
+	fos_ready_queue_t *rq = &ptr->rq;
+	uint8_t thr_pr = thr->hot->priotity;   // получаем приоритет
+
+#if defined(FOS_USE_AGING)
+	/*
+	 * Повышение старением сбрасывается при пересчёте приоритета,
+	 * время ожидания отсчитывается с момента перехода в готовые
+	 */
+	rq->boost[id] = 0;
+	if(!ptr->ready[id])
+		rq->wait_ts[id] = SL_GetTick();
+#endif
+
+	if(thr_pr >= FOS_PRIORITY_CNT)         // проверяем приоритет
+		thr_pr = FOS_PRIORITY_CNT - 1;
+
+	Private_FOS_SchedPrio_Place(rq, id, thr_pr);
+}
+
+
+// поставить поток в список приоритета pr (FOS_NO_PRIORITY - убрать из списков)
+static void Private_FOS_SchedPrio_Place(fos_ready_queue_t *rq, fos_id_t id, uint8_t pr)
+{
+	if(rq->prio[id] == pr)                         // положение потока в очереди не изменилось
+		return;
+
+	if(rq->prio[id] != FOS_NO_PRIORITY)            // удаляем из старого списка
+		Private_FOS_Schedule_Remove(rq, id);
+
+	if(pr != FOS_NO_PRIORITY)                      // ставим в конец нового списка
+		Private_FOS_Schedule_Insert(rq, id, pr);
+}
+
+
+// удалить поток из очереди
+static void Private_FOS_SchedPrio_Dequeue(fos_scheduler_t *ptr, fos_id_t id)
+{
+	if(ptr->rq.prio[id] != FOS_NO_PRIORITY)
+		Private_FOS_Schedule_Remove(&ptr->rq, id);
+
+#if defined(FOS_USE_AGING)
+	ptr->rq.boost[id] = 0;
+#endif
+}
 
 
+// выбрать следующий поток
+static int16_t Private_FOS_SchedPrio_PickNext(fos_scheduler_t *ptr, fos_id_t current_thr)
+{
+	fos_ready_queue_t *rq = &ptr->rq;
+	uint8_t  thr_pr;                    // приоритет потока
+	fos_id_t id;                       // индекс выбранного потока
+
+	// если готовых задач нет
+	if(rq->prio_bmp == 0)
+		return -1;                     // возвращаем -1
+
+	// наивысший приоритет среди готовых потоков
+	thr_pr = FOS_CLZ(rq->prio_bmp);
+
+	id = rq->head[thr_pr];             // поток, чья очередь выполняться
+
+	/*
+	 * Если только что выполнялся поток, чья очередь выполняться,
+	 * циклически переходим на следующий за ним поток того же приоритета
+	 */
+	if(id == current_thr)
+	{
+		id = rq->next[id];
+		rq->head[thr_pr] = id;
+	}
+
+#if defined(FOS_USE_AGING)
+	// выбранный поток дождался выполнения - повышение сбрасывается
+	if(rq->boost[id])
+		Private_FOS_Schedule_ResetBoost(rq, id);
+#endif
+
+	return id;
+}
+
+
+// выбрать следующий поток среди принятых фильтром
+static int16_t Private_FOS_SchedPrio_PickFiltered(fos_scheduler_t *ptr, fos_id_t current_thr, fos_sched_filter_t filter, void *ctx)
+{
+	return Private_FOS_SchedPrio_PickIn(&ptr->rq, ptr->rq.prio_bmp, current_thr, filter, ctx);
+}
+
+
+// выбрать поток, принятый фильтром, в списках приоритетов из битовой карты bmp
+static int16_t Private_FOS_SchedPrio_PickIn(fos_ready_queue_t *rq, uint32_t bmp, fos_id_t current_thr, fos_sched_filter_t filter, void *ctx)
+{
+	uint8_t  pr;
+	fos_id_t id;
+	int16_t  current_id;
+
+	// списки от наивысшего приоритета, обходятся только готовые потоки
+	while(bmp)
+	{
+		pr  = FOS_CLZ(bmp);
+		bmp &= ~(0x80000000UL >> pr);
+
+		current_id = -1;
+		id = rq->head[pr];
+
+		do
+		{
+			if(filter(ctx, id))
+			{
+				if(id != current_thr)
+				{
+					rq->head[pr] = id;    // очередь переходит к выбранному, следующий выбор начнётся после него
+					return id;
+				}
+				current_id = id;          // только что выполнявшийся поток идёт после остальных
+			}
+			id = rq->next[id];
+		}while(id != rq->head[pr]);
+
+		if(current_id >= 0)
+			return current_id;
+	}
+
+	return -1;
+}
+
+
+// учесть время работы потока
+static void Private_FOS_SchedPrio_Tick(fos_scheduler_t *ptr, fos_id_t id, uint32_t thr_dt_us)
+{
+	(void)thr_dt_us;
+
+#if defined(FOS_USE_AGING)
+	Private_FOS_Schedule_Aging(ptr, id);
+#else
+	(void)ptr;
+	(void)id;
+#endif
+}
+
+
+// должен ли поток a вытеснить поток b
+static fos_sw_t Private_FOS_SchedPrio_IsPreempting(fos_thread_t *a, fos_thread_t *b)
+{
+	if(a == NULL)
+		return FOS__DISABLE;
+	if(b == NULL)
+		return FOS__ENABLE;
+
+	return (a->hot->priotity < b->hot->priotity) ? FOS__ENABLE : FOS__DISABLE;    // чем меньше значение, тем выше приоритет
+}
+
+
+/*
+ * Политика EDF поверх фиксированных приоритетов: готовые периодические потоки упорядочены
+ * по крайнему сроку текущего задания и идут впереди потоков уровня FOS_EDF_PRIORITY,
+ * остальные потоки планируются политикой фиксированных приоритетов
+ */
+
+// инициализация очередей
+static void Private_FOS_SchedEdf_Init(fos_scheduler_t *ptr)
+{
+	Private_FOS_SchedPrio_Init(ptr);
+	FOS_TQueue_Init(&ptr->edf);
+}
+
+
+// поставить готовый поток в очередь или обновить его положение
+static void Private_FOS_SchedEdf_Enqueue(fos_scheduler_t *ptr, fos_id_t id, fos_thread_t *thr)
+{
+	if(FOS_Thread_IsPeriodic(thr))
+	{
+		FOS_TQueue_Insert(&ptr->edf, id, thr->rt.deadline_ts);
+		Private_FOS_SchedPrio_Place(&ptr->rq, id, FOS_NO_PRIORITY);    // поток не в списках приоритетов
+	}else
+	{
+		FOS_TQueue_Remove(&ptr->edf, id);
+		Private_FOS_SchedPrio_Enqueue(ptr, id, thr);
+	}
+}
+
+
+// удалить поток из очереди
+static void Private_FOS_SchedEdf_Dequeue(fos_scheduler_t *ptr, fos_id_t id)
+{
+	FOS_TQueue_Remove(&ptr->edf, id);
+	Private_FOS_SchedPrio_Dequeue(ptr, id);
+}
+
+
+// выбрать следующий поток
+static int16_t Private_FOS_SchedEdf_PickNext(fos_scheduler_t *ptr, fos_id_t current_thr)
+{
+	// наивысший приоритет среди готовых потоков с фиксированным приоритетом
+	uint8_t thr_pr = (ptr->rq.prio_bmp != 0) ? FOS_CLZ(ptr->rq.prio_bmp) : FOS_PRIORITY_CNT;
+
+	// периодический поток с самым ранним крайним сроком, если он не ниже по уровню
+#if (FOS_EDF_PRIORITY == 0)
+	(void)thr_pr;
+	if(ptr->edf.first != FOS_EMPTY_ID)                         // уровень 0 не ниже любого
+		return ptr->edf.first;
+#else
+	if((ptr->edf.first != FOS_EMPTY_ID) && (FOS_EDF_PRIORITY <= thr_pr))
+		return ptr->edf.first;
+#endif
+
+	return Private_FOS_SchedPrio_PickNext(ptr, current_thr);
+}
+
+
+// выбрать следующий поток среди принятых фильтром
+static int16_t Private_FOS_SchedEdf_PickFiltered(fos_scheduler_t *ptr, fos_id_t current_thr, fos_sched_filter_t filter, void *ctx)
+{
+	uint32_t above = ~((uint32_t)0xFFFFFFFFUL >> FOS_EDF_PRIORITY);    // уровни выше FOS_EDF_PRIORITY
+	int16_t id;
+
+	id = Private_FOS_SchedPrio_PickIn(&ptr->rq, ptr->rq.prio_bmp & above, current_thr, filter, ctx);
+	if(id >= 0)
+		return id;
+
+	// периодические потоки в порядке крайних сроков
+	for(fos_id_t i = ptr->edf.first; i != FOS_EMPTY_ID; i = ptr->edf.next[i])
+	{
+		if(filter(ctx, i))
+			return i;
+	}
+
+	return Private_FOS_SchedPrio_PickIn(&ptr->rq, ptr->rq.prio_bmp & ~above, current_thr, filter, ctx);
+}
+
+
+// должен ли поток a вытеснить поток b
+static fos_sw_t Private_FOS_SchedEdf_IsPreempting(fos_thread_t *a, fos_thread_t *b)
+{
+	if(a == NULL)
+		return FOS__DISABLE;
+	if(b == NULL)
+		return FOS__ENABLE;
+
+	fos_sw_t a_edf = FOS_Thread_IsPeriodic(a);
+	fos_sw_t b_edf = FOS_Thread_IsPeriodic(b);
+	uint8_t  a_pr  = a_edf ? FOS_EDF_PRIORITY : a->hot->priotity;
+	uint8_t  b_pr  = b_edf ? FOS_EDF_PRIORITY : b->hot->priotity;
+
+	if(a_pr != b_pr)                               // чем меньше значение, тем выше приоритет
+		return (a_pr < b_pr) ? FOS__ENABLE : FOS__DISABLE;
+
+	if(a_edf && b_edf)                             // два периодических потока - раньше крайний срок
+		return FOS_TIME_AFTER_EQ(a->rt.deadline_ts, b->rt.deadline_ts) ? FOS__DISABLE : FOS__ENABLE;
+
+	// на одном уровне периодический поток идёт впереди потоков с фиксированным приоритетом
+	return (a_edf && !b_edf) ? FOS__ENABLE : FOS__DISABLE;
+}
+
+
+// поставить поток в конец списка приоритета
+static void Private_FOS_Schedule_Insert(fos_ready_queue_t *rq, fos_id_t id, uint8_t pr)
+{
+	fos_id_t head = rq->head[pr];
+
+	if(head == FOS_EMPTY_ID)                       // если список пуст
+	{
+		rq->next[id] = id;                         // поток замкнут сам на себя
+		rq->prev[id] = id;
+		rq->head[pr] = id;
+		rq->prio_bmp |= (0x80000000UL >> pr);      // отмечаем приоритет в битовой карте
+	}else
+	{                                              // иначе вставляем перед потоком, чья очередь выполняться
+		fos_id_t tail = rq->prev[head];
+		rq->next[tail] = id;
+		rq->prev[id]   = tail;
+		rq->next[id]   = head;
+		rq->prev[head] = id;
+	}
+
+	rq->prio[id] = pr;
+}
+
+
+// удалить поток из списка его приоритета
+static void Private_FOS_Schedule_Remove(fos_ready_queue_t *rq, fos_id_t id)
+{
+	uint8_t pr = rq->prio[id];
+
+	if(rq->next[id] == id)                         // если поток в списке один
+	{
+		rq->head[pr] = FOS_EMPTY_ID;               // список пуст
+		rq->prio_bmp &= ~(0x80000000UL >> pr);     // снимаем приоритет в битовой карте
+	}else
+	{
+		rq->next[rq->prev[id]] = rq->next[id];     // исключаем поток из кольца
+		rq->prev[rq->next[id]] = rq->prev[id];
+
+		if(rq->head[pr] == id)                     // если была его очередь выполняться
+			rq->head[pr] = rq->next[id];           // очередь переходит к следующему
+	}
+
+	rq->next[id] = FOS_EMPTY_ID;
+	rq->prev[id] = FOS_EMPTY_ID;
+	rq->prio[id] = FOS_NO_PRIORITY;
+}
+
+
+#if defined(FOS_USE_AGING)
+// поднять приоритет готовых потоков, которые слишком долго ждут выполнения
+static void Private_FOS_Schedule_Aging(fos_scheduler_t *ptr, fos_id_t current_thr)
+{
+	fos_ready_queue_t *rq = &ptr->rq;
+	uint32_t ts = SL_GetTick();
+
+	// последний выполнявшийся поток не ждал
+	if(current_thr < FOS_MAX_THR_CNT)
+		rq->wait_ts[current_thr] = ts;
+
+	// проверяем не чаще раза в миллисекунду
+	if(ts == rq->aging_ts)
+		return;
+	rq->aging_ts = ts;
+
+	/*
+	 * Поток встаёт в конец списка своего приоритета, когда становится готовым или отработал,
+	 * поэтому от начала списка потоки идут в порядке ожидания: проверяются только
+	 * начала непустых списков, а не все потоки
+	 */
+	for(uint8_t pr = FOS_AGING_TOP_PRIORITY + 1; pr < (FOS_PRIORITY_CNT - 1); pr++)
+	{
+		if(!(rq->prio_bmp & (0x80000000UL >> pr)))
+			continue;
+
+		fos_id_t id = rq->head[pr];
+		if(id == current_thr)                      // выполнявшийся поток ещё стоит в начале
+			id = rq->next[id];
+
+		while((id != current_thr) && (rq->prio[id] == pr) && ((ts - rq->wait_ts[id]) >= FOS_AGING_THRESHOLD_MS))
+		{
+			fos_id_t next = rq->next[id];
+			if(next == id)                         // последний поток списка
+				next = FOS_EMPTY_ID;
+
+			// поднимаем на уровень выше, следующий уровень - через такое же время ожидания
+			Private_FOS_Schedule_Remove(rq, id);
+			Private_FOS_Schedule_Insert(rq, id, pr - 1);
+			rq->boost[id]++;
+			rq->wait_ts[id] = ts;
+
+			ptr->dbg.aging_boost_cnt++;
+			ptr->dbg.thr_aging_boost_cnt[id]++;
+
+			if(next == FOS_EMPTY_ID)
+				break;
+			id = next;
+		}
+	}
+}
+
+
+// вернуть поток, поднятый старением, в список его приоритета
+static void Private_FOS_Schedule_ResetBoost(fos_ready_queue_t *rq, fos_id_t id)
+{
+	uint8_t pr = rq->prio[id] + rq->boost[id];
+
+	Private_FOS_Schedule_Remove(rq, id);
+	Private_FOS_Schedule_Insert(rq, id, pr);
+	rq->boost[id] = 0;
+}
+#endif
@@ -25,6 +25,7 @@
 
 
 #include "Thread/fos_thread.h"
+#include "Thread/fos_tqueue.h"
 
 
 // переменные
@@ -44,30 +45,114 @@ typedef struct
 	uint32_t all_thr_time_ms_per_1s;            // время на все потоки в течении 1 сек, мс
 	uint32_t sys_time_ms_per_1s;                // системное время в течении 1 сек, мс
 
+#if defined(FOS_USE_AGING)
+	uint32_t aging_boost_cnt;                   // число повышений приоритета старением
+	uint32_t thr_aging_boost_cnt[FOS_MAX_THR_CNT];// число повышений приоритета старением каждого потока
+#endif
+
+#if defined(FOS_USE_SCHED_PROFILE)
+	// замер: сборка с FOS_USE_SCHED_PROFILE и FOS_TIME_BASE_DWT_HZ, равным частоте ядра (тогда такты - такты ЦП),
+	// после работы потоков читаем USER_FOS_GetSchedulerDbgInfo(): среднее - pick_ticks_sum / pick_cnt, худшее - pick_ticks_max
+	uint32_t pick_ticks_last;                   // длительность последнего выбора потока, такты счётчика времени
+	uint32_t pick_ticks_max;                    // наибольшая длительность выбора потока
+	uint64_t pick_ticks_sum;                    // суммарная длительность выборов (среднее - pick_ticks_sum / pick_cnt)
+	uint32_t pick_cnt;                          // число выборов потока
+#endif
+
 } fos_scheduler_dbg_t;
 
-// планировщик задач
+// очередь готовых потоков
+// для каждого приоритета - кольцевой двусвязный список индексов потоков
+typedef struct
+{
+	fos_id_t next[FOS_MAX_THR_CNT];             // следующий поток в списке своего приоритета
+	fos_id_t prev[FOS_MAX_THR_CNT];             // предыдущий поток в списке своего приоритета
+	uint8_t  prio[FOS_MAX_THR_CNT];             // приоритет, в списке которого стоит поток (FOS_NO_PRIORITY - поток не в очереди)
+	fos_id_t head[FOS_PRIORITY_CNT];            // поток, чья очередь выполняться в списке приоритета (FOS_EMPTY_ID - список пуст)
+	uint32_t prio_bmp;                          // битовая карта непустых списков (бит 31 - приоритет 0, бит 30 - приоритет 1 и т.д.)
+
+#if defined(FOS_USE_AGING)
+	uint8_t  boost[FOS_MAX_THR_CNT];            // на сколько уровней поток поднят старением
+	uint32_t wait_ts[FOS_MAX_THR_CNT];          // метка времени, с которой поток ждёт выполнения, мс
+	uint32_t aging_ts;                          // метка времени последней проверки старения, мс
+#endif
+
+} fos_ready_queue_t;
+
+typedef struct fos_scheduler_s fos_scheduler_t;
+
+// фильтр потоков для выбора (FOS__ENABLE - поток может быть выбран)
+typedef fos_sw_t (*fos_sched_filter_t)(void *ctx, fos_id_t id);
+
+// политика планирования
+// функции вызываются в критической секции
 typedef struct
 {
-	uint8_t thr_plist[FOS_MAX_THR_CNT];          // список потоков (для готовых и активных - номер приоритета, для остальных FOS_SUSPEND_BLOCKED_ID)
-	uint8_t run_list[FOS_MAX_THR_CNT];           // список готовых к выполению потоков (включая активный)
+	void     (*init)(fos_scheduler_t *ptr);                                     // инициализация данных политики
+	void     (*enqueue)(fos_scheduler_t *ptr, fos_id_t id, fos_thread_t *thr);  // поставить готовый поток в очередь или обновить его положение
+	void     (*dequeue)(fos_scheduler_t *ptr, fos_id_t id);                     // удалить поток из очереди
+	void     (*on_block)(fos_scheduler_t *ptr, fos_id_t id);                    // поток заблокирован или уснул
+	int16_t  (*pick_next)(fos_scheduler_t *ptr, fos_id_t current_thr);          // выбрать следующий поток (-1 - нет готовых)
+	int16_t  (*pick_filtered)(fos_scheduler_t *ptr, fos_id_t current_thr, fos_sched_filter_t filter, void *ctx);  // то же среди потоков, принятых фильтром
+	void     (*tick)(fos_scheduler_t *ptr, fos_id_t id, uint32_t thr_dt_us);    // поток id отработал thr_dt_us
+	fos_sw_t (*is_preempting)(fos_thread_t *a, fos_thread_t *b);                // должен ли поток a вытеснить поток b
 
-	uint8_t priority_list[FOS_PRIORITY_CNT];     // число потоков для каждого приоритета
+} fos_sched_policy_t;
 
-	uint8_t ready_thr_cnt;                       // число готовых потоков (включая активный)
-	uint8_t run_list_cnt;                        // число записей в run_list
+// планировщик задач
+struct fos_scheduler_s
+{
+	fos_ready_queue_t rq;                        // очередь готовых потоков
+	fos_tqueue_t      edf;                       // готовые периодические потоки, упорядоченные по крайнему сроку (политика EDF)
+
+	uint8_t  ready[FOS_MAX_THR_CNT];             // поток стоит в очереди готовых
+	fos_id_t ready_thr_cnt;                      // число готовых потоков (включая активный)
+
+#if defined(FOS_USE_SCHED_POLICY_RUNTIME)
+	const fos_sched_policy_t *policy;            // текущая политика планирования
+#endif
 
 	fos_scheduler_var_t var;                     // переменные
 	fos_scheduler_dbg_t dbg;                     // отладочная информация
 
-} fos_scheduler_t;
+};
+
+
+// политика фиксированных приоритетов с циклическим обходом (периодические потоки - на своём приоритете)
+extern const fos_sched_policy_t fos_sched_policy_prio;
+
+// политика фиксированных приоритетов, периодические потоки - по EDF на уровне FOS_EDF_PRIORITY
+extern const fos_sched_policy_t fos_sched_policy_edf;
+
 
+// инициализация
+void FOS_Schedule_Init(fos_scheduler_t *ptr);
+
+#if defined(FOS_USE_SCHED_POLICY_RUNTIME)
+// сменить политику планирования (очередь готовых должна быть пуста)
+fos_ret_t FOS_Schedule_SetPolicy(fos_scheduler_t *ptr, const fos_sched_policy_t *policy);
+#endif
+
+// обновить положение потока в очереди готовых в соответствии с его состоянием и приоритетом
+// thr == NULL - удалить поток из очереди
+void FOS_Schedule_UpdThread(fos_scheduler_t *ptr, fos_id_t id, fos_thread_t *thr);
+
+// должен ли поток a вытеснить поток b
+fos_sw_t FOS_Schedule_IsPreempting(fos_scheduler_t *ptr, fos_thread_t *a, fos_thread_t *b);
+
+// учесть время работы потока перед выбором следующего
+void FOS_Schedule_Tick(fos_scheduler_t *ptr, fos_id_t id, uint32_t thr_dt_us);
 
 // спланировать задачу (возвращает номре выбранной задачи или -1, если её нет)
-int16_t FOS_Schedule(fos_scheduler_t *ptr, volatile fos_thread_ptr *thr_desc_list, uint8_t thr_max_id);
+// current_thr - индекс последнего выполнявшегося потока
+int16_t FOS_Schedule(fos_scheduler_t *ptr, fos_id_t current_thr);
+
+// спланировать задачу среди готовых потоков, принятых фильтром (-1 - таких нет)
+// порядок тот же, что у FOS_Schedule: по приоритету и по очереди внутри приоритета
+int16_t FOS_Schedule_Filtered(fos_scheduler_t *ptr, fos_id_t current_thr, fos_sched_filter_t filter, void *ctx);
 
 // отладка
-void FOS_ScheduleDbg(fos_scheduler_t *ptr, uint8_t thr_max_id, uint8_t id, uint32_t thr_dt_us);
+void FOS_ScheduleDbg(fos_scheduler_t *ptr, fos_id_t thr_max_id, fos_id_t id, uint32_t thr_dt_us);
 
 
 #endif /* APPLICATION_FOS_THREAD_SCHEDULER_H_ */
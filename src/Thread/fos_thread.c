@@ -23,15 +23,13 @@
 
 #include "Thread/fos_thread.h"
 #include "Platform/sl_platform.h"
+#include "Platform/fos_time.h"
 #include <string.h>
 
 
 // получить адрес максимальной отметки заполнения стека
 static uint32_t FOS_ThreadGetAdrStackWatermark(uint32_t low_sp, uint32_t high_sp);
 
-// обработать сосояние потока
-static void FOS_ThreadProcState(fos_thread_t *p);
-
 // добавить данные в стек потока
 static void FOS_ThreadPushStack(fos_thread_t *p, uint32_t val);
 
@@ -44,12 +42,18 @@ static void FOS_ThreadStackInit(fos_thread_t *p);
 // функция ловушка для избежания выхода за пределы основного цикла потока
 static void Private_FOS_InfLoop();
 
+// функция ловушка при выходе из задания потока до завершения
+static void Private_FOS_RtcJobEnd();
+
 // установить флаг блокировки потока
 static void FOS_ThreadSetLockFlag(fos_thread_t *p, uint32_t lock);
 
 // сбросить флаг блокировки
 static void FOS_ThreadReleaseLockFlag(fos_thread_t *p, uint32_t lock);
 
+// установить время пробуждения потока в мкс
+static void FOS_ThreadSetWakeUpTime(fos_thread_t *p, fos_time_t ts);
+
 // вызов callback ошибки стека
 static void FOS_Call_StackErrorCallback(fos_thread_dbg_t *p, user_desc_t user_desc);
 
@@ -73,6 +77,14 @@ __weak void SYS_FOS_ErrorSet(fos_err_t *err)
 }
 
 
+// прототип функции завершения задания потока до завершения
+// реализация через системный вызов
+__weak fos_ret_t SYS_FOS_RtcJobComplete()
+{
+	return FOS__OK;
+}
+
+
 // инициализация потока
 void FOS_ThreadInit(fos_thread_t *p, fos_thread_init_t *init)
 {
@@ -80,13 +92,16 @@ void FOS_ThreadInit(fos_thread_t *p, fos_thread_init_t *init)
 		return;
 
 	// инициализируем только неинициализированный поток
-//	if(p->var.mode != FOS__THREAD_NO_INIT)
+//	if(FOS_Thread_GetMode(p) != FOS__THREAD_NO_INIT)
 //		return;
 
 	strncpy(p->name, init->name_ptr, FOS_THR_NAME_LEN);
 	memcpy(&p->cset, &init->cset, sizeof(fos_thread_cset_t));
 	memcpy(&p->set, &init->set, sizeof(fos_thread_set_t));
 	memset(&p->var, 0, sizeof(fos_thread_var_t));
+	memset(&p->rt, 0, sizeof(fos_thread_rt_t));
+	memset(&p->budget, 0, sizeof(fos_thread_budget_t));
+	memset(&p->ipc, 0, sizeof(fos_thread_ipc_t));
 	memset(&p->dbg, 0, sizeof(fos_thread_dbg_t));
 	p->user_desc = 0;
 
@@ -95,10 +110,28 @@ void FOS_ThreadInit(fos_thread_t *p, fos_thread_init_t *init)
 	p->dbg.stack_size    = p->cset.stack_size;
 	p->dbg.stack_err_cbk = FOS_Proc_StackErrorCallback;
 
-	FOS_ThreadStackInit(p);
+	// общий стек может быть занят другим потоком, стек потока до завершения инициализируется в начале задания
+	if(!FOS_Thread_IsRtc(p))
+		FOS_ThreadStackInit(p);
+	FOS_Thread_SetQuantum(p, p->set.quantum_us);
+	FOS_Thread_SetBudget(p, p->set.budget.budget_us, p->set.budget.period_ms);
 
-	p->var.state = FOS__THREAD_SUSPEND;
-	p->var.mode  = FOS__THREAD_INIT;
+	if(p->set.rt.deadline_ms == 0)                    // крайний срок по умолчанию равен периоду
+		p->set.rt.deadline_ms = p->set.rt.period_ms;
+
+	p->var.base_priotity = init->priotity;
+	p->var.mutex_wait    = FOS_WRONG_MUTEX_ID;
+	p->var.mutex_held    = FOS_WRONG_MUTEX_ID;
+	p->var.rtc_next      = FOS_WRONG_THREAD_ID;
+	p->var.rtc_wait_sw   = FOS__DISABLE;
+
+	p->ipc.partner    = FOS_WRONG_THREAD_ID;
+	p->ipc.send_next  = FOS_WRONG_THREAD_ID;
+	p->ipc.send_first = FOS_WRONG_THREAD_ID;
+	p->ipc.send_last  = FOS_WRONG_THREAD_ID;
+	p->ipc.reply_first = FOS_WRONG_THREAD_ID;
+
+	p->hot = NULL;                        // горячие переменные и режим появятся при регистрации потока
 }
 
 
@@ -133,22 +166,55 @@ fos_ret_t FOS_Thread_SetUserDesc(fos_thread_t *p, user_desc_t user_desc, user_de
 }
 
 
-// установка флага регистриции потока
-fos_ret_t FOS_Thread_SetRegFlag(fos_thread_t *p)
+// установка флага регистриции потока; поток привязывается к своим горячим переменным в таблице ядра
+fos_ret_t FOS_Thread_SetRegFlag(fos_thread_t *p, fos_thread_hot_t *hot)
 {
-	if(p == NULL)
+	if((p == NULL) || (hot == NULL))
 		return FOS__FAIL;
 
 	// регистрируем только инициализированный поток
-	if(p->var.mode != FOS__THREAD_INIT)
+	if(FOS_Thread_GetMode(p) != FOS__THREAD_INIT)
 		return FOS__FAIL;
 
-	p->var.mode = FOS__THREAD_READY_TO_RUN;
+	FOS_Thread_BindHot(p, hot);
+	hot->mode = FOS__THREAD_READY_TO_RUN;
 
 	return FOS__OK;
 }
 
 
+// получить режим потока
+fos_thread_mode_t FOS_Thread_GetMode(fos_thread_t *p)
+{
+	if(p == NULL)
+		return FOS__THREAD_NO_INIT;
+
+	// режим хранится в горячих переменных, которые есть только у зарегистрированного потока
+	if(p->hot == NULL)
+		return FOS__THREAD_INIT;
+
+	return p->hot->mode;
+}
+
+
+// привязать поток к его горячим переменным в таблице ядра (NULL - отвязать)
+void FOS_Thread_BindHot(fos_thread_t *p, fos_thread_hot_t *hot)
+{
+	if(p == NULL)
+		return;
+
+	p->hot = hot;
+	if(hot == NULL)
+		return;
+
+	memset((void*)hot, 0, sizeof(fos_thread_hot_t));
+	hot->sp       = p->var.start_sp;             // стек подготовлен при инициализации потока
+	hot->state    = FOS__THREAD_SUSPEND;
+	hot->mode     = FOS__THREAD_INIT;
+	hot->priotity = p->var.base_priotity;
+}
+
+
 // установка флага запуска потока
 fos_ret_t FOS_Thread_SetRunFlag(fos_thread_t *p)
 {
@@ -156,11 +222,18 @@ fos_ret_t FOS_Thread_SetRunFlag(fos_thread_t *p)
 		return FOS__FAIL;
 
 	// запустить можно только зарегистрированный поток
-	if(p->var.mode != FOS__THREAD_READY_TO_RUN)
+	if(FOS_Thread_GetMode(p) != FOS__THREAD_READY_TO_RUN)
 		return FOS__FAIL;
 
-	p->var.mode  = FOS__THREAD_RUN;
-	p->var.state = FOS__THREAD_READY;
+	p->hot->mode  = FOS__THREAD_RUN;
+	p->hot->state = FOS__THREAD_READY;
+
+	// периодический поток выпускает первое задание сразу при запуске
+	if(FOS_Thread_IsPeriodic(p))
+	{
+		p->rt.deadline_ts = SL_GetTick() + p->set.rt.deadline_ms;
+		p->rt.release_ts  = SL_GetTick() + p->set.rt.period_ms;
+	}
 
 	return FOS__OK;
 }
@@ -172,15 +245,294 @@ fos_ret_t FOS_Thread_SetTerminateFlag(fos_thread_t *p, int32_t terminate_code)
 	if(p == NULL)
 		return FOS__FAIL;
 
-	fos_thread_var_t *v = &p->var;
+	fos_thread_mode_t mode = FOS_Thread_GetMode(p);
 
 	// завершить можно только готовый к запуску или запущенный поток
-	if((v->mode != FOS__THREAD_READY_TO_RUN) && (v->mode != FOS__THREAD_RUN))
+	if((mode != FOS__THREAD_READY_TO_RUN) && (mode != FOS__THREAD_RUN))
+		return FOS__FAIL;
+
+	p->hot->mode = FOS__THREAD_TERMINATING;
+	p->var.terminate_code = terminate_code;
+	p->hot->state = FOS__THREAD_SUSPEND;    // поток в режиме READY_TO_RUN или RUN зарегистрирован
+
+	return FOS__OK;
+}
+
+
+// установить квант времени потока в мкс (0 - период основного таймера)
+fos_ret_t FOS_Thread_SetQuantum(fos_thread_t *p, uint32_t quantum_us)
+{
+	if(p == NULL)
+		return FOS__FAIL;
+
+	if(quantum_us)
+	{
+		if(quantum_us < FOS_MIN_TIM_PERIOD_US)
+			quantum_us = FOS_MIN_TIM_PERIOD_US;
+
+		if(quantum_us > FOS_MAX_TIM_PERIOD_US)
+			quantum_us = FOS_MAX_TIM_PERIOD_US;
+	}
+
+	p->set.quantum_us = quantum_us;
+
+	return FOS__OK;
+}
+
+
+// установить бюджет процессорного времени потока: budget_us мкс в каждый период period_ms мс (budget_us = 0 - без ограничения)
+fos_ret_t FOS_Thread_SetBudget(fos_thread_t *p, uint32_t budget_us, uint32_t period_ms)
+{
+	if(p == NULL)
+		return FOS__FAIL;
+
+	// бюджет не меньше периода - ограничения нет
+	if((period_ms == 0) || (budget_us >= period_ms * 1000))
+		budget_us = 0;
+
+	p->set.budget.budget_us = budget_us;
+	p->set.budget.period_ms = period_ms;
+
+	// новый период бюджета начинается сейчас
+	p->budget.period_ts = SL_GetTick();
+	p->budget.used_us   = 0;
+
+	return FOS__OK;
+}
+
+
+// учесть время выполнения в бюджете потока (возвращает FOS__ENABLE, если бюджет исчерпан)
+fos_sw_t FOS_Thread_ChargeBudget(fos_thread_t *p, uint32_t dt_us)
+{
+	if((p == NULL) || (p->set.budget.budget_us == 0))
+		return FOS__DISABLE;
+
+	fos_thread_budget_t *b = &p->budget;
+	uint32_t now = SL_GetTick();
+
+	// пополнение бюджета в начале нового периода
+	// окно сдвигается на целое число периодов, поэтому границы окон не уплывают от момента проверки
+	if(FOS_TIME_AFTER_EQ(now, b->period_ts + p->set.budget.period_ms))
+	{
+		b->period_ts += ((now - b->period_ts) / p->set.budget.period_ms) * p->set.budget.period_ms;
+		b->used_us    = 0;
+	}
+
+	b->used_us += dt_us;
+	if(b->used_us < p->set.budget.budget_us)
+		return FOS__DISABLE;
+
+	b->throttle_cnt++;
+
+	return FOS__ENABLE;
+}
+
+
+// получить остаток бюджета потока в мкс (FOS_INF_TIME - без ограничения)
+uint32_t FOS_Thread_GetBudgetLeft(fos_thread_t *p)
+{
+	if((p == NULL) || (p->set.budget.budget_us == 0))
+		return FOS_INF_TIME;
+
+	fos_thread_budget_t *b = &p->budget;
+
+	if(FOS_TIME_AFTER_EQ(SL_GetTick(), b->period_ts + p->set.budget.period_ms))    // бюджет будет пополнен
+		return p->set.budget.budget_us;
+
+	return (b->used_us < p->set.budget.budget_us) ? (p->set.budget.budget_us - b->used_us) : 0;
+}
+
+
+// заблокировать поток, исчерпавший бюджет, до пополнения бюджета
+void FOS_Thread_Throttle(fos_thread_t *p)
+{
+	if((p == NULL) || (p->hot == NULL))
+		return;
+
+	// блокируем только выполнявшийся поток; уснувший или заблокированный поток и так не выполняется
+	if(p->hot->state != FOS__THREAD_RUNNING)
+		return;
+
+	FOS_Thread_ThrottleUntil(p, p->budget.period_ts + p->set.budget.period_ms);
+}
+
+
+// заблокировать готовый или выполняющийся поток до момента времени ts
+void FOS_Thread_ThrottleUntil(fos_thread_t *p, uint32_t ts)
+{
+	if((p == NULL) || (p->hot == NULL))
+		return;
+
+	if((p->hot->state != FOS__THREAD_RUNNING) && (p->hot->state != FOS__THREAD_READY))
+		return;
+
+	FOS_ThreadSetWakeUpTime(p, FOS_Time_FromTick(ts));
+
+	p->hot->state = FOS__THREAD_BLOCKED;
+}
+
+
+// приостановить поток до возобновления (блокировки и время пробуждения потока сохраняются)
+fos_ret_t FOS_Thread_Suspend(fos_thread_t *p)
+{
+	if(p == NULL)
 		return FOS__FAIL;
 
-	v->mode  = FOS__THREAD_TERMINATING;
-	v->state = FOS__THREAD_SUSPEND;
-	v->terminate_code = terminate_code;
+	// поток не запущен или ждёт активации задания
+	if((FOS_Thread_GetMode(p) != FOS__THREAD_RUN) || (p->hot->state == FOS__THREAD_SUSPEND))
+		return FOS__FAIL;
+
+	// готовый поток продолжит выполнение сразу после возобновления
+	FOS_Thread_ThrottleUntil(p, SL_GetTick());
+
+	FOS_ThreadSetLockFlag(p, FOS_LOCK_SUSPEND_FLAG);
+
+	return FOS__OK;
+}
+
+
+// возобновить приостановленный поток
+fos_ret_t FOS_Thread_Resume(fos_thread_t *p)
+{
+	if((p == NULL) || (p->hot == NULL) || !(p->hot->lock_flag & FOS_LOCK_SUSPEND_FLAG))
+		return FOS__FAIL;
+
+	FOS_ThreadReleaseLockFlag(p, FOS_LOCK_SUSPEND_FLAG);
+
+	FOS_ThreadProcState(p);    // поток, время пробуждения которого наступило, готов сразу
+
+	return FOS__OK;
+}
+
+
+// является ли поток периодическим (EDF)
+fos_sw_t FOS_Thread_IsPeriodic(fos_thread_t *p)
+{
+	if(p == NULL)
+		return FOS__DISABLE;
+
+	return (p->set.rt.period_ms != 0) ? FOS__ENABLE : FOS__DISABLE;
+}
+
+
+// учесть время выполнения потока
+void FOS_Thread_AddRunTime(fos_thread_t *p, uint32_t dt_us)
+{
+	if(p == NULL)
+		return;
+
+	if(!FOS_Thread_IsPeriodic(p))
+		return;
+
+	fos_thread_rt_t *rt = &p->rt;
+	uint32_t wcet_us = p->set.rt.wcet_us;
+
+	// фиксируем превышение бюджета один раз за задание
+	if(wcet_us && (rt->job_time_us <= wcet_us) && (rt->job_time_us + dt_us > wcet_us))
+		rt->overrun_cnt++;
+
+	rt->job_time_us += dt_us;
+}
+
+
+// завершить текущее задание периодического потока и перейти к ожиданию следующего
+// FOS__FAIL - задание завершено позже крайнего срока
+fos_ret_t FOS_Thread_CompleteJob(fos_thread_t *p)
+{
+	if((p == NULL) || (p->hot == NULL))
+		return FOS__FAIL;
+
+	if(!FOS_Thread_IsPeriodic(p))
+		return FOS__FAIL;
+
+	fos_thread_rt_t *rt = &p->rt;
+	fos_ret_t ret = FOS__OK;
+	uint32_t now = SL_GetTick();
+	uint32_t release_ts = rt->release_ts;
+
+	rt->job_cnt++;
+	if(!FOS_TIME_AFTER_EQ(rt->deadline_ts, now))    // задание завершено позже крайнего срока
+	{
+		rt->miss_cnt++;
+		ret = FOS__FAIL;
+	}
+
+	// параметры следующего задания
+	rt->deadline_ts = release_ts + p->set.rt.deadline_ms;
+	rt->release_ts  = release_ts + p->set.rt.period_ms;
+	rt->job_time_us = 0;
+
+	// если время выпуска следующего задания ещё не наступило, ждём его
+	if(!FOS_TIME_AFTER_EQ(now, release_ts))
+	{
+		FOS_ThreadSetWakeUpTime(p, FOS_Time_FromTick(release_ts));
+
+		p->hot->state = FOS__THREAD_BLOCKED;
+	}
+
+	return ret;
+}
+
+
+// является ли поток потоком до завершения (run-to-completion)
+fos_sw_t FOS_Thread_IsRtc(fos_thread_t *p)
+{
+	if(p == NULL)
+		return FOS__DISABLE;
+
+	return p->cset.rtc_sw ? FOS__ENABLE : FOS__DISABLE;
+}
+
+
+// активировать задание потока до завершения (первая активация запускает поток)
+fos_ret_t FOS_Thread_Activate(fos_thread_t *p)
+{
+	if(!FOS_Thread_IsRtc(p))
+		return FOS__FAIL;
+
+	if(FOS_Thread_GetMode(p) == FOS__THREAD_READY_TO_RUN)    // первая активация
+	{
+		p->hot->mode  = FOS__THREAD_RUN;
+		p->hot->state = FOS__THREAD_SUSPEND;         // задание начнётся, когда освободится общий стек
+	}
+
+	if(FOS_Thread_GetMode(p) != FOS__THREAD_RUN)
+		return FOS__FAIL;
+
+	p->var.act_cnt++;
+
+	return FOS__OK;
+}
+
+
+// начать очередное задание потока до завершения; стек потока инициализируется заново
+fos_ret_t FOS_Thread_StartRtcJob(fos_thread_t *p)
+{
+	if(!FOS_Thread_IsRtc(p))
+		return FOS__FAIL;
+
+	if((FOS_Thread_GetMode(p) != FOS__THREAD_RUN) || (p->hot->state != FOS__THREAD_SUSPEND) || (p->var.act_cnt == 0))
+		return FOS__FAIL;
+
+	p->var.act_cnt--;
+
+	FOS_ThreadStackInit(p);                          // задание начинается с точки входа
+	p->hot->state = FOS__THREAD_READY;
+
+	return FOS__OK;
+}
+
+
+// завершить задание потока до завершения; поток ждёт следующей активации
+fos_ret_t FOS_Thread_CompleteRtcJob(fos_thread_t *p)
+{
+	if(!FOS_Thread_IsRtc(p))
+		return FOS__FAIL;
+
+	if(FOS_Thread_GetMode(p) != FOS__THREAD_RUN)
+		return FOS__FAIL;
+
+	p->hot->state = FOS__THREAD_SUSPEND;
 
 	return FOS__OK;
 }
@@ -189,45 +541,126 @@ fos_ret_t FOS_Thread_SetTerminateFlag(fos_thread_t *p, int32_t terminate_code)
 // усыпить поток
 void FOS_ThreadSleep(fos_thread_t *p, uint32_t time)
 {
-	if(p == NULL)
+	if((p == NULL) || (p->hot == NULL))
 		return;
 
-	if(p->var.state == FOS__THREAD_SUSPEND)
+	if(p->hot->state == FOS__THREAD_SUSPEND)
 		return;
 
 	if(time == FOS_INF_TIME)
-		p->var.wake_up_time = 0;
+		p->hot->wake_up_time = 0;
 	else
-		p->var.wake_up_time = SL_GetTick() + time;
+		FOS_ThreadSetWakeUpTime(p, FOS_Time_GetUs() + (fos_time_t)time * 1000);
+
+	p->hot->state = FOS__THREAD_BLOCKED;
+}
+
 
-	p->var.state = FOS__THREAD_BLOCKED;
+// усыпить поток на time_us мкс
+void FOS_ThreadSleepUs(fos_thread_t *p, uint32_t time_us)
+{
+	if((p == NULL) || (p->hot == NULL))
+		return;
+
+	if(p->hot->state == FOS__THREAD_SUSPEND)
+		return;
+
+	FOS_ThreadSetWakeUpTime(p, FOS_Time_GetUs() + time_us);
+
+	p->hot->state = FOS__THREAD_BLOCKED;
+}
+
+
+// усыпить поток до момента *last_wake + period и сдвинуть *last_wake на этот момент
+// FOS__FAIL - момент уже прошёл (перебег): поток не засыпает, *last_wake сдвигается на последний прошедший момент
+fos_ret_t FOS_ThreadSleepUntil(fos_thread_t *p, uint32_t *last_wake, uint32_t period)
+{
+	if((p == NULL) || (p->hot == NULL) || (last_wake == NULL) || (period == 0))
+		return FOS__FAIL;
+
+	if(p->hot->state == FOS__THREAD_SUSPEND)
+		return FOS__FAIL;
+
+	uint32_t now     = SL_GetTick();
+	uint32_t wake_ts = *last_wake + period;           // следующий момент считается от предыдущего, а не от текущего времени
+
+	if(!FOS_TIME_AFTER_EQ(wake_ts, now))              // момент прошёл, пока поток работал
+	{
+		// пропущенные периоды отбрасываются, фаза периода сохраняется
+		*last_wake = wake_ts + ((now - wake_ts) / period) * period;
+		p->var.sleep_overrun_cnt++;
+		return FOS__FAIL;
+	}
+
+	*last_wake = wake_ts;
+	if(wake_ts == now)                                // момент наступил ровно сейчас, спать не нужно
+		return FOS__OK;
+
+	FOS_ThreadSetWakeUpTime(p, FOS_Time_FromTick(wake_ts));
+
+	p->hot->state = FOS__THREAD_BLOCKED;
+
+	return FOS__OK;
+}
+
+
+// усыпить поток до момента *last_wake_us + period_us в мкс и сдвинуть *last_wake_us на этот момент
+// FOS__FAIL - момент уже прошёл (перебег): поток не засыпает, *last_wake_us сдвигается на последний прошедший момент
+fos_ret_t FOS_ThreadSleepUntilUs(fos_thread_t *p, fos_time_t *last_wake_us, uint32_t period_us)
+{
+	if((p == NULL) || (p->hot == NULL) || (last_wake_us == NULL) || (period_us == 0))
+		return FOS__FAIL;
+
+	if(p->hot->state == FOS__THREAD_SUSPEND)
+		return FOS__FAIL;
+
+	fos_time_t now     = FOS_Time_GetUs();
+	fos_time_t wake_ts = *last_wake_us + period_us;   // время ядра не переполняется, сравнение прямое
+
+	if(wake_ts < now)                                 // момент прошёл, пока поток работал
+	{
+		// пропущенные периоды отбрасываются, фаза периода сохраняется
+		*last_wake_us = wake_ts + ((now - wake_ts) / period_us) * period_us;
+		p->var.sleep_overrun_cnt++;
+		return FOS__FAIL;
+	}
+
+	*last_wake_us = wake_ts;
+	if(wake_ts == now)                                // момент наступил ровно сейчас, спать не нужно
+		return FOS__OK;
+
+	FOS_ThreadSetWakeUpTime(p, wake_ts);
+
+	p->hot->state = FOS__THREAD_BLOCKED;
+
+	return FOS__OK;
 }
 
 
 // разбудить поток
 void FOS_ThreadWeakUp(fos_thread_t *p)
 {
-	if(p == NULL)
+	if((p == NULL) || (p->hot == NULL))
 		return;
 
-	if(p->var.state == FOS__THREAD_SUSPEND)
+	if(p->hot->state == FOS__THREAD_SUSPEND)
 		return;
-	p->var.wake_up_time = SL_GetTick();
+	FOS_ThreadSetWakeUpTime(p, FOS_Time_GetUs());
 }
 
 
 // установить блокировку на поток
 void FOS_ThreadLock(fos_thread_t *p, uint32_t lock)
 {
-	if(p == NULL)
+	if((p == NULL) || (p->hot == NULL))
 		return;
 
-	if(p->var.state == FOS__THREAD_SUSPEND)
+	if(p->hot->state == FOS__THREAD_SUSPEND)
 		return;
 
 	FOS_ThreadSetLockFlag(p, lock);
 
-	if(p->var.lock_flag)
+	if(p->hot->lock_flag)
 		FOS_ThreadSleep(p, FOS_INF_TIME);
 }
 
@@ -235,27 +668,50 @@ void FOS_ThreadLock(fos_thread_t *p, uint32_t lock)
 // снять блокировку с потока
 void FOS_ThreadUnlock(fos_thread_t *p, uint32_t lock)
 {
-	if(p == NULL)
+	if((p == NULL) || (p->hot == NULL))
 		return;
 
-	if(p->var.state == FOS__THREAD_SUSPEND)
+	if(p->hot->state == FOS__THREAD_SUSPEND)
 		return;
 
 	FOS_ThreadReleaseLockFlag(p, lock);
 
-	if(!p->var.lock_flag)
+	// снятие последней блокировки сразу делает поток готовым к выполнению
+	if((!p->hot->lock_flag) && (p->hot->state == FOS__THREAD_BLOCKED))
+		p->hot->state = FOS__THREAD_READY;
+
+	// а приостановленный поток - сразу после возобновления
+	if((p->hot->lock_flag == FOS_LOCK_SUSPEND_FLAG) && (p->hot->wake_up_time == 0))
 		FOS_ThreadWeakUp(p);
 }
 
 
-// обработать состояния всех потоков
-void FOS_AllThreadProcState(volatile fos_thread_ptr *thr_desc_list, uint8_t thr_max_ind)
+// обработать состояние потока (возвращает FOS__ENABLE, если поток перешёл в состояние готовности)
+fos_sw_t FOS_ThreadProcState(fos_thread_t *p)
 {
-	if((thr_desc_list == NULL) || (thr_max_ind >= FOS_MAX_THR_CNT))
-		return;
+	if(p == NULL)
+		return FOS__DISABLE;
+
+	fos_thread_hot_t *h = p->hot;
+	fos_sw_t res = FOS__DISABLE;
+
+	// обрабатываем только поток в работе
+	if((h == NULL) || (h->mode != FOS__THREAD_RUN))
+		return FOS__DISABLE;
+
+	/*
+	 * Проврека на условие автопробуждения по таймингу
+	 */
+	if((h->state == FOS__THREAD_BLOCKED) && (h->wake_up_time != 0) && (!h->lock_flag))
+	{
+		if(FOS_Time_GetUs() >= h->wake_up_time)
+		{
+			h->state = FOS__THREAD_READY;
+			res = FOS__ENABLE;
+		}
+	}
 
-	for(uint8_t i = 0; i <= thr_max_ind; i++)
-		FOS_ThreadProcState(thr_desc_list[i]);
+	return res;
 }
 
 
@@ -296,36 +752,11 @@ static uint32_t FOS_ThreadGetAdrStackWatermark(uint32_t low_sp, uint32_t high_sp
 }
 
 
-// обработать состояние потока
-static void FOS_ThreadProcState(fos_thread_t *p)
-{
-	if(p == NULL)
-		return;
-
-	fos_thread_var_t *v = &p->var;
-
-	// обрабатываем только поток в работе
-	if(v->mode != FOS__THREAD_RUN)
-		return;
-
-	/*
-	 * Проврека на условие автопробуждения по таймингу
-	 */
-	if((v->state == FOS__THREAD_BLOCKED) && (v->wake_up_time != 0) && (!v->lock_flag))
-	{
-		if(SL_GetTick() >= v->wake_up_time)
-			v->state = FOS__THREAD_READY;
-	}
-
-	FOS_ThreadProcDbg(&p->dbg, p->user_desc);     // обработать отладку потока
-}
-
-
 // добавить данные в стек потока
 static void FOS_ThreadPushStack(fos_thread_t *p, uint32_t val)
 {
-	p->var.sp -= 4;
-	*((uint32_t*)p->var.sp) = val;
+	p->var.start_sp -= 4;
+	*((uint32_t*)p->var.start_sp) = val;
 }
 
 
@@ -333,7 +764,7 @@ static void FOS_ThreadPushStack(fos_thread_t *p, uint32_t val)
 /*
 static void FOS_ThreadPopStack(fos_thread_t *p)
 {
-	p->var.sp += 4;
+	p->var.start_sp += 4;
 }*/
 
 
@@ -346,7 +777,7 @@ static void FOS_ThreadStackInit(fos_thread_t *p)
 	p->var.init_sp /= 8;                         // вырваниваем..
 	p->var.init_sp *= 8;                         // ..на 8 байт
 
-	p->var.sp = p->var.init_sp;                  // инициализируем указатель стека
+	p->var.start_sp = p->var.init_sp;            // инициализируем указатель стека
 
 	// 18 dword - float point reg
 	uint32_t reserved = 0x00000000;
@@ -357,6 +788,8 @@ static void FOS_ThreadStackInit(fos_thread_t *p)
 	uint32_t xPSR     = 0x01000000;                       // тут важно такое значение
 	uint32_t PC       = p->cset.ep;                       // точка входа
 	uint32_t LR       = (uint32_t)Private_FOS_InfLoop;    // ловушка
+	if(FOS_Thread_IsRtc(p))
+		LR = (uint32_t)Private_FOS_RtcJobEnd;             // выход из задания потока до завершения
 	uint32_t R12      = 0x00000000;
 	uint32_t R3       = 0x00000000;
 	uint32_t R2       = 0x00000000;
@@ -379,6 +812,9 @@ static void FOS_ThreadStackInit(fos_thread_t *p)
 	FOS_ThreadPushStack(p, R2);
 	FOS_ThreadPushStack(p, R1);
 	FOS_ThreadPushStack(p, R0);
+
+	if(p->hot)                                   // у зарегистрированного потока указатель стека хранится в таблице ядра
+		p->hot->sp = p->var.start_sp;
 }
 
 
@@ -393,17 +829,37 @@ static void Private_FOS_InfLoop()
 }
 
 
+// функция ловушка при выходе из задания потока до завершения
+static void Private_FOS_RtcJobEnd()
+{
+	while(1)
+	{
+		SYS_FOS_RtcJobComplete();
+		SL_Delay(100);
+	}
+}
+
+
 // установить флаг блокировки потока
 static void FOS_ThreadSetLockFlag(fos_thread_t *p, uint32_t lock)
 {
-	p->var.lock_flag |= lock;
+	p->hot->lock_flag |= lock;
 }
 
 
 // сбросить флаг блокировки
 static void FOS_ThreadReleaseLockFlag(fos_thread_t *p, uint32_t lock)
 {
-	p->var.lock_flag &= (~lock);
+	p->hot->lock_flag &= (~lock);
+}
+
+
+// установить время пробуждения потока в мкс
+static void FOS_ThreadSetWakeUpTime(fos_thread_t *p, fos_time_t ts)
+{
+	p->hot->wake_up_time = ts;
+	if(p->hot->wake_up_time == 0)                    // 0 зарезервирован под бесконечное время
+		p->hot->wake_up_time = 1;
 }
 
 
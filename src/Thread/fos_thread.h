@@ -46,31 +46,104 @@ typedef struct
 } fos_thread_dbg_t;
 
 
-// описание переменных потока
+// горячие переменные потока, которые планировщик и ядро читают на каждом проходе;
+// хранятся не в описании потока, а в плотной таблице ядра по id потока
 typedef struct
 {
-	volatile uint32_t init_sp;           // начальный указатель стека
+	volatile fos_time_t wake_up_time;    // время пробуждения потока (из соятояния BLOCKED в READY), мкс (0 - бесконечное)
 	volatile uint32_t sp;                // текущий указатель стека
-	volatile uint32_t wake_up_time;      // время пробуждения потока (из соятояния BLOCKED в READY)
 	volatile uint32_t lock_flag;         // флаг блокировки потока
+	volatile uint32_t sched_lock_cnt;    // счётчик блокировки планировщика потока (хранится здесь, пока поток не выполняется)
+	volatile fos_thread_state_t state;   // состояние потока
+	volatile fos_thread_mode_t  mode;    // режим потока (до регистрации - FOS__THREAD_INIT, горячих переменных ещё нет)
+	volatile uint8_t  priotity;          // текущий приоритет потока (может быть повышен наследованием)
+
+} fos_thread_hot_t;
+
+
+// описание переменных потока
+typedef struct
+{
+	volatile uint32_t init_sp;           // начальный указатель стека
+	volatile uint32_t start_sp;          // указатель стека после заполнения начального кадра
 	volatile int32_t  terminate_code;    // код завершения потока
 	volatile user_desc_t parent;         // дескриптор родидельского потока
-	volatile fos_thread_state_t state;   // состояние потока
-	volatile fos_thread_mode_t  mode;    // режим потока
 	volatile fos_sw_t static_flag;       // static thread flag
+	volatile uint8_t  base_priotity;     // собственный приоритет потока (hot->priotity может быть повышен наследованием)
+	volatile fos_id_t mutex_wait;        // id мьютекса, которого ждёт поток (FOS_WRONG_MUTEX_ID - не ждёт)
+	volatile fos_id_t mutex_held;        // id первого мьютекса из списка захваченных потоком (FOS_WRONG_MUTEX_ID - нет)
+	volatile uint32_t act_cnt;           // число ожидающих активаций потока до завершения
+	volatile fos_id_t rtc_next;          // следующий поток в очереди общего стека
+	volatile fos_sw_t rtc_wait_sw;       // поток стоит в очереди общего стека
+	volatile uint32_t sleep_overrun_cnt; // число вызовов сна до момента, наступившего раньше вызова
 
 } fos_thread_var_t;
 
 
+// переменные периодического (EDF) потока
+typedef struct
+{
+	volatile uint32_t release_ts;        // время выпуска следующего задания
+	volatile uint32_t deadline_ts;       // абсолютный крайний срок текущего задания
+	volatile uint32_t job_time_us;       // время выполнения текущего задания, мкс
+
+	volatile uint32_t job_cnt;           // число завершённых заданий
+	volatile uint32_t miss_cnt;          // число заданий, завершённых позже крайнего срока
+	volatile uint32_t overrun_cnt;       // число заданий, превысивших бюджет времени
+
+} fos_thread_rt_t;
+
+
+// переменные бюджета процессорного времени потока
+typedef struct
+{
+	volatile uint32_t period_ts;         // начало текущего периода бюджета
+	volatile uint32_t used_us;           // время, израсходованное в текущем периоде, мкс
+	volatile uint32_t throttle_cnt;      // число исчерпаний бюджета
+
+} fos_thread_budget_t;
+
+
+// состояние синхронного обмена сообщениями
+typedef enum
+{
+	FOS_IPC__IDLE = 0,                   // обмена нет
+	FOS_IPC__SEND_BLOCKED,               // отправитель ждёт приёма сообщения
+	FOS_IPC__REPLY_BLOCKED,              // отправитель ждёт ответа
+	FOS_IPC__RECV_BLOCKED,               // получатель ждёт сообщения
+
+} fos_ipc_state_t;
+
+
+// переменные синхронного обмена сообщениями
+typedef struct
+{
+	volatile fos_ipc_state_t state;      // состояние обмена
+	volatile fos_ret_t ret;              // результат последнего обмена
+	volatile fos_id_t partner;           // id потока-собеседника (FOS_WRONG_THREAD_ID - нет)
+	volatile fos_id_t send_next;         // следующий отправитель в очереди того же получателя
+	volatile fos_id_t send_first;        // первый отправитель, ждущий приёма сообщения потоком
+	volatile fos_id_t send_last;         // последний отправитель, ждущий приёма сообщения потоком
+	volatile fos_id_t reply_first;       // первый отправитель, ждущий ответа потока (список через send_next)
+	fos_ipc_msg_t *msg_ptr;              // сообщение отправителя или буфер получателя
+	fos_ipc_msg_t *reply_ptr;            // буфер ответа отправителя
+
+} fos_thread_ipc_t;
+
+
 // описание потока
 typedef struct
 {
-	char name[FOS_THR_NAME_LEN];  // имя потока
+	fos_thread_hot_t *hot;        // горячие переменные в таблице ядра (NULL - поток не зарегистрирован)
 	user_desc_t user_desc;        // пользовательский дескриптор потока
+	char name[FOS_THR_NAME_LEN];  // имя потока
 
 	fos_thread_cset_t cset;  // константные настройки
 	fos_thread_set_t  set;   // настройки
 	fos_thread_var_t  var;   // переменные
+	fos_thread_rt_t   rt;    // переменные периодического потока
+	fos_thread_budget_t budget; // переменные бюджета процессорного времени
+	fos_thread_ipc_t  ipc;   // переменные синхронного обмена сообщениями
 	fos_thread_dbg_t  dbg;   // отладка
 
 } fos_thread_t;
@@ -85,8 +158,14 @@ void FOS_ThreadInit(fos_thread_t *p, fos_thread_init_t *init);
 // установить пользовательский дескриптор
 fos_ret_t FOS_Thread_SetUserDesc(fos_thread_t *p, user_desc_t user_desc, user_desc_t parent);
 
-// установка флага регистриции потока
-fos_ret_t FOS_Thread_SetRegFlag(fos_thread_t *p);
+// установка флага регистриции потока; поток привязывается к своим горячим переменным в таблице ядра
+fos_ret_t FOS_Thread_SetRegFlag(fos_thread_t *p, fos_thread_hot_t *hot);
+
+// получить режим потока
+fos_thread_mode_t FOS_Thread_GetMode(fos_thread_t *p);
+
+// привязать поток к его горячим переменным в таблице ядра (NULL - отвязать)
+void FOS_Thread_BindHot(fos_thread_t *p, fos_thread_hot_t *hot);
 
 // установка флага запуска потока
 fos_ret_t FOS_Thread_SetRunFlag(fos_thread_t *p);
@@ -94,9 +173,66 @@ fos_ret_t FOS_Thread_SetRunFlag(fos_thread_t *p);
 // завершить потока
 fos_ret_t FOS_Thread_SetTerminateFlag(fos_thread_t *p, int32_t terminate_code);
 
+// установить квант времени потока в мкс (0 - период основного таймера)
+fos_ret_t FOS_Thread_SetQuantum(fos_thread_t *p, uint32_t quantum_us);
+
+// установить бюджет процессорного времени потока: budget_us мкс в каждый период period_ms мс (budget_us = 0 - без ограничения)
+fos_ret_t FOS_Thread_SetBudget(fos_thread_t *p, uint32_t budget_us, uint32_t period_ms);
+
+// учесть время выполнения в бюджете потока (возвращает FOS__ENABLE, если бюджет исчерпан)
+fos_sw_t FOS_Thread_ChargeBudget(fos_thread_t *p, uint32_t dt_us);
+
+// получить остаток бюджета потока в мкс (FOS_INF_TIME - без ограничения)
+uint32_t FOS_Thread_GetBudgetLeft(fos_thread_t *p);
+
+// заблокировать поток, исчерпавший бюджет, до пополнения бюджета
+void FOS_Thread_Throttle(fos_thread_t *p);
+
+// заблокировать готовый или выполняющийся поток до момента времени ts
+void FOS_Thread_ThrottleUntil(fos_thread_t *p, uint32_t ts);
+
+// приостановить поток до возобновления (блокировки и время пробуждения потока сохраняются)
+fos_ret_t FOS_Thread_Suspend(fos_thread_t *p);
+
+// возобновить приостановленный поток
+fos_ret_t FOS_Thread_Resume(fos_thread_t *p);
+
+// является ли поток периодическим (EDF)
+fos_sw_t FOS_Thread_IsPeriodic(fos_thread_t *p);
+
+// учесть время выполнения потока
+void FOS_Thread_AddRunTime(fos_thread_t *p, uint32_t dt_us);
+
+// завершить текущее задание периодического потока и перейти к ожиданию следующего
+// FOS__FAIL - задание завершено позже крайнего срока
+fos_ret_t FOS_Thread_CompleteJob(fos_thread_t *p);
+
+// является ли поток потоком до завершения (run-to-completion)
+fos_sw_t FOS_Thread_IsRtc(fos_thread_t *p);
+
+// активировать задание потока до завершения (первая активация запускает поток)
+fos_ret_t FOS_Thread_Activate(fos_thread_t *p);
+
+// начать очередное задание потока до завершения; стек потока инициализируется заново
+fos_ret_t FOS_Thread_StartRtcJob(fos_thread_t *p);
+
+// завершить задание потока до завершения; поток ждёт следующей активации
+fos_ret_t FOS_Thread_CompleteRtcJob(fos_thread_t *p);
+
 // усыпить поток
 void FOS_ThreadSleep(fos_thread_t *p, uint32_t time);
 
+// усыпить поток до момента *last_wake + period и сдвинуть *last_wake на этот момент
+// FOS__FAIL - момент уже прошёл (перебег): поток не засыпает, *last_wake сдвигается на последний прошедший момент
+fos_ret_t FOS_ThreadSleepUntil(fos_thread_t *p, uint32_t *last_wake, uint32_t period);
+
+// усыпить поток на time_us мкс
+void FOS_ThreadSleepUs(fos_thread_t *p, uint32_t time_us);
+
+// усыпить поток до момента *last_wake_us + period_us в мкс и сдвинуть *last_wake_us на этот момент
+// FOS__FAIL - момент уже прошёл (перебег): поток не засыпает, *last_wake_us сдвигается на последний прошедший момент
+fos_ret_t FOS_ThreadSleepUntilUs(fos_thread_t *p, fos_time_t *last_wake_us, uint32_t period_us);
+
 // разбудить поток
 void FOS_ThreadWeakUp(fos_thread_t *p);
 
@@ -106,8 +242,8 @@ void FOS_ThreadLock(fos_thread_t *p, uint32_t lock);
 // снять блокировку с потока
 void FOS_ThreadUnlock(fos_thread_t *p, uint32_t lock);
 
-// обработать состояния всех потоков
-void FOS_AllThreadProcState(volatile fos_thread_ptr *thr_desc_list, uint8_t thr_max_ind);
+// обработать состояние потока (возвращает FOS__ENABLE, если поток перешёл в состояние готовности)
+fos_sw_t FOS_ThreadProcState(fos_thread_t *p);
 
 // обработать отладку потока
 void FOS_ThreadProcDbg(fos_thread_dbg_t *d, user_desc_t user_desc);
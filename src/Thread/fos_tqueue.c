@@ -0,0 +1,234 @@
+/**************************************************************************//**
+ * @file      fos_tqueue.c
+ * @brief     Timer queue of sleeping threads. Source file.
+ * @version   V1.0.00
+ * @date      16.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "Thread/fos_tqueue.h"
+#include "Platform/sl_platform.h"
+#include <string.h>
+
+
+// инициализация
+void FOS_TQueue_Init(fos_tqueue_t *p)
+{
+	if(p == NULL)
+		return;
+
+	memset(p->next, FOS_EMPTY_ID, sizeof(p->next));
+	memset(p->prev, FOS_EMPTY_ID, sizeof(p->prev));
+	memset(p->expiry, 0, sizeof(p->expiry));
+
+	for(fos_id_t i = 0; i < FOS_MAX_THR_CNT; i++)
+		p->queued[i] = FOS__DISABLE;
+
+	p->first = FOS_EMPTY_ID;
+}
+
+
+// поставить поток в очередь с временем пробуждения expiry (если поток уже в очереди, он переставляется)
+void FOS_TQueue_Insert(fos_tqueue_t *p, fos_id_t id, uint32_t expiry)
+{
+	if((p == NULL) || (id >= FOS_MAX_THR_CNT))
+		return;
+
+	fos_id_t prev = FOS_EMPTY_ID;
+	fos_id_t next;
+	uint32_t s;
+
+	ENTER_CRITICAL(s);
+
+	FOS_TQueue_Remove(p, id);           // поток может стоять в очереди с другим временем
+
+	/*
+	 * Ищем место в очереди: после всех потоков, которые проснутся не позже данного
+	 */
+	next = p->first;
+	while((next != FOS_EMPTY_ID) && FOS_TIME_AFTER_EQ(expiry, p->expiry[next]))
+	{
+		prev = next;
+		next = p->next[next];
+	}
+
+	p->expiry[id] = expiry;
+	p->prev[id]   = prev;
+	p->next[id]   = next;
+
+	if(prev == FOS_EMPTY_ID)            // встаём в начало очереди
+		p->first = id;
+	else
+		p->next[prev] = id;
+
+	if(next != FOS_EMPTY_ID)
+		p->prev[next] = id;
+
+	p->queued[id] = FOS__ENABLE;
+
+	LEAVE_CRITICAL(s);
+}
+
+
+// удалить поток из очереди
+void FOS_TQueue_Remove(fos_tqueue_t *p, fos_id_t id)
+{
+	if((p == NULL) || (id >= FOS_MAX_THR_CNT))
+		return;
+
+	uint32_t s;
+
+	ENTER_CRITICAL(s);
+
+	if(p->queued[id] == FOS__DISABLE)   // поток не в очереди
+	{
+		LEAVE_CRITICAL(s);
+		return;
+	}
+
+	if(p->prev[id] == FOS_EMPTY_ID)     // поток первый в очереди
+		p->first = p->next[id];
+	else
+		p->next[p->prev[id]] = p->next[id];
+
+	if(p->next[id] != FOS_EMPTY_ID)
+		p->prev[p->next[id]] = p->prev[id];
+
+	p->next[id]   = FOS_EMPTY_ID;
+	p->prev[id]   = FOS_EMPTY_ID;
+	p->queued[id] = FOS__DISABLE;
+
+	LEAVE_CRITICAL(s);
+}
+
+
+// извлечь поток, время пробуждения которого наступило к моменту now (возвращает индекс потока или -1, если таких нет)
+int16_t FOS_TQueue_PopExpired(fos_tqueue_t *p, uint32_t now)
+{
+	if(p == NULL)
+		return -1;
+
+	fos_id_t id;
+	uint32_t s;
+
+	ENTER_CRITICAL(s);
+
+	id = p->first;
+
+	// очередь пуста или ближайшее время пробуждения ещё не наступило
+	if((id == FOS_EMPTY_ID) || !FOS_TIME_AFTER_EQ(now, p->expiry[id]))
+	{
+		LEAVE_CRITICAL(s);
+		return -1;
+	}
+
+	FOS_TQueue_Remove(p, id);
+
+	LEAVE_CRITICAL(s);
+
+	return id;
+}
+
+
+// получить ближайшее время пробуждения (FOS__FAIL - очередь пуста)
+fos_ret_t FOS_TQueue_GetNextExpiry(fos_tqueue_t *p, uint32_t *expiry)
+{
+	if((p == NULL) || (expiry == NULL))
+		return FOS__FAIL;
+
+	fos_id_t id;
+	uint32_t s;
+
+	ENTER_CRITICAL(s);
+
+	id = p->first;
+	if(id == FOS_EMPTY_ID)
+	{
+		LEAVE_CRITICAL(s);
+		return FOS__FAIL;
+	}
+
+	*expiry = p->expiry[id];           // очередь упорядочена, первое пробуждение - ближайшее
+
+	LEAVE_CRITICAL(s);
+
+	return FOS__OK;
+}
+
+
+// получить время пробуждения, объединяющее ближайшие пробуждения (FOS__FAIL - очередь пуста)
+// пробуждения, отстоящие от ближайшего не более чем на coalesce, объединяются: возвращается самое позднее из них
+fos_ret_t FOS_TQueue_GetNextExpiryCoalesced(fos_tqueue_t *p, uint32_t *expiry, uint32_t coalesce)
+{
+	if((p == NULL) || (expiry == NULL))
+		return FOS__FAIL;
+
+	fos_id_t id;
+	uint32_t first_exp;
+	uint32_t s;
+
+	ENTER_CRITICAL(s);
+
+	id = p->first;
+	if(id == FOS_EMPTY_ID)
+	{
+		LEAVE_CRITICAL(s);
+		return FOS__FAIL;
+	}
+
+	first_exp = p->expiry[id];
+	*expiry   = first_exp;
+
+	// проходим по пробуждениям в пределах окна объединения
+	while((id != FOS_EMPTY_ID) && ((uint32_t)(p->expiry[id] - first_exp) <= coalesce))
+	{
+		*expiry = p->expiry[id];
+		id = p->next[id];
+	}
+
+	LEAVE_CRITICAL(s);
+
+	return FOS__OK;
+}
+
+
+// получить ближайшее время пробуждения среди потоков, принятых фильтром (FOS__FAIL - таких нет)
+fos_ret_t FOS_TQueue_GetNextExpiryFiltered(fos_tqueue_t *p, fos_tqueue_filter_t filter, void *ctx, uint32_t *expiry)
+{
+	if((p == NULL) || (filter == NULL) || (expiry == NULL))
+		return FOS__FAIL;
+
+	fos_ret_t ret = FOS__FAIL;
+	uint32_t s;
+
+	ENTER_CRITICAL(s);
+
+	// очередь упорядочена, обход останавливается на первом принятом потоке
+	for(fos_id_t id = p->first; id != FOS_EMPTY_ID; id = p->next[id])
+	{
+		if(filter(ctx, id))
+		{
+			*expiry = p->expiry[id];
+			ret = FOS__OK;
+			break;
+		}
+	}
+
+	LEAVE_CRITICAL(s);
+
+	return ret;
+}
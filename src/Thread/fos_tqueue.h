@@ -0,0 +1,71 @@
+/**************************************************************************//**
+ * @file      fos_tqueue.h
+ * @brief     Timer queue of sleeping threads. Header file.
+ * @version   V1.0.00
+ * @date      16.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef APPLICATION_FOS_THREAD_TQUEUE_H_
+#define APPLICATION_FOS_THREAD_TQUEUE_H_
+
+
+#include "fos_types.h"
+
+
+// очередь таймеров
+// двусвязный список индексов потоков, упорядоченный по времени пробуждения
+typedef struct
+{
+	fos_id_t next[FOS_MAX_THR_CNT];             // следующий поток в очереди (FOS_EMPTY_ID - последний)
+	fos_id_t prev[FOS_MAX_THR_CNT];             // предыдущий поток в очереди (FOS_EMPTY_ID - первый)
+	uint32_t expiry[FOS_MAX_THR_CNT];           // время пробуждения потока (единицы задаёт владелец очереди: мкс у таймеров ядра, мс у EDF)
+	fos_sw_t queued[FOS_MAX_THR_CNT];           // флаг нахождения потока в очереди
+
+	fos_id_t first;                             // поток с ближайшим временем пробуждения (FOS_EMPTY_ID - очередь пуста)
+
+} fos_tqueue_t;
+
+// фильтр потоков очереди (FOS__ENABLE - поток принимается)
+typedef fos_sw_t (*fos_tqueue_filter_t)(void *ctx, fos_id_t id);
+
+
+// инициализация
+void FOS_TQueue_Init(fos_tqueue_t *p);
+
+// поставить поток в очередь с временем пробуждения expiry (если поток уже в очереди, он переставляется)
+void FOS_TQueue_Insert(fos_tqueue_t *p, fos_id_t id, uint32_t expiry);
+
+// удалить поток из очереди
+void FOS_TQueue_Remove(fos_tqueue_t *p, fos_id_t id);
+
+// извлечь поток, время пробуждения которого наступило к моменту now (возвращает индекс потока или -1, если таких нет)
+int16_t FOS_TQueue_PopExpired(fos_tqueue_t *p, uint32_t now);
+
+// получить ближайшее время пробуждения (FOS__FAIL - очередь пуста)
+fos_ret_t FOS_TQueue_GetNextExpiry(fos_tqueue_t *p, uint32_t *expiry);
+
+// получить время пробуждения, объединяющее ближайшие пробуждения (FOS__FAIL - очередь пуста)
+// пробуждения, отстоящие от ближайшего не более чем на coalesce, объединяются: возвращается самое позднее из них
+fos_ret_t FOS_TQueue_GetNextExpiryCoalesced(fos_tqueue_t *p, uint32_t *expiry, uint32_t coalesce);
+
+// получить ближайшее время пробуждения среди потоков, принятых фильтром (FOS__FAIL - таких нет)
+fos_ret_t FOS_TQueue_GetNextExpiryFiltered(fos_tqueue_t *p, fos_tqueue_filter_t filter, void *ctx, uint32_t *expiry);
+
+
+
+#endif /* APPLICATION_FOS_THREAD_TQUEUE_H_ */
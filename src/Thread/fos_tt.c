@@ -0,0 +1,255 @@
+/**************************************************************************//**
+ * @file      fos_tt.c
+ * @brief     Time-triggered cyclic executive. Source file.
+ * @version   V1.0.00
+ * @date      16.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "Thread/fos_tt.h"
+#include <string.h>
+
+
+// получить начало слота от начала большого кадра, мкс
+static uint32_t Private_FOS_TT_GetSlotStart(const fos_tt_table_t *table, uint16_t ind);
+
+// перейти к следующему большому кадру, если он начался
+static void Private_FOS_TT_FrameProc(fos_tt_t *p);
+
+
+// инициализация
+void FOS_TT_Init(fos_tt_t *p)
+{
+	if(p == NULL)
+		return;
+
+	memset(p, 0, sizeof(fos_tt_t));
+}
+
+
+// проверить таблицу: слоты внутри своих малых кадров, упорядочены и не пересекаются
+fos_ret_t FOS_TT_Check(const fos_tt_table_t *table)
+{
+	if((table == NULL) || (table->slot == NULL))
+		return FOS__FAIL;
+
+	if((table->minor_us == 0) || (table->minor_cnt == 0))
+		return FOS__FAIL;
+
+	if((table->slot_cnt == 0) || (table->slot_cnt > FOS_TT_SLOT_CNT))
+		return FOS__FAIL;
+
+	uint32_t end_us = 0;
+
+	for(uint16_t i = 0; i < table->slot_cnt; i++)
+	{
+		const fos_tt_slot_t *s = &table->slot[i];
+
+		if((s->minor >= table->minor_cnt) || (s->len_us == 0) || (s->name == NULL))
+			return FOS__FAIL;
+
+		if((s->offset_us >= table->minor_us) || (s->len_us > table->minor_us - s->offset_us))
+			return FOS__FAIL;
+
+		// слот начинается не раньше конца предыдущего
+		uint32_t start_us = Private_FOS_TT_GetSlotStart(table, i);
+		if(start_us < end_us)
+			return FOS__FAIL;
+
+		end_us = start_us + s->len_us;
+	}
+
+	return FOS__OK;
+}
+
+
+// запустить исполнитель по таблице (идентификаторы потоков слотов задаются после запуска)
+fos_ret_t FOS_TT_Start(fos_tt_t *p, const fos_tt_table_t *table)
+{
+	if(p == NULL)
+		return FOS__FAIL;
+
+	if(FOS_TT_Check(table) != FOS__OK)
+		return FOS__FAIL;
+
+	p->table    = table;
+	p->major_us = table->minor_us * table->minor_cnt;
+	p->start_us = 0;
+	p->time_us  = 0;
+	p->frame_us = 0;
+	p->ind      = 0;
+	p->active   = FOS__DISABLE;
+	p->sync     = FOS__ENABLE;
+
+	memset(p->slot_thr, FOS_WRONG_THREAD_ID, sizeof(p->slot_thr));
+
+	return FOS__OK;
+}
+
+
+// остановить исполнитель
+void FOS_TT_Stop(fos_tt_t *p)
+{
+	if(p == NULL)
+		return;
+
+	p->table  = NULL;
+	p->active = FOS__DISABLE;
+}
+
+
+// запущен ли исполнитель
+fos_sw_t FOS_TT_IsRunning(fos_tt_t *p)
+{
+	if((p == NULL) || (p->table == NULL))
+		return FOS__DISABLE;
+
+	return FOS__ENABLE;
+}
+
+
+// установить текущее время ядра now_us (время в слотах отсчитывается от неподвижного начала кадра)
+void FOS_TT_SetTime(fos_tt_t *p, fos_time_t now_us)
+{
+	if(FOS_TT_IsRunning(p) == FOS__DISABLE)
+		return;
+
+	// первый большой кадр начинается с переключения потоков, следующего за запуском
+	if(p->sync)
+	{
+		p->sync     = FOS__DISABLE;
+		p->start_us = now_us;
+		return;
+	}
+
+	// время ядра учитывает и работу ядра, поэтому слоты не уходят от начала кадра
+	p->time_us = (uint32_t)(now_us - p->start_us);
+	Private_FOS_TT_FrameProc(p);
+}
+
+
+// получить очередное наступившее событие таблицы и слот, к которому оно относится
+fos_tt_event_t FOS_TT_GetEvent(fos_tt_t *p, uint16_t *slot)
+{
+	if((FOS_TT_IsRunning(p) == FOS__DISABLE) || (slot == NULL))
+		return FOS_TT__NONE;
+
+	const fos_tt_table_t *t = p->table;
+	uint32_t start_us = p->frame_us + Private_FOS_TT_GetSlotStart(t, p->ind);
+
+	// начало слота
+	if(p->active == FOS__DISABLE)
+	{
+		if(p->time_us < start_us)
+			return FOS_TT__NONE;
+
+		*slot = p->ind;
+		p->active = FOS__ENABLE;
+
+		return FOS_TT__SLOT_START;
+	}
+
+	// конец слота
+	if(p->time_us < start_us + t->slot[p->ind].len_us)
+		return FOS_TT__NONE;
+
+	*slot = p->ind;
+	p->active = FOS__DISABLE;
+
+	// за последним слотом следует первый слот следующего большого кадра
+	if(++p->ind >= t->slot_cnt)
+	{
+		p->ind = 0;
+		p->frame_us += p->major_us;
+		Private_FOS_TT_FrameProc(p);
+	}
+
+	return FOS_TT__SLOT_END;
+}
+
+
+// получить время до ближайшего события таблицы в мкс (FOS_INF_TIME - исполнитель остановлен)
+uint32_t FOS_TT_GetTimeToEvent(fos_tt_t *p)
+{
+	if(FOS_TT_IsRunning(p) == FOS__DISABLE)
+		return FOS_INF_TIME;
+
+	uint32_t event_us = p->frame_us + Private_FOS_TT_GetSlotStart(p->table, p->ind);
+	if(p->active)
+		event_us += p->table->slot[p->ind].len_us;
+
+	return (event_us > p->time_us) ? (event_us - p->time_us) : 0;
+}
+
+
+// получить идентификатор потока выполняющегося слота (FOS_WRONG_THREAD_ID - слот не выполняется)
+fos_id_t FOS_TT_GetActiveThread(fos_tt_t *p)
+{
+	if((FOS_TT_IsRunning(p) == FOS__DISABLE) || (p->active == FOS__DISABLE))
+		return FOS_WRONG_THREAD_ID;
+
+	return p->slot_thr[p->ind];
+}
+
+
+// есть ли поток в таблице
+fos_sw_t FOS_TT_IsSlotThread(fos_tt_t *p, fos_id_t id)
+{
+	if(FOS_TT_IsRunning(p) == FOS__DISABLE)
+		return FOS__DISABLE;
+
+	for(uint16_t i = 0; i < p->table->slot_cnt; i++)
+		if(p->slot_thr[i] == id)
+			return FOS__ENABLE;
+
+	return FOS__DISABLE;
+}
+
+
+// исключить поток из таблицы (его слоты простаивают)
+void FOS_TT_RemoveThread(fos_tt_t *p, fos_id_t id)
+{
+	if(p == NULL)
+		return;
+
+	for(uint16_t i = 0; i < FOS_TT_SLOT_CNT; i++)
+		if(p->slot_thr[i] == id)
+			p->slot_thr[i] = FOS_WRONG_THREAD_ID;
+}
+
+
+// получить начало слота от начала большого кадра, мкс
+static uint32_t Private_FOS_TT_GetSlotStart(const fos_tt_table_t *table, uint16_t ind)
+{
+	const fos_tt_slot_t *s = &table->slot[ind];
+
+	return s->minor * table->minor_us + s->offset_us;
+}
+
+
+// перейти к следующему большому кадру, если он начался
+static void Private_FOS_TT_FrameProc(fos_tt_t *p)
+{
+	// время отсчитывается от начала большого кадра, к которому уже перешли слоты
+	if(p->frame_us && (p->time_us >= p->frame_us))
+	{
+		p->start_us += p->frame_us;
+		p->time_us  -= p->frame_us;
+		p->frame_us = 0;
+		p->frame_cnt++;
+	}
+}
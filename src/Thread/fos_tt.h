@@ -0,0 +1,127 @@
+/**************************************************************************//**
+ * @file      fos_tt.h
+ * @brief     Time-triggered cyclic executive. Header file.
+ * @version   V1.0.00
+ * @date      16.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef APPLICATION_FOS_THREAD_FOS_TT_H_
+#define APPLICATION_FOS_THREAD_FOS_TT_H_
+
+
+#include "fos_types.h"
+
+
+// слот таблицы: поток с именем name выполняется len_us мкс, начиная с offset_us от начала малого кадра minor
+// поток задаётся именем, т.к. дескрипторы потоков известны только после их создания
+typedef struct
+{
+	uint16_t    minor;                   // номер малого кадра, 0..minor_cnt - 1
+	uint32_t    offset_us;               // начало слота от начала малого кадра, мкс
+	uint32_t    len_us;                  // длина слота, мкс
+	const char *name;                    // имя потока слота (поток находится при запуске исполнителя)
+
+} fos_tt_slot_t;
+
+
+// таблица циклического исполнителя: большой кадр из minor_cnt малых кадров по minor_us мкс
+typedef struct
+{
+	uint32_t minor_us;                   // длина малого кадра, мкс
+	uint16_t minor_cnt;                  // число малых кадров в большом кадре
+	uint16_t slot_cnt;                   // число слотов
+	const fos_tt_slot_t *slot;           // слоты, упорядоченные по времени начала
+
+} fos_tt_table_t;
+
+
+// объявление таблицы на этапе компиляции
+// FOS_TT_TABLE(tt_table, 10000, 4, {0, 0, 2000, "ThrA"}, {0, 2000, 1000, "ThrB"}, {2, 0, 2000, "ThrA"});
+#define FOS_TT_TABLE(name, minor_us, minor_cnt, ...)                                            \
+	static const fos_tt_slot_t name##_slot[] = { __VA_ARGS__ };                                 \
+	const fos_tt_table_t name = { (minor_us), (minor_cnt),                                      \
+	                              sizeof(name##_slot) / sizeof(fos_tt_slot_t), name##_slot }
+
+
+// событие таблицы
+typedef enum
+{
+	FOS_TT__NONE = 0,                    // нет событий
+	FOS_TT__SLOT_START,                  // начало слота
+	FOS_TT__SLOT_END,                    // конец слота
+
+} fos_tt_event_t;
+
+
+// состояние циклического исполнителя
+typedef struct
+{
+	const fos_tt_table_t *table;         // таблица (NULL - исполнитель остановлен)
+	uint32_t major_us;                   // длина большого кадра, мкс
+
+	volatile fos_time_t start_us;        // начало текущего большого кадра по времени ядра, мкс
+	volatile uint32_t time_us;           // время от начала текущего большого кадра, мкс
+	volatile uint32_t frame_us;          // начало большого кадра слота ind от начала текущего большого кадра, мкс
+	volatile uint16_t ind;               // текущий или следующий слот
+	volatile fos_sw_t active;            // слот ind выполняется
+	volatile fos_sw_t sync;              // отсчёт времени начнётся со следующего переключения потоков
+
+	fos_id_t slot_thr[FOS_TT_SLOT_CNT];  // идентификаторы потоков слотов
+
+	volatile uint32_t frame_cnt;         // число выполненных больших кадров
+	volatile uint32_t overrun_cnt;       // число превышений слота
+	volatile uint32_t miss_cnt;          // число слотов, поток которых не ждал начала слота
+
+} fos_tt_t;
+
+
+// инициализация
+void FOS_TT_Init(fos_tt_t *p);
+
+// проверить таблицу: слоты внутри своих малых кадров, упорядочены и не пересекаются
+fos_ret_t FOS_TT_Check(const fos_tt_table_t *table);
+
+// запустить исполнитель по таблице (идентификаторы потоков слотов задаются после запуска)
+fos_ret_t FOS_TT_Start(fos_tt_t *p, const fos_tt_table_t *table);
+
+// остановить исполнитель
+void FOS_TT_Stop(fos_tt_t *p);
+
+// запущен ли исполнитель
+fos_sw_t FOS_TT_IsRunning(fos_tt_t *p);
+
+// установить текущее время ядра now_us (время в слотах отсчитывается от неподвижного начала кадра)
+void FOS_TT_SetTime(fos_tt_t *p, fos_time_t now_us);
+
+// получить очередное наступившее событие таблицы и слот, к которому оно относится
+fos_tt_event_t FOS_TT_GetEvent(fos_tt_t *p, uint16_t *slot);
+
+// получить время до ближайшего события таблицы в мкс (FOS_INF_TIME - исполнитель остановлен)
+uint32_t FOS_TT_GetTimeToEvent(fos_tt_t *p);
+
+// получить идентификатор потока выполняющегося слота (FOS_WRONG_THREAD_ID - слот не выполняется)
+fos_id_t FOS_TT_GetActiveThread(fos_tt_t *p);
+
+// есть ли поток в таблице
+fos_sw_t FOS_TT_IsSlotThread(fos_tt_t *p, fos_id_t id);
+
+// исключить поток из таблицы (его слоты простаивают)
+void FOS_TT_RemoveThread(fos_tt_t *p, fos_id_t id);
+
+
+#endif /* APPLICATION_FOS_THREAD_FOS_TT_H_ */
@@ -24,12 +24,15 @@
 #define APPLICATION_FOS_FOS_CONF_H_
 
 
-#define FOS_MAX_THR_CNT        32          // maximum thread count
+#define FOS_MAX_THR_CNT        32          // maximum thread count (up to 0x7FFF: the scheduler returns thread index as int16_t)
 #define FOS_SEM_BIN_CNT        32          // maximum binary semaphore count
 #define FOS_SEM_COUNTING_CNT   32          // maximum counting semaphore count
 #define FOS_SEM_QUEUE_32_CNT   32          // maximum queue32 count
 #define FOS_FWRITER_CNT        32          // maximum writer objects count
-#define FOS_SYS_CALL_CNT       32          // maximum system call count
+#define FOS_MUTEX_CNT          32          // maximum mutex count
+#define FOS_GROUP_CNT          8           // maximum thread groups count (CPU reservations)
+#define FOS_TT_SLOT_CNT        32          // maximum slot count of time-triggered table
+#define FOS_SYS_CALL_CNT       64          // maximum system call count
 #define FOS_PRIORITY_CNT       8           // maximum priorities count(0 is the highest, 1 - lower than 0, etc.)
 #define FOS_THR_NAME_LEN       16          // thread name length
 #define FOS_MAX_STR_ERR_LEN    32          // maximum length of error descriptive string
@@ -49,6 +52,7 @@
 
 #define FOS_DEF_THR_STACK_SIZE 0x400       // default thread stack size
 #define FOS_DEF_THR_HEAP_SIZE  0x400       // default thread heap size
+#define FOS_RTC_STACK_SIZE     0           // shared stack size of run-to-completion threads of a priority (0 - the stack size of the first such thread)
 
 #define STACK_SIZE_IDDLE_THR   0x400       // iddle thread stack size
 #define STACK_SIZE_FPROC_THR   0x2000      // file proc thread stack size
@@ -60,6 +64,27 @@
 
 #define FOS_STAB_TIME_MS           200     // stabilaze time (magic time for some BlackPill boards)
 #define FOS_SWITCH_CONTEXT_TIME_US 1000    // OS switch context time, us
+#define FOS_EDF_PRIORITY           0       // priority level of periodic (EDF) threads, they run ahead of the fixed priority threads of the same level
+#define FOS_IPC_MSG_LEN            4       // message length of synchronous IPC, 32-bit words
+
+//#define FOS_USE_TICKLESS_IDLE            // stretch the main timer period while only the idle thread is ready
+#define FOS_TICKLESS_MAX_US        50000   // maximum main timer period in tickless idle mode, us
+#define FOS_TICKLESS_COALESCE_US   1000    // wake-up coalescing window in tickless idle mode: a sleeper may wake up this much late, us (0 - every wake-up is on time)
+#define FOS_MAIN_TIM_MAX_US        65535   // widest period the main timer counts (16-bit timer at 1 MHz), us
+
+//#define FOS_TIME_BASE_DWT_HZ     168000000   // core clock of DWT cycle counter time base, Hz (not defined - time base is the 1 ms tick), not with FOS_USE_TICKLESS_IDLE
+
+//#define FOS_USE_DIRECT_SWITCH            // switch threads directly in PendSV, the main loop runs for housekeeping only
+#define FOS_HOUSEKEEPING_PERIOD_MS 10      // housekeeping period in direct switch mode (stack checks, load statistics; semaphore timeouts are planned on their own), ms
+
+//#define FOS_USE_AGING                    // raise priority of ready threads that have waited too long (the idle level does not age)
+#define FOS_AGING_THRESHOLD_MS     100     // waiting time of a ready thread for each priority level it is raised by, ms
+#define FOS_AGING_TOP_PRIORITY     1       // the highest priority aging can raise a thread to
+
+#define FOS_SCHED_POLICY           fos_sched_policy_edf    // scheduling policy (fos_sched_policy_t) chosen at compile time: fos_sched_policy_edf, fos_sched_policy_prio
+
+//#define FOS_USE_SCHED_PROFILE            // measure each scheduler pick and each context switch (direct and through the main loop) in time base counter ticks (CPU cycles with FOS_TIME_BASE_DWT_HZ)
+//#define FOS_USE_SCHED_POLICY_RUNTIME     // allow to change the scheduling policy at runtime (calls through a pointer)
 
 #endif /* APPLICATION_FOS_FOS_CONF_H_ */
 
@@ -30,27 +30,67 @@
 #include <stddef.h>
 
 
-#define FOS_SUSPEND_BLOCKED_ID 250           // identifier of suspended and blocked tasks
-#define FOS_SPECIAL_ID         250           // special identifier
-#define FOS_EMPTY_ID           255           // identifier of empty (non present) task
+typedef uint16_t fos_id_t;                   // identifier (index) of a thread or a kernel object
+typedef uint64_t fos_time_t;                 // monotonic kernel time, us (never wraps)
+
+
+#define FOS_SUSPEND_BLOCKED_ID 0xFFFE        // identifier of suspended and blocked tasks
+#define FOS_SPECIAL_ID         0xFFFE        // special identifier
+#define FOS_EMPTY_ID           0xFFFF        // identifier of empty (non present) task
 #define FOS_INF_TIME           0xFFFFFFFF    // infinite time
 #define FOS_USER_LOCK_MASK     0xFFFF        // user defined mask for blocking
 #define FOS_LOCK_OBJ_FLAG      0x10000       // blocking flag for blocker object
-#define FOS_WRONG_THREAD_ID    0xFF          // identifier of a wrong thread descriptor
-#define FOS_WRONG_SEM_BIN_ID   0xFF          // identifier of a wrong binary semphore descriptor
-#define FOS_WRONG_SEM_CNT_ID   0xFF          // identifier of a wrong counting semphore descriptor
-#define FOS_WRONG_QUE_32_ID    0xFF          // identifier of a wrong queue32 descriptor
-#define FOS_WRONG_FWRITER_ID   0xFF          // identifier of a wrong writer object descriptor
+#define FOS_LOCK_IPC_FLAG      0x20000       // blocking flag for synchronous IPC
+#define FOS_LOCK_TT_FLAG       0x40000       // blocking flag for time-triggered slot
+#define FOS_LOCK_SUSPEND_FLAG  0x80000       // blocking flag for suspended thread
+#define FOS_WRONG_THREAD_ID    0xFFFF        // identifier of a wrong thread descriptor
+#define FOS_WRONG_SEM_BIN_ID   0xFFFF        // identifier of a wrong binary semphore descriptor
+#define FOS_WRONG_SEM_CNT_ID   0xFFFF        // identifier of a wrong counting semphore descriptor
+#define FOS_WRONG_QUE_32_ID    0xFFFF        // identifier of a wrong queue32 descriptor
+#define FOS_WRONG_FWRITER_ID   0xFFFF        // identifier of a wrong writer object descriptor
+#define FOS_WRONG_MUTEX_ID     0xFFFF        // identifier of a wrong mutex descriptor
+#define FOS_NO_PRIORITY        0xFF          // thread is not in any priority list of the scheduler
+#define FOS_NO_CEILING         0xFF          // ceiling priority of a mutex with priority inheritance only
+#define FOS_NO_GROUP           0             // thread does not belong to a group (groups are numbered from 1)
 #define FOS_WRONG_USER_DESC    0             // wrong user defined descriptor
 #define FOS_KERNEL_USER_DESC   0x1           // kernel mode user defined descriptor
 
 #define FOS_MIN_TIM_PERIOD_US  100           // min timer period
 #define FOS_MAX_TIM_PERIOD_US  10000         // max timer period
+#define FOS_TIME_MAX_AHEAD_US  0x40000000    // farthest wake-up the 32-bit timer queue keys hold, longer sleeps are re-armed
 
 #define FOS_KERNEL_HEAP_ID     0x1           // ID of kernel heap
 #define FOS_THREADS_HEAP_ID    0x2           // ID of threads heap
 
 
+#if (FOS_PRIORITY_CNT > 32)
+	#error FOS_PRIORITY_CNT must not exceed 32
+#endif
+
+#if (FOS_MAX_TIM_PERIOD_US > FOS_MAIN_TIM_MAX_US) || (FOS_TICKLESS_MAX_US > FOS_MAIN_TIM_MAX_US)
+	#error main timer period must not exceed FOS_MAIN_TIM_MAX_US
+#endif
+
+#if defined(FOS_TIME_BASE_DWT_HZ) && defined(FOS_USE_TICKLESS_IDLE)
+	#error DWT cycle counter stops in WFI, it cannot be the time base with FOS_USE_TICKLESS_IDLE
+#endif
+
+
+// wrap-safe comparison of 32-bit timestamps (true if a is at or after b)
+#define FOS_TIME_AFTER_EQ(a, b)  ((int32_t)((uint32_t)(a) - (uint32_t)(b)) >= 0)
+
+
+// count leading zeros (x must not be 0)
+#if defined(GCC_COMPILER)
+	#define FOS_CLZ(x)   ((uint8_t)__builtin_clz((uint32_t)(x)))
+#elif defined(IAR_COMPILER)
+	#include <intrinsics.h>
+	#define FOS_CLZ(x)   ((uint8_t)__CLZ((uint32_t)(x)))
+#else
+	#error Unknown!
+#endif
+
+
 // on-off switch
 typedef enum
 {
@@ -143,6 +183,22 @@ typedef enum
 typedef uint32_t user_desc_t;
 
 
+// user descriptor: generation (never 0) in the high half, index of the object in its table in the low half
+#define FOS_USER_DESC(gen, slot)  ((user_desc_t)(((uint32_t)(gen) << 16) | (fos_id_t)(slot)))
+#define FOS_USER_DESC_SLOT(desc)  ((fos_id_t)((desc) & 0xFFFF))
+
+
+// context switch latency from PendSV entry to the next thread stack load, time base counter ticks
+typedef struct
+{
+	uint32_t ticks_last;                 // latency of the last switch
+	uint32_t ticks_max;                  // the longest latency
+	uint64_t ticks_sum;                  // total latency (mean - ticks_sum / cnt)
+	uint32_t cnt;                        // switch count
+
+} fos_switch_prof_t;
+
+
 // major global variables
 typedef struct
 {
@@ -154,6 +210,17 @@ typedef struct
 	volatile fos_sw_t swithed_by_tim;    // context switch flag
 	volatile uint32_t thr_dt_us;         // time spent for the running process, microseconds
 	volatile uint32_t time_period_us;    // main timer period, us
+	volatile uint32_t slice_period_us;   // main timer period for the running thread, us (thread time slice or longer in tickless idle mode)
+
+	volatile uint32_t sched_lock_cnt;    // scheduler lock counter of the running thread (preemption is deferred while it is non-zero)
+	volatile fos_sw_t switch_pending;    // preemption deferred by the scheduler lock
+
+#if defined(FOS_USE_SCHED_PROFILE)
+	volatile uint32_t switch_ts;         // time base counter at PendSV entry from user mode
+	volatile fos_sw_t switch_ts_sw;      // the switch is being measured
+	fos_switch_prof_t switch_direct;     // switches done right in PendSV (FOS_USE_DIRECT_SWITCH)
+	fos_switch_prof_t switch_main_loop;  // switches done through the main loop of the kernel
+#endif
 
 } fos_mgv_t;
 
@@ -166,14 +233,37 @@ typedef struct
 	uint32_t        stack_size;       // stack size
 	fos_thr_alloc_t alloc_type;       // thread allocation type
 	user_desc_t     semb;             // thread binary semaphore
+	fos_sw_t        rtc_sw;           // run-to-completion thread (stack is shared with such threads of the same priority)
 
 } fos_thread_cset_t;
 
 
+// periodic (EDF) thread settings
+typedef struct
+{
+	uint32_t period_ms;                 // job release period, ms (0 - not a periodic thread)
+	uint32_t deadline_ms;               // relative deadline of a job, ms (0 - equal to the period)
+	uint32_t wcet_us;                   // execution time budget of a job, us (0 - unlimited)
+
+} fos_thread_rt_set_t;
+
+
+// CPU budget settings of thread
+typedef struct
+{
+	uint32_t budget_us;                 // execution time allowed in each period, us (0 - unlimited)
+	uint32_t period_ms;                 // budget replenishment period, ms
+
+} fos_thread_budget_set_t;
+
+
 // thread settings
 typedef struct
 {
-	volatile uint8_t priotity;          // thread priority (0 - the highest, 1 - lower than 0, etc.)
+	volatile uint32_t quantum_us;       // thread time slice, us (0 - main timer period)
+	fos_thread_rt_set_t rt;             // periodic (EDF) thread settings
+	fos_thread_budget_set_t budget;     // CPU budget settings
+	uint8_t group;                      // thread group with CPU reservation (FOS_NO_GROUP - none)
 
 } fos_thread_set_t;
 
@@ -182,6 +272,7 @@ typedef struct
 typedef struct
 {
 	char *name_ptr;            // pointer to the name of the thread
+	uint8_t priotity;          // thread priority (0 - the highest, 1 - lower than 0, etc.)
 	fos_thread_cset_t cset;    // constant settings
 	fos_thread_set_t  set;     // initial settings
 
@@ -200,6 +291,11 @@ typedef struct
 	uint32_t         heap_size;        // thread heap size
 	uint8_t          priotity;         // thread priority (0 - the highest, 1 - lower than 0, etc.)
 	fos_thr_alloc_t  alloc_type;       // thread allocation type
+	uint32_t         quantum_us;       // thread time slice, us (0 - main timer period)
+	fos_thread_rt_set_t rt;            // periodic (EDF) thread settings (rt.period_ms == 0 - ordinary thread)
+	fos_sw_t         rtc_sw;           // run-to-completion thread: a job runs on each start, the stack is shared by priority, no heap (not for periodic threads)
+	fos_thread_budget_set_t budget;    // CPU budget settings (budget.budget_us == 0 - unlimited)
+	uint8_t          group;            // thread group with CPU reservation, 1..FOS_GROUP_CNT (FOS_NO_GROUP - none)
 
 } fos_thread_user_init_t;
 
@@ -208,26 +304,48 @@ typedef struct
 typedef void (*svcall_t)(void*);  // system call function prototype
 
 
-// blocker object
+// message of synchronous IPC
 typedef struct
 {
-	volatile uint8_t first_lock_thr;                       // index of the element of 'lock_thr_is_list' of the first blocked thread
-	volatile uint8_t last_lock_thr;                        // index of the element of 'lock_thr_is_list' of the last blocked thread
-	volatile uint8_t lock_thr_cnt;                         // blocked threads count
-	volatile uint8_t lock_thr_is_list[FOS_MAX_THR_CNT];    // identifier list of the blocked threads
+	uint32_t data[FOS_IPC_MSG_LEN];
+
+} fos_ipc_msg_t;
+
+
+typedef struct fos_lock_s fos_lock_t;
+
+// node of the waiting queue of a blocker; a thread waits on one blocker at a time,
+// so the nodes are kept by the kernel in one table indexed by thread id
+typedef struct
+{
+	fos_id_t next;       // id of the next blocked thread (FOS_WRONG_THREAD_ID - the last one)
+	fos_id_t prev;       // id of the previous blocked thread (FOS_WRONG_THREAD_ID - the first one)
+	fos_lock_t *lock;    // blocker the thread waits on (NULL - the thread does not wait)
+	uint8_t key;         // key of the ordered queue (the lower the closer to the head)
+
+} fos_lock_node_t;
+
+// blocker object
+struct fos_lock_s
+{
+	fos_lock_node_t *node;                                 // queue nodes of the kernel the blocker is registered in (NULL - not registered)
+
+	volatile fos_id_t first_lock_thr;                      // identifier of the first blocked thread (FOS_WRONG_THREAD_ID - no blocked threads)
+	volatile fos_id_t last_lock_thr;                       // identifier of the last blocked thread
+	volatile uint16_t lock_thr_cnt;                        // blocked threads count
 
 //	volatile fos_sw_t timeout_flag;                        // timeout flag
 	volatile uint32_t timeout_cnt;                         // timeout counter
 
-} fos_lock_t;
+};
 
 
 // timeout struct
 typedef struct
 {
 	volatile fos_sw_t timeout_flag;    // timeout flag
-	volatile uint32_t timeout_ms;      // semaphore timeout in ms
-	volatile uint32_t timeout_ts_ms;   // timestamp of semaphore timeout in ms
+	volatile uint32_t timeout_us;      // semaphore timeout in us (set in ms)
+	volatile uint32_t timeout_ts_us;   // timestamp of semaphore timeout, low bits of the kernel time in us
 
 } fos_lock_timeout_t;
 
@@ -255,8 +373,21 @@ typedef struct
 } fos_semaphore_cnt_t;
 
 
+// mutex with priority inheritance
+typedef struct
+{
+	volatile fos_id_t owner;           // identifier of the owner thread (FOS_WRONG_THREAD_ID - mutex is free)
+	uint8_t     ceiling;               // ceiling priority the owner is raised to (FOS_NO_CEILING - inheritance only)
+	fos_id_t    next_held;             // identifier of the next mutex held by the same owner (FOS_WRONG_MUTEX_ID - last)
+	fos_lock_t  fos_lock;              // blocker object, the waiting threads are ordered by priority
+	user_desc_t user_desc;             // used defined mutex descriptor
+
+} fos_mutex_t;
+
+
 typedef fos_semaphore_binary_t* fos_semaphore_binary_ptr;
 typedef fos_semaphore_cnt_t*    fos_semaphore_cnt_ptr;
+typedef fos_mutex_t*            fos_mutex_ptr;
 
 
 // error description
@@ -277,6 +408,7 @@ typedef enum
 	FOS_ERROR_THREADS_HEAP,
 	FOS_ERROR_THREADS_STACK,
 	FOS_ERROR_KERNEL_STACK,
+	FOS_ERROR_TT_OVERRUN,
 
 } fos_err_enum;
 